@@ -0,0 +1,21 @@
+#version 330 core
+
+in vec2 texCoord;
+
+uniform sampler2D sceneTexture;
+uniform vec2 texelStep; // One source texel along the blur direction
+
+out vec4 FragColor; // Output color of the fragment
+
+// 9-tap Gaussian folded into 5 bilinear fetches
+const float offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main() {
+    vec4 color = texture(sceneTexture, texCoord) * weights[0];
+    for (int i = 1; i < 3; ++i) {
+        color += texture(sceneTexture, texCoord + texelStep * offsets[i]) * weights[i];
+        color += texture(sceneTexture, texCoord - texelStep * offsets[i]) * weights[i];
+    }
+    FragColor = color;
+}
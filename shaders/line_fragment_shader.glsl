@@ -1,7 +1,9 @@
 #version 330 core
 
+in vec4 color;
+
 out vec4 FragColor; // Output color of the fragment
 
 void main() {
-    FragColor = vec4(0.8, 0.3, 0.02, 1.0); // Set the fragment color (RGBA)
-}
\ No newline at end of file
+    FragColor = color;
+}
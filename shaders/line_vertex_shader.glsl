@@ -0,0 +1,15 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;   // World position
+layout(location = 1) in vec4 aColor; // Line color
+
+layout(std140) uniform Projection {
+    mat4 projection;
+};
+
+out vec4 color;
+
+void main() {
+    gl_Position = projection * vec4(aPos, 0.0, 1.0);
+    color = aColor;
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+layout(location = 0) in vec2 corner;        // Quad corner, 0..1 with y down
+layout(location = 1) in vec3 positionLife;  // xy: center, z: age over lifetime
+layout(location = 2) in float emitter;      // Index into the emitter uniforms
+
+layout(std140) uniform Projection {
+    mat4 projection; // Shared with the backend's programs
+};
+
+uniform vec4 cell[16];        // u1, v1, u2, v2 of the emitter's atlas image
+uniform vec3 sizeDisc[16];    // x: start size, y: end size, z: 1 draws a disc
+uniform vec4 startColor[16];
+uniform vec4 endColor[16];
+
+out vec2 uv;
+out vec2 local;
+out vec4 color;
+flat out float disc;
+
+void main() {
+    int index = int(emitter);
+    float life = positionLife.z;
+    float size = mix(sizeDisc[index].x, sizeDisc[index].y, life);
+    vec2 worldPos = positionLife.xy + (corner - 0.5) * size;
+    gl_Position = projection * vec4(worldPos, 0.0, 1.0);
+
+    uv = mix(cell[index].xy, cell[index].zw, corner);
+    local = corner * 2.0 - 1.0;
+    color = mix(startColor[index], endColor[index], life);
+    disc = sizeDisc[index].z;
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec2 texCoord;
+
+uniform sampler2D sceneTexture;
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    FragColor = texture(sceneTexture, texCoord);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+
+in vec2 uv;
+in vec2 local;  // -1..1 across the quad
+in vec3 color;
+flat in float disc;
+
+uniform sampler2D atlas;
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    if (disc > 0.5) {
+        // Same edge as SpriteBatch's circle texture, which has a 16 texel radius
+        float coverage = clamp((1.0 - length(local)) * 16.0, 0.0, 1.0);
+        FragColor = vec4(color, coverage);
+    } else {
+        FragColor = texture(atlas, uv);
+    }
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+layout(location = 0) in vec2 corner;     // Quad corner, 0..1 with y down
+layout(location = 1) in vec4 posDir;     // xy: center, zw: direction
+layout(location = 2) in vec2 typeFrame;  // x: projectile type, y: animation frame
+
+layout(std140) uniform Projection {
+    mat4 projection; // Shared with the backend's programs
+};
+
+uniform vec4 frameCell[4];   // xy: UV of frame 0's top-left corner, zw: UV size of a frame
+uniform vec3 spriteSize[4];  // xy: size in world units, z: 1 draws a disc instead of a texture
+uniform vec3 tint[4];
+
+out vec2 uv;
+out vec2 local;
+out vec3 color;
+flat out float disc;
+
+void main() {
+    int type = int(typeFrame.x);
+    vec2 worldPos = posDir.xy + (corner - 0.5) * spriteSize[type].xy;
+    gl_Position = projection * vec4(worldPos, 0.0, 1.0);
+
+    // Sheets face right, mirror them for projectiles travelling left
+    float u = posDir.z <= 0.0 ? 1.0 - corner.x : corner.x;
+    vec4 cell = frameCell[type];
+    uv = cell.xy + vec2((typeFrame.y + u) * cell.z, corner.y * cell.w);
+    local = corner * 2.0 - 1.0;
+    color = tint[type];
+    disc = spriteSize[type].z;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 texCoord;
+in vec4 color;
+
+uniform sampler2D spriteTexture;
+uniform bool useTexture; // False for untextured runs such as blood drops
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    FragColor = useTexture ? texture(spriteTexture, texCoord) * color : color;
+}
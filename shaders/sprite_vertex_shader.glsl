@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;      // World position
+layout(location = 1) in vec2 aTexCoord; // Atlas texture coordinate
+layout(location = 2) in vec4 aColor;    // Per-vertex tint
+
+layout(std140) uniform Projection {
+    mat4 projection; // Projection times modelview, shared by every program
+};
+
+out vec2 texCoord;
+out vec4 color;
+
+void main() {
+    gl_Position = projection * vec4(aPos, 0.0, 1.0);
+    texCoord = aTexCoord;
+    color = aColor;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 texCoord;
+
+uniform sampler2D glyphTexture;
+uniform vec4 tint; // One color for the whole draw
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    // Luminance-alpha glyphs sample as (L, L, L, A), RGBA tiles as themselves
+    FragColor = texture(glyphTexture, texCoord) * tint;
+}
@@ -0,0 +1,15 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;      // Screen position
+layout(location = 1) in vec2 aTexCoord; // Glyph atlas or tileset coordinate
+
+layout(std140) uniform Projection {
+    mat4 projection;
+};
+
+out vec2 texCoord;
+
+void main() {
+    gl_Position = projection * vec4(aPos, 0.0, 1.0);
+    texCoord = aTexCoord;
+}
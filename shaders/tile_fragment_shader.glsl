@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec3 texCoord;
+
+uniform sampler2DArray tileTexture;
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    FragColor = texture(tileTexture, texCoord);
+}
@@ -0,0 +1,34 @@
+#version 330 core
+
+in vec2 worldPos;
+
+uniform isampler2DArray tileIndices; // One slice per map layer: array layer + 1, -(animation + 1), or 0
+uniform isampler2D tileAnimations;   // Row per animation: (frame count, length), then (array layer, end) per frame
+uniform sampler2DArray tileTexture;
+uniform vec2 tileSize;
+uniform vec2 origin;                 // World position of the index texture's first tile
+uniform int mapLayer;
+uniform uint timeMs;
+
+out vec4 FragColor; // Output color of the fragment
+
+void main() {
+    vec2 tilePos = (worldPos - origin) / tileSize;
+    ivec2 tile = clamp(ivec2(floor(tilePos)), ivec2(0), textureSize(tileIndices, 0).xy - 1);
+    int index = texelFetch(tileIndices, ivec3(tile, mapLayer), 0).r;
+    if (index == 0) discard;
+
+    int layer = index - 1;
+    if (index < 0) {
+        int animation = -index - 1;
+        ivec2 header = texelFetch(tileAnimations, ivec2(0, animation), 0).rg;
+        int time = int(timeMs % uint(header.y));
+        for (int frame = 1; frame <= header.x; ++frame) {
+            ivec2 entry = texelFetch(tileAnimations, ivec2(frame, animation), 0).rg;
+            layer = entry.x;
+            if (time < entry.y) break;
+        }
+    }
+
+    FragColor = texture(tileTexture, vec3(fract(tilePos), float(layer)));
+}
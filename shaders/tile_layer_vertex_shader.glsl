@@ -0,0 +1,16 @@
+#version 330 core
+
+layout(std140) uniform Projection {
+    mat4 projection;
+};
+
+uniform vec4 area; // Left, top, right, bottom in world units
+
+out vec2 worldPos;
+
+void main() {
+    // A triangle strip over the area, generated without vertex buffers
+    vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);
+    worldPos = mix(area.xy, area.zw, corner);
+    gl_Position = projection * vec4(worldPos, 0.0, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;      // World position
+layout(location = 1) in vec2 aTexCoord; // Coordinate within the tile
+layout(location = 2) in float aLayer;   // Tile's layer in the tileset array
+
+layout(std140) uniform Projection {
+    mat4 projection;
+};
+
+out vec3 texCoord;
+
+void main() {
+    gl_Position = projection * vec4(aPos, 0.0, 1.0);
+    texCoord = vec3(aTexCoord, aLayer);
+}
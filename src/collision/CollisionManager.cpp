@@ -103,9 +103,10 @@ void CollisionManager::handleProjectileCollisions(std::vector<Projectile>& playe
                 spdlog::info("Enemy hit by player projectile! Enemy HP: {}/{}", 
                             enemy->getCurrentHealth(), enemy->getMaxHealth());
                 
-                // Spawn damage number at enemy position
+                // Spawn damage number and hit particles at enemy position
                 if (gameplayManager) {
-                    gameplayManager->spawnDamageNumber(enemy->getX(), enemy->getY() - 20, PLAYER_PROJECTILE_DAMAGE, false);
+                    gameplayManager->spawnDamageNumber(enemy->getX(), enemy->getY() - 20, PLAYER_PROJECTILE_DAMAGE, false, enemy);
+                    gameplayManager->spawnHitParticles(projectile.getX(), projectile.getY(), false);
                 }
                 
                 break; // Projectile can only hit one enemy
@@ -123,9 +124,10 @@ void CollisionManager::handleProjectileCollisions(std::vector<Projectile>& playe
             spdlog::info("Player hit by enemy projectile! Player HP: {}/{}", 
                         player->getCurrentHealth(), player->getMaxHealth());
             
-            // Spawn damage number at player position
+            // Spawn damage number and hit particles at player position
             if (gameplayManager) {
-                gameplayManager->spawnDamageNumber(player->getX(), player->getY() - 20, ENEMY_PROJECTILE_DAMAGE, true);
+                gameplayManager->spawnDamageNumber(player->getX(), player->getY() - 20, ENEMY_PROJECTILE_DAMAGE, true, player);
+                gameplayManager->spawnHitParticles(projectile.getX(), projectile.getY(), true);
             }
         }
     }
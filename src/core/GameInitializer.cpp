@@ -1,8 +1,13 @@
 #include "core/GameInitializer.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
 #include "audio/AudioManager.h"
 #include "audio/UIAudioManager.h"
 #include "ui/UI.h"
 #include "projectile/Projectile.h"
+#include "effects/BloodEffect.h"
+#include "effects/ParticleSystem.h"
+#include "render/TextureAtlas.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -96,7 +101,15 @@ bool GameInitializer::initializeGraphics(GLFWwindow*& window) {
     // Set window properties
     glfwSetWindowAttrib(window, GLFW_RESIZABLE, GLFW_FALSE);
     glfwMakeContextCurrent(window);
-    
+
+    // Everything past GL 1.1 (buffers, FBOs, shaders, queries) is resolved through glad
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        spdlog::error("Failed to load OpenGL entry points");
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return false;
+    }
+
     // Setup OpenGL state
     if (!setupOpenGL()) {
         return false;
@@ -104,7 +117,7 @@ bool GameInitializer::initializeGraphics(GLFWwindow*& window) {
     
     // Set up viewport and projection
     glfwSetWindowSize(window, windowWidth, windowHeight);
-    glViewport(0, 0, windowWidth, windowHeight);
+    GLState::viewport(0, 0, windowWidth, windowHeight);
     setupProjection();
     
     this->window = window;
@@ -114,10 +127,10 @@ bool GameInitializer::initializeGraphics(GLFWwindow*& window) {
 }
 
 bool GameInitializer::setupOpenGL() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST); 
-    glEnable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_DEPTH_TEST); 
+    GLState::enable(GL_TEXTURE_2D);
     
     // Set up input callbacks
     setupInputCallbacks();
@@ -127,11 +140,7 @@ bool GameInitializer::setupOpenGL() {
 
 bool GameInitializer::setupProjection() {
     // Set up orthographic projection for 2D rendering
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    RenderBackend::loadOrtho(0, windowWidth, windowHeight, 0);
     return true;
 }
 
@@ -172,6 +181,20 @@ bool GameInitializer::initializeUI() {
     
     // Load all projectile textures (player, eye, shroom)
     Projectile::loadAllProjectileTextures();
+
+    // Blood frames are shared by every blood effect
+    BloodEffect::loadSharedTextures(getAssetPath(""));
+
+    // Particle emitters may name atlas images of their own
+    if (!ParticleSystem::loadEmitterConfigs(getAssetPath("assets/effects/particles.json"), getAssetPath(""))) {
+        spdlog::warn("No particle emitters loaded, hits and gates will have no particles");
+    }
+
+    // Pack everything registered above into atlas pages
+    if (!TextureAtlas::shared().build()) {
+        spdlog::error("Failed to build texture atlas");
+        return false;
+    }
     
     uiInitialized = true;
     spdlog::info("UI system initialized successfully");
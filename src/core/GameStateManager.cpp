@@ -1,4 +1,5 @@
 #include "core/GameStateManager.h"
+#include "render/DebugDraw.h"
 #include <spdlog/spdlog.h>
 
 CoreGameStateManager::CoreGameStateManager() 
@@ -145,7 +146,11 @@ void CoreGameStateManager::handleMenuState(int windowWidth, int windowHeight) {
 void CoreGameStateManager::handlePlayingState(float deltaTime, int windowWidth, int windowHeight) {
     // Initialize game if not already done
     if (!gameplayManager->isGameInitialized()) {
-        gameplayManager->startNewGame();
+        if (!gameplayManager->startNewGame()) {
+            spdlog::error("Couldn't start a new game, returning to the menu");
+            currentState = GameState::MENU;
+            return;
+        }
         gameInitialized = true;
         spdlog::info("Game initialized successfully");
         
@@ -155,6 +160,8 @@ void CoreGameStateManager::handlePlayingState(float deltaTime, int windowWidth,
         }
     }
 
+    DebugDraw::handleToggleKeys(window);
+
     // Update and draw gameplay
     gameplayManager->update(deltaTime, window, windowWidth, windowHeight);
     gameplayManager->draw(windowWidth, windowHeight);
@@ -473,10 +480,7 @@ void CoreGameStateManager::handleLoadSlotInput() {
         if (selectedSaveSlot < 3 && saveManager->getSaveSlot(selectedSaveSlot).hasSave()) {
             // Load from selected slot
             SaveData saveData;
-            if (saveManager->loadGame(saveData, selectedSaveSlot)) {
-                // Load the game state using GameplayManager
-                gameplayManager->loadGame(saveData, assetPath);
-                
+            if (saveManager->loadGame(saveData, selectedSaveSlot) && gameplayManager->loadGame(saveData, assetPath)) {
                 spdlog::info("Game loaded from slot {}", selectedSaveSlot + 1);
                 // Go to playing state if loaded from main menu, otherwise back to pause
                 if (loadSlotFromMainMenu) {
@@ -486,8 +490,9 @@ void CoreGameStateManager::handleLoadSlotInput() {
                 }
             } else {
                 spdlog::error("Failed to load game from slot {}", selectedSaveSlot + 1);
-                // Go back to appropriate menu based on where we came from
-                if (loadSlotFromMainMenu) {
+                // Go back to appropriate menu based on where we came from; a
+                // level that failed to load leaves no game to pause
+                if (loadSlotFromMainMenu || !gameplayManager->isGameInitialized()) {
                     currentState = GameState::MENU;
                 } else {
                     currentState = GameState::PAUSED;
@@ -688,6 +693,15 @@ void CoreGameStateManager::loadSettings() {
     musicVolume = configManager->getFloat("music_volume", 1.0f);
     sfxVolume = configManager->getFloat("sfx_volume", 1.0f);
 
+    // World zoom as a multiplier on the native 480x270 view; 1 shows 270 units
+    // of height with the width following the window, above 1 magnifies
+    if (gameplayManager) {
+        gameplayManager->setCameraZoom(configManager->getFloat("camera_zoom", 1.0f));
+        gameplayManager->setBloomEnabled(configManager->getBool("bloom", true));
+        gameplayManager->setPixelScalingEnabled(configManager->getBool("pixel_scaling", true));
+        gameplayManager->setLightingEnabled(configManager->getBool("lighting", true));
+    }
+
     // Apply loaded settings to audio manager
     if (audioManager) {
         audioManager->setMasterVolume(masterVolume);
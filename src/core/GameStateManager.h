@@ -1,4 +1,5 @@
 #pragma once
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "core/GameplayManager.h"
 #include "save/EnhancedSaveManager.h"
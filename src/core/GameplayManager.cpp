@@ -1,12 +1,33 @@
 #include "GameplayManager.h"
-#include <stb_image.h>
+#include "render/DebugDraw.h"
+#include "render/GLState.h"
+#include "render/GpuProfiler.h"
+#include "render/RenderBackend.h"
+#include "render/TextureCache.h"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cmath>
+
+namespace {
+    // How far past the view overlays (health bars, damage numbers) may reach
+    constexpr float OVERLAY_CULL_MARGIN = 32.0f;
+    // Enemies this far outside the view can still have ranges reaching into it
+    constexpr float AI_DEBUG_CULL_MARGIN = 256.0f;
+    // World units visible at zoom 1, whatever the map's size. The height is
+    // fixed and the width follows the window's aspect ratio.
+    constexpr float NATIVE_VIEW_WIDTH = 480.0f;
+    constexpr float NATIVE_VIEW_HEIGHT = 270.0f;
+    // Light radii in tiles
+    constexpr float PLAYER_LIGHT_RADIUS = 7.0f;
+    constexpr float GATE_LIGHT_RADIUS = 5.0f;
+}
 
 GameplayManager::GameplayManager() 
     : player(nullptr)
     , inputHandler(nullptr)
     , tilemap(nullptr)
+    , pausedFrameValid(false)
+    , pausedFrameSupported(true)
     , audioManager(nullptr)
     , uiAudioManager(nullptr)
     , saveManager(nullptr)
@@ -15,6 +36,14 @@ GameplayManager::GameplayManager()
     , nextLevelPath("")
     , levelTransitionCooldown(0.0f)
     , assetPath("")
+    , hitSparkEmitter(-1)
+    , bloodSprayEmitter(-1)
+    , bloodBurstEmitter(-1)
+    , playerHitEmitter(-1)
+    , gateSparkEmitter(-1)
+    , gateSparks(-1)
+    , gateLight(-1)
+    , playerLight(-1)
 {
 }
 
@@ -30,6 +59,13 @@ bool GameplayManager::initialize(const std::string& assetPath, AudioManager* aud
     // Set default level paths
     currentLevelPath = assetPath + "assets/maps/test.json";
     nextLevelPath = assetPath + "assets/maps/final.json";
+
+    hitSparkEmitter = ParticleSystem::findEmitter("hit_spark");
+    bloodSprayEmitter = ParticleSystem::findEmitter("blood_spray");
+    bloodBurstEmitter = ParticleSystem::findEmitter("blood_burst");
+    playerHitEmitter = ParticleSystem::findEmitter("player_hit");
+    gateSparkEmitter = ParticleSystem::findEmitter("gate_spark");
+    camera.setViewSize(NATIVE_VIEW_WIDTH, NATIVE_VIEW_HEIGHT);
     
     spdlog::info("GameplayManager initialized with asset path: {}", assetPath);
     return true;
@@ -68,6 +104,7 @@ void GameplayManager::cleanup() {
         }
     }
     bloodEffects.clear();
+    bloodDecals.clear();
     
     for (auto& gateEffect : gateEffects) {
         if (gateEffect) {
@@ -76,25 +113,30 @@ void GameplayManager::cleanup() {
     }
     gateEffects.clear();
     
-    for (auto& damageNumber : damageNumbers) {
-        if (damageNumber) {
-            delete damageNumber;
-        }
-    }
     damageNumbers.clear();
+    particles.clear();
+    gateSparks = -1;
+    lightmap.clearLights();
+    gateLight = -1;
+    playerLight = -1;
     
     playerProjectiles.clear();
     enemyProjectiles.clear();
     
+    pausedFrame.release();
+    pausedFrameValid = false;
     gameInitialized = false;
     spdlog::info("GameplayManager cleaned up");
 }
 
-void GameplayManager::startNewGame() {
+bool GameplayManager::startNewGame() {
     spdlog::info("Starting new game");
     resetGame();
     initializeGameObjects();
-    loadLevel(currentLevelPath);
+    if (!loadLevel(currentLevelPath)) {
+        cleanup();
+        return false;
+    }
     
     // Create temporary player in database
     if (saveManager && saveManager->isDatabaseEnabled()) {
@@ -108,9 +150,10 @@ void GameplayManager::startNewGame() {
     
     gameInitialized = true;
     spdlog::info("New game started successfully");
+    return true;
 }
 
-void GameplayManager::loadGame(SaveData& saveData, const std::string& assetPath) {
+bool GameplayManager::loadGame(SaveData& saveData, const std::string& assetPath) {
     spdlog::info("Loading game state");
     
     // Initialize game objects first if not already done
@@ -129,24 +172,29 @@ void GameplayManager::loadGame(SaveData& saveData, const std::string& assetPath)
         delete tilemap;
     }
     tilemap = new Tilemap();
-    if (!tilemap->loadTilesetTexture(assetPath + "assets/graphic/tileset/tileset.png", 16, 16)) {
-        spdlog::error("Failed to load tileset texture");
-        return;
-    }
     if (!tilemap->loadFromJSON(currentLevelPath)) {
         spdlog::error("Failed to load tilemap for saved level: {}", currentLevelPath);
         // Fallback to default level
-        tilemap->loadFromJSON(assetPath + "assets/levels/level1.json");
         currentLevelPath = assetPath + "assets/levels/level1.json";
+        if (!tilemap->loadFromJSON(currentLevelPath)) {
+            spdlog::error("Failed to load the default level either");
+            cleanup();
+            return false;
+        }
     }
     
+    // The previous map's tilesets and entities have been replaced by now
+    TextureCache::shared().purgeUnused();
     setupProjection();
     spdlog::info("Game loaded successfully");
+    return true;
 }
 
 void GameplayManager::resetGame() {
     cleanup();
     gameInitialized = false;
+    // Nothing from the finished run holds its textures anymore
+    TextureCache::shared().purgeUnused();
 }
 
 void GameplayManager::update(float deltaTime, GLFWwindow* window, int windowWidth, int windowHeight) {
@@ -154,6 +202,9 @@ void GameplayManager::update(float deltaTime, GLFWwindow* window, int windowWidt
     
     updateGameLogic(deltaTime, window);
     updateEntities(deltaTime);
+    tilemap->update(deltaTime);
+    fitViewToWindow(windowWidth, windowHeight);
+    camera.follow(player->getX(), player->getY(), deltaTime);
     handleCollisions();
     createBloodEffects();
     cleanupInactiveObjects();
@@ -162,26 +213,83 @@ void GameplayManager::update(float deltaTime, GLFWwindow* window, int windowWidt
 void GameplayManager::draw(int windowWidth, int windowHeight) {
     if (!gameInitialized) return;
     
-    drawGameWorld();
-    drawEntities();
-    drawProjectiles();
-    drawBloodEffects();
-    drawGateEffects();
-    drawDamageNumbers();
+    pausedFrameValid = false;
+    drawScene();
+    GpuPassScope pass("ui");
     drawUI(windowWidth, windowHeight);
 }
 
 void GameplayManager::drawPaused(int windowWidth, int windowHeight) {
     if (!gameInitialized) return;
     
-    // Draw the game in the background (paused state) - NO UPDATES, just drawing
+    // Nothing moves while a menu is open, so the world and HUD are drawn
+    // once into a texture and every menu frame only copies it back
+    GLint viewport[4];
+    GLState::getViewport(viewport);
+    bool sizeChanged = pausedFrame.getWidth() != viewport[2] || pausedFrame.getHeight() != viewport[3];
+    if (!pausedFrameSupported || ((!pausedFrameValid || sizeChanged) && !capturePausedFrame(viewport[2], viewport[3], windowWidth, windowHeight))) {
+        drawScene();
+        drawUI(windowWidth, windowHeight);
+        return;
+    }
+
+    GLState::disable(GL_BLEND);
+    RenderBackend::current().drawFullscreenTexture(pausedFrame.getTexture());
+    GLState::enable(GL_BLEND);
+}
+
+bool GameplayManager::capturePausedFrame(int width, int height, int windowWidth, int windowHeight) {
+    pausedFrameValid = false;
+    if (width <= 0 || height <= 0) return false;
+
+    if (pausedFrame.getWidth() != width || pausedFrame.getHeight() != height) {
+        if (!pausedFrame.create(width, height, GL_NEAREST)) {
+            spdlog::warn("Failed to create the paused frame target, redrawing the world behind menus");
+            pausedFrameSupported = false;
+            return false;
+        }
+    }
+
+    pausedFrame.bind();
+    pausedFrame.clear(0.0f, 0.0f, 0.0f, 1.0f);
+    drawScene();
+    drawUI(windowWidth, windowHeight);
+    pausedFrame.unbind();
+
+    pausedFrameValid = true;
+    return true;
+}
+
+void GameplayManager::drawScene() {
+    // The world is drawn one texel per world unit and scaled up by a whole
+    // factor, so it only fills as many pixels as the art has
+    ViewRect view = camera.getViewRect();
+    int nativeWidth = static_cast<int>(std::lround(view.right - view.left));
+    int nativeHeight = static_cast<int>(std::lround(view.bottom - view.top));
+    bool lowResolution = pixelScaler.begin(nativeWidth, nativeHeight);
+
+    GpuProfiler& profiler = GpuProfiler::shared();
+    profiler.beginPass("world");
     drawGameWorld();
-    drawEntities();
-    drawProjectiles();
-    drawBloodEffects();
-    drawGateEffects();
+    drawSprites();
+    profiler.beginPass("lighting");
+    drawLighting();
+
+    if (lowResolution) {
+        pixelScaler.end();
+        profiler.beginPass("pixel_scale");
+        pixelScaler.present();
+        // Outlines and damage numbers stay sharp at window resolution
+        pixelScaler.beginOverlay();
+    }
+    profiler.beginPass("overlays");
+    drawEntityOverlays();
+    drawDebugOverlays();
     drawDamageNumbers();
-    drawUI(windowWidth, windowHeight);
+    if (lowResolution) {
+        pixelScaler.endOverlay();
+    }
+    profiler.endPass();
 }
 
 SaveData GameplayManager::createSaveData() const {
@@ -217,11 +325,9 @@ void GameplayManager::initializeGameObjects() {
     
     spdlog::info("Creating player...");
     player = new Player();
-    stbi_set_flip_vertically_on_load(true);
     spdlog::info("Loading player textures...");
     player->loadTexture(assetPath + "assets/graphic/enemies/vampire/Vampire_Walk.png", 64, 64, 4);
     player->loadIdleTexture(assetPath + "assets/graphic/enemies/vampire/Vampire_Idle.png", 64, 64, 2);
-    stbi_set_flip_vertically_on_load(false);
     
     // Create enemies
     createDefaultEnemies();
@@ -229,11 +335,6 @@ void GameplayManager::initializeGameObjects() {
     spdlog::info("Creating input handler and tilemap...");
     inputHandler = new InputHandler();
     tilemap = new Tilemap();
-    spdlog::info("Loading tileset texture...");
-    if (!tilemap->loadTilesetTexture(assetPath + "assets/graphic/tileset/tileset.png", 16, 16)) {
-        spdlog::error("Failed to load tileset texture");
-        return;
-    }
     
     // Load projectile texture
     spdlog::info("Loading projectile textures...");
@@ -247,35 +348,38 @@ void GameplayManager::createDefaultEnemies() {
     
     // Flying eye enemy
     Enemy* flyingEye = new Enemy(25 * 16.0f, 10 * 16.0f, EnemyType::FlyingEye);
-    stbi_set_flip_vertically_on_load(true);
     spdlog::info("Loading flying eye textures...");
     flyingEye->loadTexture(assetPath + "assets/graphic/enemies/flying_eye/flgyingeye.png", 150, 150, 8);
     flyingEye->loadHitTexture(assetPath + "assets/graphic/enemies/flying_eye/Hit_eye.png", 150, 150, 4);
     flyingEye->loadDeathTexture(assetPath + "assets/graphic/enemies/flying_eye/Death_eye.png", 150, 150, 4);
-    stbi_set_flip_vertically_on_load(false);
     enemies.push_back(flyingEye);
     
     // Shroom enemy
     Enemy* shroom = new Enemy(15 * 16.0f, 12 * 16.0f, EnemyType::Shroom);
-    stbi_set_flip_vertically_on_load(true);
     spdlog::info("Loading shroom textures...");
     shroom->loadTexture(assetPath + "assets/graphic/enemies/shroom/shroom.png", 150, 150, 8);
     shroom->loadHitTexture(assetPath + "assets/graphic/enemies/shroom/Hit_shroom.png", 150, 150, 4);
     shroom->loadDeathTexture(assetPath + "assets/graphic/enemies/shroom/Death_shroom.png", 150, 150, 4);
-    stbi_set_flip_vertically_on_load(false);
     enemies.push_back(shroom);
     
     spdlog::info("Default enemies created");
 }
 
+void GameplayManager::fitViewToWindow(int windowWidth, int windowHeight) {
+    if (windowWidth <= 0 || windowHeight <= 0) return;
+    float aspect = static_cast<float>(windowWidth) / windowHeight;
+    camera.setViewSize(std::round(NATIVE_VIEW_HEIGHT * aspect), NATIVE_VIEW_HEIGHT);
+}
+
 void GameplayManager::setupProjection() {
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    float mapWidth = tilemap->getWidthInTiles() * tilemap->getTileWidth();
-    float mapHeight = tilemap->getHeightInTiles() * tilemap->getTileHeight();
-    glOrtho(0.0, mapWidth, mapHeight, 0.0, -1.0, 1.0);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    // The view keeps its size; small rooms are centered by the bounds clamp
+    ViewRect bounds = tilemap->getBounds();
+    camera.setBounds(bounds);
+    bloodDecals.setWorldSize(bounds.right - bounds.left, bounds.bottom - bounds.top);
+    if (player) {
+        camera.centerOn(player->getX(), player->getY());
+    }
+    camera.apply();
 }
 
 void GameplayManager::handleLevelTransition() {
@@ -286,7 +390,7 @@ void GameplayManager::handleLevelTransition() {
     int playerTileX = static_cast<int>(player->getX() / tileW);
     int playerTileY = static_cast<int>(player->getY() / tileH);
     int gid = tilemap->getNormalizedTileIdAt(playerTileX, playerTileY);
-    bool onGate = (gid == 120 || gid == 121 || gid == 122 || gid == 123);
+    bool onGate = tilemap->isGateTile(playerTileX, playerTileY);
     bool anyEnemyAlive = std::any_of(enemies.begin(), enemies.end(), [](Enemy* e){ return e && e->isAlive(); });
     
     // Create gate effects when all enemies are killed (but before gate transition)
@@ -307,6 +411,7 @@ void GameplayManager::handleLevelTransition() {
             }
         }
         gateEffects.clear();
+        stopGateSparks();
     }
     
     if (onGate && !anyEnemyAlive) {
@@ -328,12 +433,16 @@ void GameplayManager::handleLevelTransition() {
             delete bloodEffect;
         }
         bloodEffects.clear();
+        bloodDecals.clear();
+        // Numbers merge by enemy address, which the respawned enemies may reuse
+        damageNumbers.clear();
         
         // Clear gate effects
         for (auto& gateEffect : gateEffects) {
             delete gateEffect;
         }
         gateEffects.clear();
+        stopGateSparks();
         
         // Reset gate effects flag
         gateEffectsCreated = false;
@@ -343,6 +452,7 @@ void GameplayManager::handleLevelTransition() {
         
         // Teleport player to map center
         teleportPlayerToCenter();
+        camera.centerOn(player->getX(), player->getY());
         
         // Regenerate player's HP to full on gate entry
         int healAmount = player->getMaxHealth() - player->getCurrentHealth();
@@ -403,11 +513,9 @@ void GameplayManager::updateEntities(float deltaTime) {
     }
     
     // Update damage numbers
-    for (auto& damageNumber : damageNumbers) {
-        if (damageNumber) {
-            damageNumber->update(deltaTime);
-        }
-    }
+    damageNumbers.update(deltaTime);
+
+    particles.update(deltaTime);
     
     // Update animated health bar
     UI::updateAnimatedHealthBar(deltaTime);
@@ -430,7 +538,8 @@ void GameplayManager::handleCollisions() {
 void GameplayManager::createBloodEffects() {
     for (auto& enemy : enemies) {
         if (enemy && enemy->shouldCreateBloodEffect()) {
-            bloodEffects.push_back(new BloodEffect(enemy->getX(), enemy->getY() + 12, assetPath)); // Move blood 12px down
+            bloodEffects.push_back(new BloodEffect(enemy->getX(), enemy->getY() + 12)); // Move blood 12px down
+            particles.burst(bloodBurstEmitter, enemy->getX(), enemy->getY());
             enemy->markBloodEffectCreated();
             spdlog::info("Blood effect created at enemy death position ({}, {})", enemy->getX(), enemy->getY());
         }
@@ -463,21 +572,30 @@ void GameplayManager::cleanupInactiveObjects() {
         enemyProjectiles.end()
     );
     
-    // Clean up finished damage numbers
-    damageNumbers.erase(
-        std::remove_if(damageNumbers.begin(), damageNumbers.end(), [](DamageNumber* dmg) {
-            if (dmg->isFinished()) {
-                delete dmg;
+    // Finished blood is baked into the decal layer and no longer drawn on its own
+    bloodEffects.erase(
+        std::remove_if(bloodEffects.begin(), bloodEffects.end(), [this](BloodEffect* blood) {
+            if (blood->isFinished()) {
+                bloodDecals.add(*blood);
+                delete blood;
                 return true;
             }
             return false;
         }),
-        damageNumbers.end()
+        bloodEffects.end()
     );
 }
 
 void GameplayManager::drawGameWorld() {
-    tilemap->draw();
+    bloodDecals.commit();
+    camera.apply();
+    tilemap->draw(camera.getViewRect());
+    bloodDecals.draw(camera.getViewRect());
+}
+
+bool GameplayManager::isInView(float left, float top, float right, float bottom) const {
+    // Overlays and damage numbers extend a little past what they're attached to
+    return camera.getViewRect().expanded(OVERLAY_CULL_MARGIN).intersects(left, top, right, bottom);
 }
 
 void GameplayManager::drawUI(int windowWidth, int windowHeight) {
@@ -486,46 +604,192 @@ void GameplayManager::drawUI(int windowWidth, int windowHeight) {
         UI::drawAnimatedXPBarWithState(player->getXPState(), windowWidth, windowHeight);
         UI::drawLevelIndicator(player->getLevel(), windowWidth, windowHeight);
     }
+    drawMinimap(windowWidth, windowHeight);
+}
+
+void GameplayManager::drawSprites() {
+    // Entities, projectiles and effects are collected into one batch, which
+    // orders them by layer and depth and draws them grouped by texture
+    GpuProfiler& profiler = GpuProfiler::shared();
+    ViewRect view = camera.getViewRect();
+    spriteBatch.begin(view);
+    emissiveBatch.begin(view);
+    drawEntities();
+    if (projectileRenderer.isAvailable()) {
+        // Projectiles are drawn instanced between the entity and effect
+        // layers, so the batch is flushed on either side of them
+        profiler.beginPass("entities");
+        spriteBatch.flush();
+        profiler.beginPass("projectiles");
+        drawProjectilesInstanced(view);
+        spriteBatch.begin(view);
+    } else {
+        drawProjectiles();
+    }
+    drawBloodEffects();
+    drawGateEffects();
+    bool instancedParticles = particleRenderer.isAvailable();
+    if (!instancedParticles) {
+        particles.draw(spriteBatch);
+    }
+    // Without instancing everything goes out in this one flush
+    profiler.beginPass(projectileRenderer.isAvailable() ? "effects" : "sprites");
+    spriteBatch.flush();
+    if (instancedParticles) {
+        profiler.beginPass("particles");
+        drawParticles(view);
+    }
+    profiler.beginPass("bloom");
+    drawBloom();
+}
+
+void GameplayManager::drawBloom() {
+    // Nothing glowing on screen costs nothing
+    if (emissiveBatch.isEmpty() || !postProcess.beginEmissive()) {
+        emissiveBatch.begin();  // Drop what was collected
+        return;
+    }
+    emissiveBatch.flush();
+    postProcess.endEmissive();
+    postProcess.applyBloom();
+}
+
+void GameplayManager::drawLighting() {
+    if (!lightmap.isEnabled()) return;
+    if (player) {
+        if (playerLight < 0) {
+            playerLight = lightmap.addLight(player->getX(), player->getY(), PLAYER_LIGHT_RADIUS, 1.0f, 0.85f, 0.6f);
+        }
+        lightmap.moveLight(playerLight, player->getX(), player->getY());
+        lightmap.setViewer(player->getX(), player->getY());
+    }
+    lightmap.update(*tilemap);
+    lightmap.draw();
 }
 
 void GameplayManager::drawEntities() {
     if (player) {
-        player->draw();
+        player->draw(spriteBatch);
     }
     
     for (auto& enemy : enemies) {
         if (enemy) {
-            enemy->draw();
+            enemy->draw(spriteBatch, &emissiveBatch);
+        }
+    }
+}
+
+void GameplayManager::drawEntityOverlays() {
+    if (player && isInView(player->getLeft(), player->getTop(), player->getRight(), player->getBottom())) {
+        player->drawBoundingBox();
+    }
+
+    for (auto& enemy : enemies) {
+        if (enemy && isInView(enemy->getLeft(), enemy->getTop(), enemy->getRight(), enemy->getBottom())) {
+            enemy->drawOverlay();
+        }
+    }
+}
+
+void GameplayManager::drawDebugOverlays() {
+    ViewRect view = camera.getViewRect();
+
+    if (tilemap && DebugDraw::isEnabled(DebugCategory::CollisionTiles)) {
+        int tileWidth = tilemap->getTileWidth();
+        int tileHeight = tilemap->getTileHeight();
+        if (tileWidth > 0 && tileHeight > 0) {
+            int firstX = std::max(0, static_cast<int>(std::floor(view.left / tileWidth)));
+            int firstY = std::max(0, static_cast<int>(std::floor(view.top / tileHeight)));
+            int lastX = std::min(tilemap->getWidthInTiles() - 1, static_cast<int>(std::floor(view.right / tileWidth)));
+            int lastY = std::min(tilemap->getHeightInTiles() - 1, static_cast<int>(std::floor(view.bottom / tileHeight)));
+            for (int y = firstY; y <= lastY; ++y) {
+                for (int x = firstX; x <= lastX; ++x) {
+                    if (!tilemap->isTileSolid(x, y)) continue;
+                    float left = static_cast<float>(x * tileWidth);
+                    float top = static_cast<float>(y * tileHeight);
+                    DebugDraw::rect(DebugCategory::CollisionTiles, left, top, left + tileWidth, top + tileHeight,
+                                    255, 255, 0, 160);
+                }
+            }
+        }
+    }
+
+    if (tilemap && DebugDraw::isEnabled(DebugCategory::SpatialGrid)) {
+        ViewRect bounds = tilemap->getBounds();
+        float chunkWidth = static_cast<float>(Tilemap::CHUNK_SIZE * tilemap->getTileWidth());
+        float chunkHeight = static_cast<float>(Tilemap::CHUNK_SIZE * tilemap->getTileHeight());
+        if (chunkWidth > 0.0f && chunkHeight > 0.0f) {
+            for (float x = bounds.left; x <= bounds.right; x += chunkWidth) {
+                DebugDraw::line(DebugCategory::SpatialGrid, x, bounds.top, x, bounds.bottom, 0, 255, 255, 128);
+            }
+            for (float y = bounds.top; y <= bounds.bottom; y += chunkHeight) {
+                DebugDraw::line(DebugCategory::SpatialGrid, bounds.left, y, bounds.right, y, 0, 255, 255, 128);
+            }
+        }
+    }
+
+    if (player && DebugDraw::isEnabled(DebugCategory::AITargets)) {
+        ViewRect reach = view.expanded(AI_DEBUG_CULL_MARGIN);
+        for (const Enemy* enemy : enemies) {
+            if (!enemy || !enemy->isAlive()) continue;
+            if (!reach.intersects(enemy->getLeft(), enemy->getTop(), enemy->getRight(), enemy->getBottom())) continue;
+
+            DebugDraw::circle(DebugCategory::AITargets, enemy->getX(), enemy->getY(), enemy->getChaseRadius(),
+                              255, 160, 0, 96);
+            DebugDraw::circle(DebugCategory::AITargets, enemy->getX(), enemy->getY(), enemy->getShootRange(),
+                              255, 60, 60, 64);
+            if (enemy->getState() == EnemyState::Chasing) {
+                DebugDraw::line(DebugCategory::AITargets, enemy->getX(), enemy->getY(), player->getX(), player->getY(),
+                                255, 160, 0, 255);
+            }
         }
     }
+
+    DebugDraw::flush();
 }
 
 void GameplayManager::drawProjectiles() {
     for (auto& projectile : playerProjectiles) {
-        projectile.draw();
+        projectile.draw(spriteBatch);
     }
     
     for (auto& projectile : enemyProjectiles) {
-        projectile.draw();
+        projectile.draw(spriteBatch);
+    }
+}
+
+void GameplayManager::drawProjectilesInstanced(const ViewRect& view) {
+    projectileRenderer.begin(view);
+    for (const auto& projectile : playerProjectiles) {
+        projectileRenderer.add(projectile);
+    }
+    for (const auto& projectile : enemyProjectiles) {
+        projectileRenderer.add(projectile);
     }
+    projectileRenderer.flush();
+}
+
+void GameplayManager::drawParticles(const ViewRect& view) {
+    particleRenderer.draw(particles, view);
 }
 
 void GameplayManager::drawBloodEffects() {
     for (auto& bloodEffect : bloodEffects) {
         if (bloodEffect) {
-            bloodEffect->draw();
+            bloodEffect->draw(spriteBatch);
         }
     }
 }
 
-void GameplayManager::loadLevel(const std::string& levelPath) {
+bool GameplayManager::loadLevel(const std::string& levelPath) {
     spdlog::info("Loading map from JSON: {}", levelPath);
     if (!tilemap->loadFromJSON(levelPath)) {
         spdlog::error("Failed to load map from JSON.");
-        return;
+        return false;
     }
     setupProjection();
     spdlog::info("Level loaded successfully");
+    return true;
 }
 
 void GameplayManager::respawnEnemies() {
@@ -585,8 +849,8 @@ void GameplayManager::createGateEffects() {
     int gateCount = 0;
     
     for (int x = 0; x < tilemap->getWidthInTiles(); ++x) {
-        int gid = tilemap->getNormalizedTileIdAt(x, targetGateRow);
-        if (gid == 120 || gid == 121 || gid == 122 || gid == 123) {
+        if (tilemap->isGateTile(x, targetGateRow)) {
+            int gid = tilemap->getNormalizedTileIdAt(x, targetGateRow);
             gateCenterX += x * tileW + tileW / 2.0f;
             gateCount++;
             spdlog::info("Found gate tile GID {} at ({}, {})", gid, x, targetGateRow);
@@ -599,6 +863,9 @@ void GameplayManager::createGateEffects() {
         // Create ONE gate effect at the center of all gate tiles
         GateEffect* gateEffect = new GateEffect(gateCenterX, gateCenterY, assetPath);
         gateEffects.push_back(gateEffect);
+        stopGateSparks();
+        gateSparks = particles.startEmitter(gateSparkEmitter, gateCenterX, gateCenterY);
+        gateLight = lightmap.addLight(gateCenterX, gateCenterY, GATE_LIGHT_RADIUS, 0.35f, 0.75f, 1.0f);
         
         spdlog::info("Created single gate effect at world position ({}, {}) covering {} gate tiles", 
                      gateCenterX, gateCenterY, gateCount);
@@ -612,20 +879,54 @@ void GameplayManager::createGateEffects() {
 void GameplayManager::drawGateEffects() {
     for (auto& gateEffect : gateEffects) {
         if (gateEffect && gateEffect->isActive()) {
-            gateEffect->draw();
+            gateEffect->draw(spriteBatch);
         }
     }
 }
 
 void GameplayManager::drawDamageNumbers() {
-    for (auto& damageNumber : damageNumbers) {
-        if (damageNumber && damageNumber->isActive()) {
-            damageNumber->draw();
+    // Every digit of every number goes out in one textured draw
+    if (damageNumbers.getActiveCount() == 0) return;
+    spriteBatch.begin(camera.getViewRect());
+    damageNumbers.draw(spriteBatch);
+    spriteBatch.flush();
+}
+
+void GameplayManager::drawMinimap(int windowWidth, int windowHeight) {
+    if (!tilemap) return;
+    minimap.update(*tilemap);
+    minimap.clearMarkers();
+    for (const Enemy* enemy : enemies) {
+        if (enemy && enemy->isAlive() && lightmap.isVisible(enemy->getX(), enemy->getY())) {
+            minimap.addMarker(enemy->getX(), enemy->getY(), 1.0f, 0.25f, 0.2f);
         }
     }
+    if (player) {
+        minimap.addMarker(player->getX(), player->getY(), 0.3f, 1.0f, 0.4f);
+    }
+    minimap.draw(spriteBatch, windowWidth, windowHeight);
+}
+
+void GameplayManager::spawnHitParticles(float x, float y, bool isPlayerDamage) {
+    if (isPlayerDamage) {
+        particles.burst(playerHitEmitter, x, y);
+    } else {
+        particles.burst(hitSparkEmitter, x, y);
+        particles.burst(bloodSprayEmitter, x, y);
+    }
+}
+
+void GameplayManager::stopGateSparks() {
+    if (gateSparks >= 0) {
+        particles.stopEmitter(gateSparks);
+        gateSparks = -1;
+    }
+    // The gate's light goes out with its sparks
+    lightmap.removeLight(gateLight);
+    gateLight = -1;
 }
 
-void GameplayManager::spawnDamageNumber(float x, float y, int damage, bool isPlayerDamage) {
-    damageNumbers.push_back(new DamageNumber(x, y, damage, isPlayerDamage));
+void GameplayManager::spawnDamageNumber(float x, float y, int damage, bool isPlayerDamage, const void* target) {
+    damageNumbers.spawn(x, y, damage, isPlayerDamage, target);
     spdlog::debug("Spawned damage number at ({}, {}) with damage: {}", x, y, damage);
 }
@@ -1,19 +1,30 @@
 #pragma once
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <string>
 #include "player/Player.h"
 #include "enemy/Enemy.h"
 #include "projectile/Projectile.h"
+#include "projectile/ProjectileRenderer.h"
 #include "effects/BloodEffect.h"
+#include "effects/BloodDecalLayer.h"
 #include "effects/GateEffect.h"
 #include "effects/DamageNumber.h"
+#include "effects/ParticleSystem.h"
+#include "effects/ParticleRenderer.h"
+#include "effects/Lightmap.h"
 #include "input/InputHandler.h"
 #include "map/Tilemap.h"
 #include "collision/CollisionManager.h"
 #include "audio/AudioManager.h"
 #include "audio/UIAudioManager.h"
 #include "ui/UI.h"
+#include "ui/Minimap.h"
+#include "render/SpriteBatch.h"
+#include "render/Camera.h"
+#include "render/PixelScaler.h"
+#include "render/PostProcess.h"
 #include "save/SaveManager.h"
 #include "save/GameStateManager.h"
 #include "save/EnhancedSaveManager.h"
@@ -29,8 +40,9 @@ public:
     void cleanup();
 
     // Game state management
-    void startNewGame();
-    void loadGame(SaveData& saveData, const std::string& assetPath);
+    // Both return false, leaving the game uninitialized, when the level can't be loaded
+    bool startNewGame();
+    bool loadGame(SaveData& saveData, const std::string& assetPath);
     void resetGame();
 
     // Game loop methods
@@ -47,12 +59,19 @@ public:
     const std::vector<Projectile>& getEnemyProjectiles() const { return enemyProjectiles; }
     const std::vector<BloodEffect*>& getBloodEffects() const { return bloodEffects; }
     const std::vector<GateEffect*>& getGateEffects() const { return gateEffects; }
-    const std::vector<DamageNumber*>& getDamageNumbers() const { return damageNumbers; }
+    const DamageNumberPool& getDamageNumbers() const { return damageNumbers; }
     
-    // Spawn damage number
-    void spawnDamageNumber(float x, float y, int damage, bool isPlayerDamage);
+    // Spawn damage number. Quick hits on the same target add up into one number.
+    void spawnDamageNumber(float x, float y, int damage, bool isPlayerDamage, const void* target = nullptr);
+    // Sparks, plus a blood spray when an enemy was hit
+    void spawnHitParticles(float x, float y, bool isPlayerDamage);
     Tilemap* getTilemap() const { return tilemap; }
     const std::string& getCurrentLevelPath() const { return currentLevelPath; }
+    void setCameraZoom(float zoom) { camera.setZoom(zoom); pausedFrameValid = false; }
+    const Camera& getCamera() const { return camera; }
+    void setBloomEnabled(bool enabled) { postProcess.setBloomEnabled(enabled); pausedFrameValid = false; }
+    void setPixelScalingEnabled(bool enabled) { pixelScaler.setEnabled(enabled); pausedFrameValid = false; }
+    void setLightingEnabled(bool enabled) { lightmap.setEnabled(enabled); pausedFrameValid = false; }
     float getLevelTransitionCooldown() const { return levelTransitionCooldown; }
 
     // Save/Load operations
@@ -66,12 +85,26 @@ private:
     std::vector<Enemy*> enemies;
     std::vector<Projectile> playerProjectiles;
     std::vector<Projectile> enemyProjectiles;
-    std::vector<BloodEffect*> bloodEffects;
+    std::vector<BloodEffect*> bloodEffects;  // Still animating; finished ones move to bloodDecals
+    BloodDecalLayer bloodDecals;
     std::vector<GateEffect*> gateEffects;
-    std::vector<DamageNumber*> damageNumbers;
+    DamageNumberPool damageNumbers;
+    ParticleSystem particles;
+    ParticleRenderer particleRenderer;
+    Lightmap lightmap;
     InputHandler* inputHandler;
     Tilemap* tilemap;
     CollisionManager collisionManager;
+    SpriteBatch spriteBatch;
+    SpriteBatch emissiveBatch;  // Glowing sprites, drawn into the bloom mask
+    PostProcess postProcess;
+    PixelScaler pixelScaler;
+    Minimap minimap;
+    RenderTarget pausedFrame;    // Last gameplay frame, shown behind pause menus
+    bool pausedFrameValid;       // Cleared whenever gameplay draws again
+    bool pausedFrameSupported;
+    ProjectileRenderer projectileRenderer;
+    Camera camera;
 
     // Audio managers
     AudioManager* audioManager;
@@ -87,10 +120,21 @@ private:
     float levelTransitionCooldown;
     std::string assetPath;
 
+    // Emitter config indices, -1 if particles.json doesn't define them
+    int hitSparkEmitter;
+    int bloodSprayEmitter;
+    int bloodBurstEmitter;
+    int playerHitEmitter;
+    int gateSparkEmitter;
+    int gateSparks;  // Running gate emitter, -1 when the gate is closed
+    int gateLight;   // -1 when the gate is closed
+    int playerLight;
+
     // Helper methods
     void initializeGameObjects();
     void createDefaultEnemies();
     void setupProjection();
+    void fitViewToWindow(int windowWidth, int windowHeight);
     void handleLevelTransition();
     void updateGameLogic(float deltaTime, GLFWwindow* window);
     void updateEntities(float deltaTime);
@@ -98,16 +142,28 @@ private:
     void createBloodEffects();
     void createGateEffects();
     void cleanupInactiveObjects();
+    void drawScene();
+    bool capturePausedFrame(int width, int height, int windowWidth, int windowHeight);
     void drawGameWorld();
     void drawUI(int windowWidth, int windowHeight);
+    void drawSprites();
     void drawEntities();
+    void drawEntityOverlays();
+    void drawDebugOverlays();  // Queues the enabled debug categories and flushes DebugDraw
     void drawProjectiles();
+    void drawProjectilesInstanced(const ViewRect& view);
     void drawBloodEffects();
     void drawGateEffects();
+    void drawParticles(const ViewRect& view);
+    void stopGateSparks();
+    void drawBloom();
+    void drawLighting();
     void drawDamageNumbers();
+    void drawMinimap(int windowWidth, int windowHeight);
+    bool isInView(float left, float top, float right, float bottom) const;
 
     // Level management
-    void loadLevel(const std::string& levelPath);
+    bool loadLevel(const std::string& levelPath);
     void respawnEnemies();
     void teleportPlayerToCenter();
 };
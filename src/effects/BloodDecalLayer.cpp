@@ -0,0 +1,145 @@
+#include "effects/BloodDecalLayer.h"
+#include "effects/BloodEffect.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+BloodDecalLayer::BloodDecalLayer()
+    : worldWidth(0.0f), worldHeight(0.0f), pagesX(0), pagesY(0), quadBuffer(0) {
+    stampBatch.setPremultipliedOutput(true);
+}
+
+BloodDecalLayer::~BloodDecalLayer() {
+    if (quadBuffer != 0) {
+        GLState::deleteBuffers(1, &quadBuffer);
+    }
+}
+
+void BloodDecalLayer::setWorldSize(float width, float height) {
+    worldWidth = width;
+    worldHeight = height;
+    pagesX = std::max(1, static_cast<int>(std::ceil(width / PAGE_SIZE)));
+    pagesY = std::max(1, static_cast<int>(std::ceil(height / PAGE_SIZE)));
+    clear();
+}
+
+void BloodDecalLayer::add(const BloodEffect& effect) {
+    Sprite sprite;
+    if (effect.getSprite(sprite)) {
+        pending.push_back(sprite);
+    }
+}
+
+void BloodDecalLayer::clear() {
+    pages.clear();
+    pages.resize(static_cast<size_t>(pagesX) * pagesY);
+    pending.clear();
+}
+
+int BloodDecalLayer::getPageCount() const {
+    return static_cast<int>(std::count_if(pages.begin(), pages.end(),
+                                          [](const std::unique_ptr<RenderTarget>& page) { return page != nullptr; }));
+}
+
+RenderTarget* BloodDecalLayer::getPage(int pageX, int pageY) {
+    std::unique_ptr<RenderTarget>& page = pages[static_cast<size_t>(pageY) * pagesX + pageX];
+    if (!page) {
+        auto target = std::make_unique<RenderTarget>();
+        if (!target->create(PAGE_SIZE, PAGE_SIZE)) {
+            return nullptr;
+        }
+        target->bind();
+        target->clear();
+        target->unbind();
+        page = std::move(target);
+        spdlog::debug("Created blood decal page ({}, {})", pageX, pageY);
+    }
+    return page.get();
+}
+
+void BloodDecalLayer::commit() {
+    if (pending.empty() || pages.empty()) return;
+
+    // Visit each page touched by at least one pending stamp once
+    std::vector<bool> touched(pages.size(), false);
+    for (const Sprite& sprite : pending) {
+        int firstX = std::max(0, static_cast<int>(std::floor(sprite.x / PAGE_SIZE)));
+        int firstY = std::max(0, static_cast<int>(std::floor(sprite.y / PAGE_SIZE)));
+        int lastX = std::min(pagesX - 1, static_cast<int>(std::floor((sprite.x + sprite.width) / PAGE_SIZE)));
+        int lastY = std::min(pagesY - 1, static_cast<int>(std::floor((sprite.y + sprite.height) / PAGE_SIZE)));
+        for (int pageY = firstY; pageY <= lastY; ++pageY) {
+            for (int pageX = firstX; pageX <= lastX; ++pageX) {
+                touched[static_cast<size_t>(pageY) * pagesX + pageX] = true;
+            }
+        }
+    }
+    for (int pageY = 0; pageY < pagesY; ++pageY) {
+        for (int pageX = 0; pageX < pagesX; ++pageX) {
+            if (!touched[static_cast<size_t>(pageY) * pagesX + pageX]) continue;
+            if (RenderTarget* page = getPage(pageX, pageY)) {
+                stampPage(*page, pageX, pageY);
+            }
+        }
+    }
+    pending.clear();
+}
+
+void BloodDecalLayer::stampPage(RenderTarget& page, int pageX, int pageY) {
+    ViewRect pageRect{static_cast<float>(pageX * PAGE_SIZE), static_cast<float>(pageY * PAGE_SIZE),
+                      static_cast<float>((pageX + 1) * PAGE_SIZE), static_cast<float>((pageY + 1) * PAGE_SIZE)};
+
+    page.bind();
+    RenderBackend::pushOrtho(pageRect.left, pageRect.right, pageRect.bottom, pageRect.top);
+
+    // The batch culls stamps that don't reach this page
+    stampBatch.begin(pageRect);
+    for (const Sprite& sprite : pending) {
+        stampBatch.submit(sprite);
+    }
+    stampBatch.flush();
+    RenderBackend::popOrtho();
+    page.unbind();
+}
+
+void BloodDecalLayer::draw(const ViewRect& view) {
+    quadVertices.clear();
+    std::vector<GLuint> textures;
+    for (int pageY = 0; pageY < pagesY; ++pageY) {
+        for (int pageX = 0; pageX < pagesX; ++pageX) {
+            const std::unique_ptr<RenderTarget>& page = pages[static_cast<size_t>(pageY) * pagesX + pageX];
+            if (!page) continue;
+
+            float left = static_cast<float>(pageX * PAGE_SIZE);
+            float top = static_cast<float>(pageY * PAGE_SIZE);
+            float right = left + PAGE_SIZE;
+            float bottom = top + PAGE_SIZE;
+            if (!view.intersects(left, top, right, bottom)) continue;
+
+            // Pages were rendered with the level's top at the texture's top row
+            TexturedVertex topLeft = {left, top, 0.0f, 1.0f};
+            TexturedVertex topRight = {right, top, 1.0f, 1.0f};
+            TexturedVertex bottomRight = {right, bottom, 1.0f, 0.0f};
+            TexturedVertex bottomLeft = {left, bottom, 0.0f, 0.0f};
+            quadVertices.insert(quadVertices.end(), {topLeft, topRight, bottomRight, topLeft, bottomRight, bottomLeft});
+            textures.push_back(page->getTexture());
+        }
+    }
+    if (textures.empty()) return;
+
+    if (quadBuffer == 0) {
+        glGenBuffers(1, &quadBuffer);
+    }
+    GLState::bindArrayBuffer(quadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, quadVertices.size() * sizeof(TexturedVertex), quadVertices.data(), GL_STREAM_DRAW);
+
+    // Pages hold premultiplied color
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    for (size_t i = 0; i < textures.size(); ++i) {
+        RenderBackend::current().drawTextured(quadBuffer, static_cast<GLint>(i * 6), 6, textures[i],
+                                              1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "render/RenderTarget.h"
+#include "render/SpriteBatch.h"
+#include "render/ViewRect.h"
+
+class BloodEffect;
+
+// Blood that has finished animating, baked into render targets laid over the
+// tilemap. The level is split into PAGE_SIZE pages that are created the first
+// time blood lands on them, so drawing costs one quad per visible page no
+// matter how many kills there have been.
+class BloodDecalLayer {
+public:
+    BloodDecalLayer();
+    ~BloodDecalLayer();
+
+    BloodDecalLayer(const BloodDecalLayer&) = delete;
+    BloodDecalLayer& operator=(const BloodDecalLayer&) = delete;
+
+    // Size of the level in world units; drops all stamped blood
+    void setWorldSize(float width, float height);
+
+    // Queue a finished effect's last frame to be stamped on the next commit()
+    void add(const BloodEffect& effect);
+    // Stamp queued blood into the pages it overlaps
+    void commit();
+
+    void draw(const ViewRect& view);
+    void clear();
+
+    int getPageCount() const;
+
+private:
+    static constexpr int PAGE_SIZE = 1024;  // World units and texels per page side
+
+    float worldWidth, worldHeight;
+    int pagesX, pagesY;
+    std::vector<std::unique_ptr<RenderTarget>> pages;  // pagesX * pagesY, null until used
+    std::vector<Sprite> pending;
+
+    SpriteBatch stampBatch;
+    GLuint quadBuffer;
+    std::vector<TexturedVertex> quadVertices;
+
+    RenderTarget* getPage(int pageX, int pageY);
+    void stampPage(RenderTarget& page, int pageX, int pageY);
+};
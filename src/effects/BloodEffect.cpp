@@ -1,20 +1,22 @@
 #include "effects/BloodEffect.h"
+#include "render/SpriteBatch.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
 #include <spdlog/spdlog.h>
 
-BloodEffect::BloodEffect(float x, float y, const std::string& assetPath)
+AtlasHandle BloodEffect::frameRegions[BloodEffect::FRAME_COUNT] = {
+    INVALID_ATLAS_HANDLE, INVALID_ATLAS_HANDLE, INVALID_ATLAS_HANDLE, INVALID_ATLAS_HANDLE, INVALID_ATLAS_HANDLE
+};
+
+BloodEffect::BloodEffect(float x, float y)
     : x(x), y(y), active(true), finished(false),
-      animationTimer(0.0f), frameDuration(0.1f), currentFrame(0), totalFrames(5),
-      textureWidth(0), textureHeight(0) {
-    loadBloodTextures(assetPath);
+      animationTimer(0.0f), frameDuration(0.1f), currentFrame(0), totalFrames(FRAME_COUNT) {
 }
 
 BloodEffect::~BloodEffect() {
-    cleanupTextures();
 }
 
-void BloodEffect::loadBloodTextures(const std::string& assetPath) {
+void BloodEffect::loadSharedTextures(const std::string& assetPath) {
     std::vector<std::string> bloodFiles = {
         assetPath + "assets/graphic/blood/blood_01.png",
         assetPath + "assets/graphic/blood/blood_02.png",
@@ -23,53 +25,14 @@ void BloodEffect::loadBloodTextures(const std::string& assetPath) {
         assetPath + "assets/graphic/blood/blood_05.png"
     };
     
-    bloodTextures.resize(totalFrames);
-    
-    for (int i = 0; i < totalFrames; ++i) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(bloodFiles[i].c_str(), &width, &height, &channels, 0);
-        if (!data) {
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        frameRegions[i] = TextureAtlas::shared().addImage(bloodFiles[i]);
+        if (frameRegions[i] == INVALID_ATLAS_HANDLE) {
             spdlog::error("Failed to load blood texture: {}", bloodFiles[i]);
-            bloodTextures[i] = 0;
-            continue;
-        }
-        
-        // Loaded blood texture successfully
-        
-        // Store dimensions from first texture
-        if (i == 0) {
-            textureWidth = width;
-            textureHeight = height;
         }
-        
-        glGenTextures(1, &bloodTextures[i]);
-        glBindTexture(GL_TEXTURE_2D, bloodTextures[i]);
-        
-        // Use NEAREST filtering for pixel-perfect graphics
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        
-        GLenum format = GL_RGB;
-        if (channels == 4) format = GL_RGBA;
-        else if (channels == 3) format = GL_RGB;
-        else if (channels == 1) format = GL_RED;
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        stbi_image_free(data);
     }
 }
 
-void BloodEffect::cleanupTextures() {
-    for (unsigned int textureID : bloodTextures) {
-        if (textureID != 0) {
-            glDeleteTextures(1, &textureID);
-        }
-    }
-    bloodTextures.clear();
-}
-
 void BloodEffect::update(float deltaTime) {
     if (!active || finished) return;
     
@@ -87,24 +50,30 @@ void BloodEffect::update(float deltaTime) {
     }
 }
 
-void BloodEffect::draw() const {
-    if (!active || currentFrame >= bloodTextures.size() || bloodTextures[currentFrame] == 0) {
-        return;
+bool BloodEffect::getSprite(Sprite& sprite) const {
+    if (!active || currentFrame >= FRAME_COUNT) {
+        return false;
+    }
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(frameRegions[currentFrame]);
+    if (region.texture == 0) {
+        return false;
     }
-    
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, bloodTextures[currentFrame]);
     
     // Draw blood effect centered on the death position
-    float drawX = x - textureWidth / 2.0f;
-    float drawY = y - textureHeight / 2.0f;
-    
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(drawX, drawY);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(drawX + textureWidth, drawY);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(drawX + textureWidth, drawY + textureHeight);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(drawX, drawY + textureHeight);
-    glEnd();
-    
-    glDisable(GL_TEXTURE_2D);
-} 
\ No newline at end of file
+    sprite.texture = region.texture;
+    sprite.x = x - region.width / 2.0f;
+    sprite.y = y - region.height / 2.0f;
+    sprite.width = static_cast<float>(region.width);
+    sprite.height = static_cast<float>(region.height);
+    sprite.u1 = region.u1; sprite.v1 = region.v2;
+    sprite.u2 = region.u2; sprite.v2 = region.v1;
+    sprite.layer = SpriteLayer::Effect;
+    return true;
+}
+
+void BloodEffect::draw(SpriteBatch& batch) const {
+    Sprite sprite;
+    if (getSprite(sprite)) {
+        batch.submit(sprite);
+    }
+}
@@ -1,19 +1,28 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "render/TextureAtlas.h"
+
+class SpriteBatch;
+struct Sprite;
 
 class BloodEffect {
 public:
-    BloodEffect(float x, float y, const std::string& assetPath = "");
+    BloodEffect(float x, float y);
     ~BloodEffect();
     
     void update(float deltaTime);
-    void draw() const;
+    void draw(SpriteBatch& batch) const;
+    // The quad draw() would submit; false if there is nothing to draw
+    bool getSprite(Sprite& sprite) const;
     bool isActive() const { return active; }
     bool isFinished() const { return finished; }
     float getX() const { return x; }
     float getY() const { return y; }
 
+    // Blood frames are shared by every effect; register them with the atlas once at startup
+    static void loadSharedTextures(const std::string& assetPath);
+
 private:
     float x, y;
     bool active;
@@ -25,11 +34,7 @@ private:
     int currentFrame;
     int totalFrames;
     
-    // Textures for blood frames
-    std::vector<unsigned int> bloodTextures;
-    int textureWidth, textureHeight;
-    
-    // Load blood textures
-    void loadBloodTextures(const std::string& assetPath);
-    void cleanupTextures();
+    // Atlas regions for blood frames (blood_01..05)
+    static constexpr int FRAME_COUNT = 5;
+    static AtlasHandle frameRegions[FRAME_COUNT];
 }; 
\ No newline at end of file
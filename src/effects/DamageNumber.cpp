@@ -1,106 +1,21 @@
 #include "effects/DamageNumber.h"
-#include "ui/UI.h"
-#include "ui/TextRenderer.h"
-#include <GLFW/glfw3.h>
+#include "render/GLState.h"
+#include "render/SpriteBatch.h"
 #include <spdlog/spdlog.h>
-#include <string>
+#include <vector>
 
-DamageNumber::DamageNumber(float x, float y, int damage, bool isPlayerDamage)
-    : x(x), y(y), damage(damage), isPlayerDamage(isPlayerDamage),
-      active(true), finished(false),
-      lifetime(0.0f), maxLifetime(1.5f), floatSpeed(30.0f), alpha(1.0f) {
-    spdlog::debug("DamageNumber created at ({}, {}) with damage: {}", x, y, damage);
-}
-
-DamageNumber::~DamageNumber() {
-}
-
-void DamageNumber::update(float deltaTime) {
-    if (!active) return;
-    
-    lifetime += deltaTime;
-    
-    // Float upwards
-    y -= floatSpeed * deltaTime;
-    
-    // Fade out over time
-    alpha = 1.0f - (lifetime / maxLifetime);
-    
-    // Deactivate when lifetime is exceeded
-    if (lifetime >= maxLifetime) {
-        active = false;
-        finished = true;
-    }
-}
-
-void DamageNumber::draw() const {
-    if (!active || alpha <= 0.0f) return;
-    
-    // Set color based on damage type
-    float r, g, b;
-    if (isPlayerDamage) {
-        // Red for player damage
-        r = 1.0f;
-        g = 0.2f;
-        b = 0.2f;
-    } else {
-        // Yellow/Gold for enemy damage
-        r = 1.0f;
-        g = 0.85f;
-        b = 0.0f;
-    }
-    
-    std::string damageText = std::to_string(damage);
-    
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_TEXTURE_2D);
-    
-    // Draw black outline/shadow for visibility (4 directions only for performance)
-    drawTextInWorldSpace(damageText, x - 1, y, 1.0f, 0.0f, 0.0f, 0.0f, alpha * 0.9f);
-    drawTextInWorldSpace(damageText, x + 1, y, 1.0f, 0.0f, 0.0f, 0.0f, alpha * 0.9f);
-    drawTextInWorldSpace(damageText, x, y - 1, 1.0f, 0.0f, 0.0f, 0.0f, alpha * 0.9f);
-    drawTextInWorldSpace(damageText, x, y + 1, 1.0f, 0.0f, 0.0f, 0.0f, alpha * 0.9f);
-    
-    // Draw the main colored rectangles
-    drawTextInWorldSpace(damageText, x, y, 1.0f, r, g, b, alpha);
-    
-    // Reset states
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-}
+namespace {
+    // 5x7 pixel art digits, drawn into cells with a one pixel outline
+    constexpr int GLYPH_WIDTH = 5;
+    constexpr int GLYPH_HEIGHT = 7;
+    constexpr int CELL_WIDTH = GLYPH_WIDTH + 2;
+    constexpr int CELL_HEIGHT = GLYPH_HEIGHT + 2;
+    constexpr int TEXTURE_WIDTH = CELL_WIDTH * 10;
+    constexpr float PIXEL_SIZE = 1.2f;  // World units per glyph pixel
+    constexpr float ADVANCE = (GLYPH_WIDTH + 2) * PIXEL_SIZE;
+    constexpr unsigned char OUTLINE_ALPHA = 230;
 
-void DamageNumber::drawTextInWorldSpace(const std::string& text, float worldX, float worldY, 
-                                         float scale, float r, float g, float b, float a) const {
-    // Simple pixel-art style number renderer in world coordinates
-    
-    glDisable(GL_TEXTURE_2D);
-    glColor4f(r, g, b, a);
-    
-    float pixelSize = 1.2f;  // Size of each pixel in the digit
-    float charWidth = 5.0f * pixelSize;  // 5 pixels wide
-    float charHeight = 7.0f * pixelSize; // 7 pixels tall
-    float spacing = pixelSize * 2.0f;
-    float totalWidth = text.length() * (charWidth + spacing);
-    float startX = worldX - totalWidth / 2.0f;
-    
-    for (size_t i = 0; i < text.length(); ++i) {
-        char c = text[i];
-        if (c < '0' || c > '9') continue; // Only render digits
-        
-        float charX = startX + i * (charWidth + spacing);
-        drawDigitShape(c - '0', charX, worldY, pixelSize);
-    }
-    
-    glEnable(GL_TEXTURE_2D);
-}
-
-void DamageNumber::drawDigitShape(int digit, float x, float y, float pixelSize) const {
-    // 5x7 pixel art font for digits 0-9
-    // Each digit is represented as a 5x7 grid where 1 = pixel on, 0 = pixel off
-    
-    static const bool digitPatterns[10][7][5] = {
+    const bool DIGIT_PATTERNS[10][GLYPH_HEIGHT][GLYPH_WIDTH] = {
         // 0
         {{0,1,1,1,0},
          {1,0,0,0,1},
@@ -182,24 +97,156 @@ void DamageNumber::drawDigitShape(int digit, float x, float y, float pixelSize)
          {0,0,0,1,0},
          {0,1,1,0,0}}
     };
-    
-    if (digit < 0 || digit > 9) return;
-    
-    // Draw each pixel of the digit
-    glBegin(GL_QUADS);
-    for (int row = 0; row < 7; row++) {
-        for (int col = 0; col < 5; col++) {
-            if (digitPatterns[digit][row][col]) {
-                float px = x + col * pixelSize;
-                float py = y + row * pixelSize;
-                
-                glVertex2f(px, py);
-                glVertex2f(px + pixelSize, py);
-                glVertex2f(px + pixelSize, py + pixelSize);
-                glVertex2f(px, py + pixelSize);
-            }
+
+    bool isGlyphPixel(int digit, int col, int row) {
+        return col >= 0 && col < GLYPH_WIDTH && row >= 0 && row < GLYPH_HEIGHT &&
+               DIGIT_PATTERNS[digit][row][col];
+    }
+}
+
+DamageNumberPool::DamageNumberPool()
+    : activeCount(0), glyphTexture(0) {
+}
+
+DamageNumberPool::~DamageNumberPool() {
+    if (glyphTexture != 0) {
+        GLState::deleteTextures(1, &glyphTexture);
+    }
+}
+
+void DamageNumberPool::spawn(float x, float y, int damage, bool isPlayerDamage, const void* target) {
+    DamageNumber* slot = nullptr;
+    DamageNumber* oldest = &numbers[0];
+    for (DamageNumber& number : numbers) {
+        if (!number.active) {
+            if (!slot) slot = &number;
+            continue;
+        }
+        if (target && number.target == target && number.isPlayerDamage == isPlayerDamage &&
+            number.lifetime < MERGE_WINDOW) {
+            // Keeps rising from where it is, with the fade restarted
+            number.damage += damage;
+            number.lifetime = 0.0f;
+            return;
+        }
+        if (number.lifetime > oldest->lifetime || !oldest->active) {
+            oldest = &number;
+        }
+    }
+
+    if (!slot) {
+        slot = oldest;
+    } else {
+        ++activeCount;
+    }
+    slot->x = x;
+    slot->y = y;
+    slot->damage = damage;
+    slot->isPlayerDamage = isPlayerDamage;
+    slot->target = target;
+    slot->lifetime = 0.0f;
+    slot->active = true;
+}
+
+void DamageNumberPool::update(float deltaTime) {
+    if (activeCount == 0) return;
+
+    for (DamageNumber& number : numbers) {
+        if (!number.active) continue;
+        number.lifetime += deltaTime;
+        number.y -= FLOAT_SPEED * deltaTime;
+        if (number.lifetime >= MAX_LIFETIME) {
+            number.active = false;
+            number.target = nullptr;
+            --activeCount;
+        }
+    }
+}
+
+void DamageNumberPool::clear() {
+    for (DamageNumber& number : numbers) {
+        number.active = false;
+        number.target = nullptr;
+    }
+    activeCount = 0;
+}
+
+void DamageNumberPool::draw(SpriteBatch& batch) {
+    if (activeCount == 0) return;
+
+    Sprite sprite;
+    sprite.texture = getGlyphTexture();
+    sprite.width = CELL_WIDTH * PIXEL_SIZE;
+    sprite.height = CELL_HEIGHT * PIXEL_SIZE;
+    sprite.v1 = 0.0f;
+    sprite.v2 = 1.0f;
+    sprite.layer = SpriteLayer::Effect;
+
+    for (const DamageNumber& number : numbers) {
+        if (!number.active) continue;
+
+        if (number.isPlayerDamage) {
+            // Red for player damage
+            sprite.r = 1.0f; sprite.g = 0.2f; sprite.b = 0.2f;
+        } else {
+            // Yellow/Gold for enemy damage
+            sprite.r = 1.0f; sprite.g = 0.85f; sprite.b = 0.0f;
+        }
+        sprite.a = 1.0f - number.lifetime / MAX_LIFETIME;
+
+        // Digits of the value, least significant first
+        int digits[10];
+        int digitCount = 0;
+        unsigned int value = number.damage > 0 ? static_cast<unsigned int>(number.damage) : 0u;
+        do {
+            digits[digitCount++] = value % 10;
+            value /= 10;
+        } while (value > 0 && digitCount < 10);
+
+        // Centered on x, each glyph cell starting one pixel before its digit
+        float startX = number.x - digitCount * ADVANCE / 2.0f;
+        for (int i = 0; i < digitCount; ++i) {
+            int digit = digits[digitCount - 1 - i];
+            sprite.x = startX + i * ADVANCE - PIXEL_SIZE;
+            sprite.y = number.y - PIXEL_SIZE;
+            sprite.u1 = static_cast<float>(digit * CELL_WIDTH) / TEXTURE_WIDTH;
+            sprite.u2 = static_cast<float>((digit + 1) * CELL_WIDTH) / TEXTURE_WIDTH;
+            batch.submit(sprite);
         }
     }
-    glEnd();
 }
 
+GLuint DamageNumberPool::getGlyphTexture() {
+    if (glyphTexture != 0) return glyphTexture;
+
+    // White digits tint to the number's color; the black outline stays black
+    std::vector<unsigned char> pixels(TEXTURE_WIDTH * CELL_HEIGHT * 4, 0);
+    for (int digit = 0; digit < 10; ++digit) {
+        for (int row = 0; row < CELL_HEIGHT; ++row) {
+            for (int col = 0; col < CELL_WIDTH; ++col) {
+                int glyphCol = col - 1;
+                int glyphRow = row - 1;
+                unsigned char* pixel = &pixels[(row * TEXTURE_WIDTH + digit * CELL_WIDTH + col) * 4];
+                if (isGlyphPixel(digit, glyphCol, glyphRow)) {
+                    pixel[0] = pixel[1] = pixel[2] = pixel[3] = 255;
+                } else if (isGlyphPixel(digit, glyphCol - 1, glyphRow) || isGlyphPixel(digit, glyphCol + 1, glyphRow) ||
+                           isGlyphPixel(digit, glyphCol, glyphRow - 1) || isGlyphPixel(digit, glyphCol, glyphRow + 1)) {
+                    pixel[3] = OUTLINE_ALPHA;
+                }
+            }
+        }
+    }
+
+    glGenTextures(1, &glyphTexture);
+    GLState::bindTexture(glyphTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_WIDTH, CELL_HEIGHT, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    GLState::bindTexture(0);
+    spdlog::debug("Damage number glyph texture created with ID: {}", glyphTexture);
+
+    return glyphTexture;
+}
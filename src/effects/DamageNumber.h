@@ -1,33 +1,51 @@
 #pragma once
-#include <string>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
 
-class DamageNumber {
+class SpriteBatch;
+
+// One floating number. Slots in DamageNumberPool are reused, so nothing
+// here is allocated per hit.
+struct DamageNumber {
+    float x = 0.0f, y = 0.0f;
+    int damage = 0;
+    bool isPlayerDamage = false;  // true = player took damage (red), false = enemy took damage (yellow)
+    const void* target = nullptr; // Who was hit; hits on the same target merge
+    float lifetime = 0.0f;        // Seconds since the last hit that fed it
+    bool active = false;
+};
+
+// Fixed pool of damage numbers, drawn as sprites from a small glyph texture
+// with the outline baked in. A hit on a target whose number is still fresh
+// adds to that number and restarts its fade instead of stacking a new one.
+class DamageNumberPool {
 public:
-    DamageNumber(float x, float y, int damage, bool isPlayerDamage);
-    ~DamageNumber();
-    
+    static constexpr int CAPACITY = 128;
+
+    DamageNumberPool();
+    ~DamageNumberPool();
+
+    DamageNumberPool(const DamageNumberPool&) = delete;
+    DamageNumberPool& operator=(const DamageNumberPool&) = delete;
+
+    // With a full pool the oldest number is replaced
+    void spawn(float x, float y, int damage, bool isPlayerDamage, const void* target = nullptr);
     void update(float deltaTime);
-    void draw() const;
-    bool isActive() const { return active; }
-    bool isFinished() const { return finished; }
-    float getX() const { return x; }
-    float getY() const { return y; }
+    void clear();
+
+    // Queue every active number into batch, which the caller flushes
+    void draw(SpriteBatch& batch);
+
+    int getActiveCount() const { return activeCount; }
 
 private:
-    float x, y;
-    int damage;
-    bool isPlayerDamage;  // true = player took damage (red), false = enemy took damage (yellow)
-    bool active;
-    bool finished;
-    
-    // Animation properties
-    float lifetime;
-    float maxLifetime;
-    float floatSpeed;
-    float alpha;  // Fade out effect
-    
-    // Helper methods to draw text in world space
-    void drawTextInWorldSpace(const std::string& text, float worldX, float worldY, 
-                               float scale, float r, float g, float b, float a) const;
-    void drawDigitShape(int digit, float x, float y, float pixelSize) const;
-}; 
+    static constexpr float MAX_LIFETIME = 1.5f;
+    static constexpr float FLOAT_SPEED = 30.0f;   // World units per second, upwards
+    static constexpr float MERGE_WINDOW = 0.35f;  // Seconds a number keeps absorbing hits
+
+    DamageNumber numbers[CAPACITY];
+    int activeCount;
+    GLuint glyphTexture;
+
+    GLuint getGlyphTexture();
+};
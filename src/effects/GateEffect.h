@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "render/TextureCache.h"
+
+class SpriteBatch;
 
 class GateEffect {
 public:
@@ -8,7 +11,7 @@ public:
     ~GateEffect();
     
     void update(float deltaTime);
-    void draw() const;
+    void draw(SpriteBatch& batch) const;
     bool isActive() const { return active; }
     bool isFinished() const { return finished; }
     float getX() const { return x; }
@@ -28,6 +31,7 @@ private:
     bool looping;
     
     // Texture for gate effects spritesheet
+    TextureHandle gateTexture;
     unsigned int gateTextureID;
     int textureWidth, textureHeight;
     int frameWidth, frameHeight;
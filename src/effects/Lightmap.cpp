@@ -0,0 +1,514 @@
+#include "effects/Lightmap.h"
+#include "map/TileMap.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+    // Path costs are in half tiles: a straight step costs 2 and a diagonal 3,
+    // which keeps the flood close to round with integer buckets
+    constexpr int STRAIGHT_COST = 2;
+    constexpr int DIAGONAL_COST = 3;
+
+    // Rows uploaded per call when filling the texture
+    constexpr int FILL_ROWS = 64;
+
+    // Transforms from octant 0 into each of the eight octants
+    const int OCTANTS[4][8] = {
+        {1, 0, 0, -1, -1, 0, 0, 1},
+        {0, 1, -1, 0, 0, -1, 1, 0},
+        {0, 1, 1, 0, 0, -1, -1, 0},
+        {1, 0, 0, 1, -1, 0, 0, -1}
+    };
+
+    unsigned char toByte(float value) {
+        return static_cast<unsigned char>(std::min(value, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+bool Lightmap::TileRect::overlaps(const TileRect& other) const {
+    return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+}
+
+void Lightmap::TileRect::include(const TileRect& other) {
+    if (other.isEmpty()) return;
+    if (isEmpty()) {
+        *this = other;
+        return;
+    }
+    left = std::min(left, other.left);
+    top = std::min(top, other.top);
+    right = std::max(right, other.right);
+    bottom = std::max(bottom, other.bottom);
+}
+
+Lightmap::Lightmap()
+    : enabled(true), ambient(0.45f), hasViewer(false), viewerX(0.0f), viewerY(0.0f),
+      fogStale(true), viewerTileX(0), viewerTileY(0), width(0), height(0),
+      tileWidth(0), tileHeight(0), generation(0), appliedEdits(0), fillStale(true), texture(0), quadBuffer(0) {
+}
+
+Lightmap::~Lightmap() {
+    release();
+}
+
+void Lightmap::release() {
+    if (texture != 0) {
+        GLState::deleteTextures(1, &texture);
+        texture = 0;
+    }
+    if (quadBuffer != 0) {
+        GLState::deleteBuffers(1, &quadBuffer);
+        quadBuffer = 0;
+    }
+    generation = 0;
+}
+
+void Lightmap::setEnabled(bool enabled) {
+    this->enabled = enabled;
+}
+
+void Lightmap::setAmbient(float level) {
+    if (level == ambient) return;
+    ambient = level;
+    // Under fog only the tiles seen so far show the ambient level
+    if (hasViewer) {
+        markDirty(exploredRect);
+    } else {
+        fillStale = true;
+    }
+}
+
+int Lightmap::addLight(float worldX, float worldY, float radius, float r, float g, float b) {
+    for (int i = 0; i < MAX_LIGHTS; ++i) {
+        Light& light = lights[i];
+        if (light.active) continue;
+        light.active = true;
+        light.worldX = worldX;
+        light.worldY = worldY;
+        light.radius = radius;
+        light.r = r;
+        light.g = g;
+        light.b = b;
+        light.stale = true;
+        light.patch = TileRect();
+        return i;
+    }
+    spdlog::warn("All {} lights are in use", MAX_LIGHTS);
+    return -1;
+}
+
+void Lightmap::moveLight(int light, float worldX, float worldY) {
+    if (light < 0 || light >= MAX_LIGHTS || !lights[light].active) return;
+    lights[light].worldX = worldX;
+    lights[light].worldY = worldY;
+}
+
+void Lightmap::removeLight(int light) {
+    if (light < 0 || light >= MAX_LIGHTS || !lights[light].active) return;
+    lights[light].active = false;
+    markDirty(lights[light].patch);
+}
+
+void Lightmap::clearLights() {
+    for (int i = 0; i < MAX_LIGHTS; ++i) {
+        removeLight(i);
+    }
+}
+
+void Lightmap::setViewer(float worldX, float worldY) {
+    // The fog turns every unseen tile black
+    if (!hasViewer) fillStale = true;
+    hasViewer = true;
+    viewerX = worldX;
+    viewerY = worldY;
+}
+
+bool Lightmap::isVisible(float worldX, float worldY) const {
+    if (!enabled || !hasViewer || fog.empty()) return true;
+    int x = toTileX(worldX);
+    int y = toTileY(worldY);
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return fog[static_cast<size_t>(y) * width + x] == FOG_VISIBLE;
+}
+
+int Lightmap::toTileX(float worldX) const {
+    return static_cast<int>(std::floor(worldX / tileWidth));
+}
+
+int Lightmap::toTileY(float worldY) const {
+    return static_cast<int>(std::floor(worldY / tileHeight));
+}
+
+bool Lightmap::isSolid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return true;
+    return solid[static_cast<size_t>(y) * width + x] != 0;
+}
+
+void Lightmap::markDirty(TileRect rect) {
+    if (rect.isEmpty()) return;
+    // Overlapping rects merge so no texel is rebuilt twice in one update
+    for (size_t i = 0; i < dirtyRects.size();) {
+        if (!rect.overlaps(dirtyRects[i])) {
+            ++i;
+            continue;
+        }
+        rect.include(dirtyRects[i]);
+        dirtyRects[i] = dirtyRects.back();
+        dirtyRects.pop_back();
+        i = 0;
+    }
+    dirtyRects.push_back(rect);
+}
+
+void Lightmap::reset(const Tilemap& tilemap) {
+    width = tilemap.getWidthInTiles();
+    height = tilemap.getHeightInTiles();
+    tileWidth = tilemap.getTileWidth();
+    tileHeight = tilemap.getTileHeight();
+    generation = tilemap.getGeneration();
+    appliedEdits = tilemap.getEditedTiles().size();
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (width > maxSize || height > maxSize) {
+        spdlog::warn("A {}x{} map is larger than the {} texel lightmap limit, lighting is off for this level",
+                     width, height, maxSize);
+        width = 0;
+        height = 0;
+    }
+
+    solid.assign(static_cast<size_t>(width) * height, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            solid[static_cast<size_t>(y) * width + x] = tilemap.isTileSolid(x, y) ? 1 : 0;
+        }
+    }
+    // A new level starts unexplored
+    fog.assign(solid.size(), FOG_UNSEEN);
+    visibleTiles.clear();
+    viewRect = TileRect();
+    exploredRect = TileRect();
+    fogStale = true;
+    for (Light& light : lights) {
+        light.stale = true;
+        light.patch = TileRect();
+    }
+    dirtyRects.clear();
+    fillStale = true;
+    if (width <= 0 || height <= 0 || tileWidth <= 0 || tileHeight <= 0) {
+        if (texture != 0) {
+            GLState::deleteTextures(1, &texture);
+            texture = 0;
+        }
+        return;
+    }
+
+    // Bilinear filtering blends each tile's light into its neighbours'
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+    GLState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Texel centers land on tile centers
+    float right = static_cast<float>(width * tileWidth);
+    float bottom = static_cast<float>(height * tileHeight);
+    const TexturedVertex quad[6] = {
+        {0.0f, 0.0f, 0.0f, 0.0f}, {right, 0.0f, 1.0f, 0.0f}, {right, bottom, 1.0f, 1.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f}, {right, bottom, 1.0f, 1.0f}, {0.0f, bottom, 0.0f, 1.0f}
+    };
+    if (quadBuffer == 0) {
+        glGenBuffers(1, &quadBuffer);
+    }
+    GLState::bindArrayBuffer(quadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    spdlog::debug("Lightmap reset for a {}x{} map", width, height);
+}
+
+void Lightmap::applyEdits(const Tilemap& tilemap) {
+    const std::vector<std::pair<int, int>>& edits = tilemap.getEditedTiles();
+    // No grids on a map too large for lighting, but the edits still count as seen
+    if (solid.empty()) {
+        appliedEdits = edits.size();
+        return;
+    }
+    for (size_t i = appliedEdits; i < edits.size(); ++i) {
+        int x = edits[i].first;
+        int y = edits[i].second;
+        unsigned char isWall = tilemap.isTileSolid(x, y) ? 1 : 0;
+        unsigned char& cell = solid[static_cast<size_t>(y) * width + x];
+        if (cell == isWall) continue;
+        cell = isWall;
+
+        // Only what could have reached the tile needs redoing
+        for (Light& light : lights) {
+            const TileRect& patch = light.patch;
+            if (light.active && x >= patch.left && x < patch.right && y >= patch.top && y < patch.bottom) {
+                light.stale = true;
+            }
+        }
+        if (x >= viewRect.left && x < viewRect.right && y >= viewRect.top && y < viewRect.bottom) {
+            fogStale = true;
+        }
+    }
+    appliedEdits = edits.size();
+}
+
+void Lightmap::propagate(Light& light) {
+    light.tileX = toTileX(light.worldX);
+    light.tileY = toTileY(light.worldY);
+    light.stale = false;
+    light.patch = TileRect();
+    if (light.tileX < 0 || light.tileY < 0 || light.tileX >= width || light.tileY >= height) return;
+
+    int reach = static_cast<int>(std::ceil(light.radius));
+    TileRect& patch = light.patch;
+    patch.left = std::max(0, light.tileX - reach);
+    patch.top = std::max(0, light.tileY - reach);
+    patch.right = std::min(width, light.tileX + reach + 1);
+    patch.bottom = std::min(height, light.tileY + reach + 1);
+    int patchWidth = patch.right - patch.left;
+    int patchHeight = patch.bottom - patch.top;
+    light.intensity.assign(static_cast<size_t>(patchWidth) * patchHeight, 0.0f);
+
+    // Dijkstra over a bucket queue; costs are small integers
+    int maxCost = static_cast<int>(light.radius * STRAIGHT_COST);
+    pathCost.assign(light.intensity.size(), INT_MAX);
+    if (costBuckets.size() < static_cast<size_t>(maxCost) + 1) {
+        costBuckets.resize(static_cast<size_t>(maxCost) + 1);
+    }
+    for (int cost = 0; cost <= maxCost; ++cost) {
+        costBuckets[cost].clear();
+    }
+
+    int start = (light.tileY - patch.top) * patchWidth + (light.tileX - patch.left);
+    pathCost[start] = 0;
+    costBuckets[0].push_back(start);
+    for (int cost = 0; cost <= maxCost; ++cost) {
+        // Every step costs at least 2, so nothing is added to this bucket while it is walked
+        for (int index : costBuckets[cost]) {
+            if (pathCost[index] != cost) continue;  // Reached more cheaply since it was queued
+
+            float falloff = 1.0f - static_cast<float>(cost) / (maxCost + 1);
+            light.intensity[index] = falloff * falloff;
+
+            int x = patch.left + index % patchWidth;
+            int y = patch.top + index / patchWidth;
+            // Walls take the light on their face but stop it
+            if (cost > 0 && isSolid(x, y)) continue;
+
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx == 0 && dy == 0) continue;
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (nx < patch.left || ny < patch.top || nx >= patch.right || ny >= patch.bottom) continue;
+
+                    bool diagonal = dx != 0 && dy != 0;
+                    // No squeezing between two walls that touch at a corner
+                    if (diagonal && (isSolid(x + dx, y) || isSolid(x, y + dy))) continue;
+
+                    int nextCost = cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+                    int next = (ny - patch.top) * patchWidth + (nx - patch.left);
+                    if (nextCost > maxCost || nextCost >= pathCost[next]) continue;
+                    pathCost[next] = nextCost;
+                    costBuckets[nextCost].push_back(next);
+                }
+            }
+        }
+    }
+}
+
+void Lightmap::markVisible(int x, int y) {
+    size_t index = static_cast<size_t>(y) * width + x;
+    if (fog[index] == FOG_VISIBLE) return;
+    fog[index] = FOG_VISIBLE;
+    visibleTiles.push_back(static_cast<int>(index));
+}
+
+// Recursive shadowcasting over one octant, scanning rows outward from row
+// and keeping the part of each row between startSlope and endSlope
+void Lightmap::castOctant(int row, float startSlope, float endSlope, int xx, int xy, int yx, int yy) {
+    if (startSlope < endSlope) return;
+
+    float nextStartSlope = startSlope;
+    for (int distance = row; distance <= VIEW_RADIUS; ++distance) {
+        bool blocked = false;
+        int deltaY = -distance;
+        for (int deltaX = -distance; deltaX <= 0; ++deltaX) {
+            int x = viewerTileX + deltaX * xx + deltaY * xy;
+            int y = viewerTileY + deltaX * yx + deltaY * yy;
+            float leftSlope = (deltaX - 0.5f) / (deltaY + 0.5f);
+            float rightSlope = (deltaX + 0.5f) / (deltaY - 0.5f);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            bool inside = x >= 0 && y >= 0 && x < width && y < height;
+            if (inside && deltaX * deltaX + deltaY * deltaY <= VIEW_RADIUS * VIEW_RADIUS) {
+                markVisible(x, y);
+            }
+
+            bool wall = isSolid(x, y);
+            if (blocked) {
+                if (wall) {
+                    nextStartSlope = rightSlope;
+                } else {
+                    blocked = false;
+                    startSlope = nextStartSlope;
+                }
+            } else if (wall && distance < VIEW_RADIUS) {
+                blocked = true;
+                castOctant(distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                nextStartSlope = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+void Lightmap::castFog() {
+    fogStale = false;
+    for (int index : visibleTiles) {
+        fog[index] = FOG_EXPLORED;
+    }
+    visibleTiles.clear();
+    markDirty(viewRect);
+
+    viewerTileX = toTileX(viewerX);
+    viewerTileY = toTileY(viewerY);
+    viewRect.left = std::max(0, viewerTileX - VIEW_RADIUS);
+    viewRect.top = std::max(0, viewerTileY - VIEW_RADIUS);
+    viewRect.right = std::min(width, viewerTileX + VIEW_RADIUS + 1);
+    viewRect.bottom = std::min(height, viewerTileY + VIEW_RADIUS + 1);
+    if (viewRect.isEmpty()) return;
+
+    if (viewerTileX >= 0 && viewerTileY >= 0 && viewerTileX < width && viewerTileY < height) {
+        markVisible(viewerTileX, viewerTileY);
+    }
+    for (int octant = 0; octant < 8; ++octant) {
+        castOctant(1, 1.0f, 0.0f, OCTANTS[0][octant], OCTANTS[1][octant], OCTANTS[2][octant], OCTANTS[3][octant]);
+    }
+    exploredRect.include(viewRect);
+    markDirty(viewRect);
+}
+
+// What rebuild gives a tile no light reaches: black under the fog before
+// anything is seen, the ambient level without a viewer
+void Lightmap::fill() {
+    fillStale = false;
+    unsigned char level = hasViewer ? 0 : toByte(ambient);
+    int rows = std::min(height, FILL_ROWS);
+    texels.assign(static_cast<size_t>(width) * rows * 4, level);
+    for (size_t i = 3; i < texels.size(); i += 4) {
+        texels[i] = 255;
+    }
+
+    GLState::bindTexture(texture);
+    for (int y = 0; y < height; y += rows) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, std::min(rows, height - y),
+                        GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+    }
+
+    // Only the tiles that differ from the fill need the full rebuild
+    markDirty(exploredRect);
+    for (const Light& light : lights) {
+        if (light.active) markDirty(light.patch);
+    }
+}
+
+void Lightmap::rebuild(const TileRect& rect) {
+    int rectWidth = rect.right - rect.left;
+    int rectHeight = rect.bottom - rect.top;
+    accumulated.assign(static_cast<size_t>(rectWidth) * rectHeight * 3, ambient);
+
+    for (const Light& light : lights) {
+        if (!light.active) continue;
+        const TileRect& patch = light.patch;
+        int left = std::max(rect.left, patch.left);
+        int top = std::max(rect.top, patch.top);
+        int right = std::min(rect.right, patch.right);
+        int bottom = std::min(rect.bottom, patch.bottom);
+        int patchWidth = patch.right - patch.left;
+        for (int y = top; y < bottom; ++y) {
+            const float* intensity = &light.intensity[static_cast<size_t>(y - patch.top) * patchWidth];
+            float* out = &accumulated[(static_cast<size_t>(y - rect.top) * rectWidth + (left - rect.left)) * 3];
+            for (int x = left; x < right; ++x, out += 3) {
+                float amount = intensity[x - patch.left];
+                out[0] += amount * light.r;
+                out[1] += amount * light.g;
+                out[2] += amount * light.b;
+            }
+        }
+    }
+
+    bool useFog = hasViewer;
+    texels.resize(static_cast<size_t>(rectWidth) * rectHeight * 4);
+    for (int y = 0; y < rectHeight; ++y) {
+        const unsigned char* fogRow = &fog[static_cast<size_t>(y + rect.top) * width + rect.left];
+        for (int x = 0; x < rectWidth; ++x) {
+            size_t index = static_cast<size_t>(y) * rectWidth + x;
+            float visibility = 1.0f;
+            if (useFog) {
+                visibility = fogRow[x] == FOG_VISIBLE ? 1.0f : fogRow[x] == FOG_EXPLORED ? EXPLORED_LEVEL : 0.0f;
+            }
+            const float* light = &accumulated[index * 3];
+            unsigned char* texel = &texels[index * 4];
+            texel[0] = toByte(light[0] * visibility);
+            texel[1] = toByte(light[1] * visibility);
+            texel[2] = toByte(light[2] * visibility);
+            texel[3] = 255;
+        }
+    }
+
+    GLState::bindTexture(texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, rect.left, rect.top, rectWidth, rectHeight,
+                    GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+}
+
+void Lightmap::update(const Tilemap& tilemap) {
+    if (!enabled) return;
+    if (generation != tilemap.getGeneration()) {
+        reset(tilemap);
+    } else {
+        applyEdits(tilemap);
+    }
+    if (texture == 0) return;
+
+    for (Light& light : lights) {
+        if (!light.active) continue;
+        if (light.stale || toTileX(light.worldX) != light.tileX || toTileY(light.worldY) != light.tileY) {
+            markDirty(light.patch);
+            propagate(light);
+            markDirty(light.patch);
+        }
+    }
+
+    if (hasViewer && (fogStale || toTileX(viewerX) != viewerTileX || toTileY(viewerY) != viewerTileY)) {
+        castFog();
+    }
+
+    if (fillStale) {
+        fill();
+    }
+    for (const TileRect& rect : dirtyRects) {
+        rebuild(rect);
+    }
+    dirtyRects.clear();
+}
+
+void Lightmap::draw() {
+    if (!enabled || texture == 0) return;
+
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_DST_COLOR, GL_ZERO);
+    RenderBackend::current().drawTextured(quadBuffer, 0, 6, texture, 1.0f, 1.0f, 1.0f, 1.0f);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <vector>
+
+class Tilemap;
+
+// Tile-resolution lighting and fog of war, computed on the CPU from the
+// tilemap's collision layer and multiplied over the world as a texture with
+// one texel per tile.
+//
+// A light floods outward from its tile and dims with the length of the path,
+// so it bends around corners but never passes through a wall. Each light
+// keeps the patch it last computed and only redoes it when it moves onto
+// another tile or a tile within its reach is edited. The texture is then
+// rebuilt and uploaded for the changed rectangles alone, so lights that stand
+// still cost nothing per frame. A new level starts from a flat fill rather
+// than a rebuild of every tile, and maps wider or taller than the largest
+// texture the driver allows play without lighting.
+//
+// Fog is line of sight from the viewer, found by shadowcasting: tiles in view
+// show their light, tiles seen before are dimmed and the rest stay black.
+class Lightmap {
+public:
+    static constexpr int MAX_LIGHTS = 64;
+
+    Lightmap();
+    ~Lightmap();
+
+    Lightmap(const Lightmap&) = delete;
+    Lightmap& operator=(const Lightmap&) = delete;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    // Brightness of tiles no light reaches, 0..1
+    void setAmbient(float level);
+
+    // radius is in tiles. Returns the light's id, or -1 when all
+    // MAX_LIGHTS are in use.
+    int addLight(float worldX, float worldY, float radius, float r, float g, float b);
+    void moveLight(int light, float worldX, float worldY);
+    void removeLight(int light);
+    void clearLights();
+
+    // Where the fog of war is seen from
+    void setViewer(float worldX, float worldY);
+    // Whether the viewer can currently see this point. Always true when
+    // lighting is off.
+    bool isVisible(float worldX, float worldY) const;
+
+    // Bring the texture in line with the lights, the viewer and tilemap
+    void update(const Tilemap& tilemap);
+    // Multiply the lightmap over the frame with the camera's projection loaded
+    void draw();
+
+    void release();
+
+private:
+    static constexpr int VIEW_RADIUS = 16;          // Tiles the viewer sees in open space
+    static constexpr float EXPLORED_LEVEL = 0.35f;  // Brightness kept by tiles out of view
+
+    enum FogState : unsigned char {
+        FOG_UNSEEN = 0,
+        FOG_EXPLORED,
+        FOG_VISIBLE
+    };
+
+    // Half-open range of tiles
+    struct TileRect {
+        int left = 0, top = 0, right = 0, bottom = 0;
+
+        bool isEmpty() const { return left >= right || top >= bottom; }
+        bool overlaps(const TileRect& other) const;
+        void include(const TileRect& other);
+    };
+
+    struct Light {
+        bool active = false;
+        float worldX = 0.0f, worldY = 0.0f;
+        float radius = 0.0f;
+        float r = 0.0f, g = 0.0f, b = 0.0f;
+        bool stale = true;              // Patch needs recomputing whatever the tile
+        int tileX = 0, tileY = 0;       // Tile the patch was computed from
+        TileRect patch;                 // Tiles the light reaches
+        std::vector<float> intensity;   // One per tile of patch, row by row
+    };
+
+    bool enabled;
+    float ambient;
+    Light lights[MAX_LIGHTS];
+
+    bool hasViewer;
+    float viewerX, viewerY;
+    bool fogStale;
+    int viewerTileX, viewerTileY;  // Tile the fog was last cast from
+    TileRect viewRect;             // Tiles the last cast could reach
+    TileRect exploredRect;         // Bounds of every tile seen since the level started
+
+    int width, height;  // In tiles
+    int tileWidth, tileHeight;
+    unsigned int generation;  // Tilemap generation the grids were built from
+    size_t appliedEdits;      // Edited tiles already folded into solid
+    std::vector<unsigned char> solid;  // Collision layer, one byte per tile
+    std::vector<unsigned char> fog;    // FogState per tile
+    std::vector<int> visibleTiles;     // Tiles set to FOG_VISIBLE by the last cast
+    bool fillStale;                    // Whole texture needs the base fill before rebuilding
+    std::vector<TileRect> dirtyRects;  // Texels to rebuild on the next update, none overlapping
+
+    // Reused between updates
+    std::vector<int> pathCost;
+    std::vector<std::vector<int>> costBuckets;
+    std::vector<float> accumulated;
+    std::vector<unsigned char> texels;
+
+    GLuint texture;
+    GLuint quadBuffer;
+
+    void reset(const Tilemap& tilemap);
+    void applyEdits(const Tilemap& tilemap);
+    void markDirty(TileRect rect);
+    bool isSolid(int x, int y) const;
+    int toTileX(float worldX) const;
+    int toTileY(float worldY) const;
+
+    void propagate(Light& light);
+    void castFog();
+    void castOctant(int row, float startSlope, float endSlope, int xx, int xy, int yx, int yy);
+    void markVisible(int x, int y);
+    void fill();
+    void rebuild(const TileRect& rect);
+};
@@ -0,0 +1,146 @@
+#include "effects/ParticleRenderer.h"
+#include "effects/ParticleSystem.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include "render/TextureAtlas.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <string>
+
+ParticleRenderer::ParticleRenderer()
+    : InstancedQuadRenderer("particles"), cullMargin(0.0f), lastInstanceCount(0), lastDrawCallCount(0) {
+}
+
+bool ParticleRenderer::init() {
+#ifdef ORTOS_HAS_GL33
+    const std::vector<ParticleEmitterConfig>& configs = ParticleSystem::getEmitterConfigs();
+    if (configs.empty()) {
+        return false;
+    }
+
+    const std::string& shaderDirectory = RenderBackend::getShaderDirectory();
+    if (!shader.buildFromFiles(shaderDirectory + "particle_vertex_shader.glsl",
+                               shaderDirectory + "particle_fragment_shader.glsl")) {
+        return false;
+    }
+
+    // Emitter settings never change after loading, so they live in uniforms
+    shader.use();
+    glUniform1i(shader.getUniformLocation("atlas"), 0);
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const ParticleEmitterConfig& config = configs[i];
+        GLuint texture = 0;
+        AtlasRegion region;
+        if (config.image != INVALID_ATLAS_HANDLE) {
+            region = TextureAtlas::shared().getRegion(config.image);
+            texture = region.texture;
+        }
+
+        std::string index = "[" + std::to_string(i) + "]";
+        glUniform4f(shader.getUniformLocation(("cell" + index).c_str()), region.u1, region.v1, region.u2, region.v2);
+        glUniform3f(shader.getUniformLocation(("sizeDisc" + index).c_str()),
+                    config.startSize, config.endSize, texture == 0 ? 1.0f : 0.0f);
+        glUniform4fv(shader.getUniformLocation(("startColor" + index).c_str()), 1, config.startColor);
+        glUniform4fv(shader.getUniformLocation(("endColor" + index).c_str()), 1, config.endColor);
+
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const DrawGroup& existing) {
+            return existing.texture == texture && existing.additive == config.additive;
+        });
+        if (group == groups.end()) {
+            groups.push_back({texture, config.additive, 0, 0});
+            group = groups.end() - 1;
+        }
+        emitterGroups.push_back(static_cast<int>(group - groups.begin()));
+    }
+    cullMargin = ParticleSystem::getCullMargin();
+    spdlog::debug("Instanced particles sorted into {} draw groups", groups.size());
+
+    // Instance attributes are pointed at each group's range when drawing
+    createQuadArrays();
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ParticleRenderer::release() {
+    InstancedQuadRenderer::release();
+    groups.clear();
+    emitterGroups.clear();
+}
+
+void ParticleRenderer::setInstanceOffset(size_t first) {
+#ifdef ORTOS_HAS_GL33
+    // Without base-instance draws (GL 4.2) each group re-points the attributes
+    // at its slice of the buffer
+    const GLsizei stride = sizeof(ParticleInstance);
+    size_t base = first * sizeof(ParticleInstance);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(base + offsetof(ParticleInstance, x)));
+    glVertexAttribPointer(2, 1, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(base + offsetof(ParticleInstance, emitter)));
+#endif
+}
+
+void ParticleRenderer::draw(const ParticleSystem& particles, const ViewRect& cullRect) {
+    lastInstanceCount = 0;
+    lastDrawCallCount = 0;
+#ifdef ORTOS_HAS_GL33
+    if (!available) return;
+
+    ViewRect bounds = cullRect.expanded(cullMargin);
+    const float* x = particles.getX();
+    const float* y = particles.getY();
+    const float* age = particles.getAge();
+    const float* lifetime = particles.getLifetime();
+    const unsigned char* emitter = particles.getEmitter();
+
+    for (DrawGroup& group : groups) {
+        group.count = 0;
+    }
+    instances.clear();
+    for (int i = 0; i < particles.getCount(); ++i) {
+        if (!bounds.intersects(x[i], y[i], x[i], y[i])) continue;
+        ParticleInstance instance;
+        instance.x = x[i];
+        instance.y = y[i];
+        instance.life = age[i] / lifetime[i];
+        instance.emitter = emitter[i];
+        instance.padding[0] = instance.padding[1] = instance.padding[2] = 0;
+        instances.push_back(instance);
+        ++groups[emitterGroups[emitter[i]]].count;
+    }
+    lastInstanceCount = static_cast<int>(instances.size());
+    if (instances.empty()) return;
+
+    // Counting sort into one contiguous range per group
+    size_t offset = 0;
+    for (DrawGroup& group : groups) {
+        group.first = offset;
+        offset += group.count;
+        group.count = 0;
+    }
+    sortedInstances.resize(instances.size());
+    for (const ParticleInstance& instance : instances) {
+        DrawGroup& group = groups[emitterGroups[instance.emitter]];
+        sortedInstances[group.first + group.count++] = instance;
+    }
+
+    uploadInstances(sortedInstances.data(), sortedInstances.size(), sizeof(ParticleInstance));
+    beginDraw();
+    for (const DrawGroup& group : groups) {
+        if (group.count == 0) continue;
+        GLState::blendFunc(GL_SRC_ALPHA, group.additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+        GLState::bindTexture(group.texture);
+        setInstanceOffset(group.first);
+        drawInstances(static_cast<GLsizei>(group.count));
+        ++lastDrawCallCount;
+    }
+    endDraw();
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+#endif
+}
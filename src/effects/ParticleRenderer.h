@@ -0,0 +1,52 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <vector>
+#include "render/InstancedQuadRenderer.h"
+#include "render/ViewRect.h"
+
+class ParticleSystem;
+
+// Draws a ParticleSystem with one instanced call per atlas page and blend
+// mode. Each particle is uploaded as its position, normalised age and
+// emitter; the shader looks up the emitter's size, colour ramp and atlas cell
+// from uniform arrays. isAvailable() must come after the emitter configs are
+// loaded and the shared atlas is built.
+class ParticleRenderer : public InstancedQuadRenderer {
+public:
+    ParticleRenderer();
+
+    void draw(const ParticleSystem& particles, const ViewRect& cullRect);
+
+    int getLastInstanceCount() const { return lastInstanceCount; }
+    int getLastDrawCallCount() const { return lastDrawCallCount; }
+
+private:
+    struct ParticleInstance {
+        float x, y;             // Center in world units
+        float life;             // Age over lifetime, 0..1
+        unsigned char emitter;  // Index into the emitter configs
+        unsigned char padding[3];
+    };
+
+    // Emitters drawing from the same texture with the same blend mode
+    struct DrawGroup {
+        GLuint texture;  // 0 for discs
+        bool additive;
+        size_t first, count;
+    };
+
+    std::vector<DrawGroup> groups;
+    std::vector<int> emitterGroups;  // Group of each emitter config
+    std::vector<ParticleInstance> instances;
+    std::vector<ParticleInstance> sortedInstances;
+    float cullMargin;
+
+    int lastInstanceCount;
+    int lastDrawCallCount;
+
+    bool init() override;
+    void release() override;
+    void setInstanceOffset(size_t first);
+};
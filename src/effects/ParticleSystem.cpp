@@ -0,0 +1,253 @@
+#include "effects/ParticleSystem.h"
+#include "render/SpriteBatch.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+std::vector<ParticleEmitterConfig> ParticleSystem::configs;
+
+namespace {
+    constexpr float PI = 3.14159265358979f;
+
+    // Reads [min, max] or a single number into both
+    void readRange(const json& entry, const char* key, float& min, float& max) {
+        if (!entry.contains(key)) return;
+        const json& value = entry[key];
+        if (value.is_array() && value.size() == 2) {
+            min = value[0].get<float>();
+            max = value[1].get<float>();
+        } else if (value.is_number()) {
+            min = max = value.get<float>();
+        }
+    }
+
+    void readColor(const json& value, float color[4]) {
+        if (!value.is_array() || value.size() < 3) return;
+        for (size_t i = 0; i < 4 && i < value.size(); ++i) {
+            color[i] = value[i].get<float>();
+        }
+    }
+
+    float lerp(float a, float b, float t) {
+        return a + (b - a) * t;
+    }
+}
+
+ParticleSystem::ParticleSystem()
+    : x(MAX_PARTICLES), y(MAX_PARTICLES), velocityX(MAX_PARTICLES), velocityY(MAX_PARTICLES),
+      gravity(MAX_PARTICLES), drag(MAX_PARTICLES), age(MAX_PARTICLES), lifetime(MAX_PARTICLES),
+      emitter(MAX_PARTICLES), count(0), nextEmitterId(0), random(std::random_device{}()) {
+}
+
+bool ParticleSystem::loadEmitterConfigs(const std::string& filePath, const std::string& assetPath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        spdlog::error("Failed to open particle config: {}", filePath);
+        return false;
+    }
+
+    json j;
+    try {
+        file >> j;
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse particle config {}: {}", filePath, e.what());
+        return false;
+    }
+
+    configs.clear();
+    for (const auto& entry : j.value("emitters", json::array())) {
+        if (static_cast<int>(configs.size()) == MAX_EMITTER_CONFIGS) {
+            spdlog::warn("Particle config has more than {} emitters, ignoring the rest", MAX_EMITTER_CONFIGS);
+            break;
+        }
+
+        ParticleEmitterConfig config;
+        config.name = entry.value("name", std::string());
+        std::string image = entry.value("image", std::string());
+        if (!image.empty()) {
+            config.image = TextureAtlas::shared().addImage(assetPath + image);
+            if (config.image == INVALID_ATLAS_HANDLE) {
+                spdlog::warn("Particle emitter {} falls back to discs, image failed to load: {}", config.name, image);
+            }
+        }
+        config.additive = entry.value("blend", std::string("alpha")) == "additive";
+        config.burst = entry.value("burst", 0);
+        config.rate = entry.value("rate", 0.0f);
+        readRange(entry, "lifetime", config.minLifetime, config.maxLifetime);
+        readRange(entry, "speed", config.minSpeed, config.maxSpeed);
+        readRange(entry, "size", config.startSize, config.endSize);
+        config.direction = entry.value("direction", 0.0f);
+        config.spread = entry.value("spread", 360.0f);
+        config.radius = entry.value("radius", 0.0f);
+        config.gravity = entry.value("gravity", 0.0f);
+        config.drag = entry.value("drag", 0.0f);
+        if (entry.contains("color") && entry["color"].is_array() && entry["color"].size() == 2) {
+            readColor(entry["color"][0], config.startColor);
+            readColor(entry["color"][1], config.endColor);
+        }
+
+        // A zero lifetime would divide by zero when the age is normalised
+        config.minLifetime = std::max(config.minLifetime, 0.01f);
+        config.maxLifetime = std::max(config.maxLifetime, config.minLifetime);
+        configs.push_back(config);
+    }
+
+    spdlog::info("Loaded {} particle emitters from {}", configs.size(), filePath);
+    return !configs.empty();
+}
+
+int ParticleSystem::findEmitter(const std::string& name) {
+    for (size_t i = 0; i < configs.size(); ++i) {
+        if (configs[i].name == name) return static_cast<int>(i);
+    }
+    spdlog::warn("Unknown particle emitter: {}", name);
+    return -1;
+}
+
+float ParticleSystem::getCullMargin() {
+    float margin = 0.0f;
+    for (const ParticleEmitterConfig& config : configs) {
+        margin = std::max({margin, config.startSize * 0.5f, config.endSize * 0.5f});
+    }
+    return margin;
+}
+
+float ParticleSystem::randomRange(float min, float max) {
+    if (max <= min) return min;
+    return std::uniform_real_distribution<float>(min, max)(random);
+}
+
+void ParticleSystem::burst(int emitter, float x, float y) {
+    if (emitter < 0 || emitter >= static_cast<int>(configs.size())) return;
+    burst(emitter, x, y, configs[emitter].burst);
+}
+
+void ParticleSystem::burst(int emitter, float x, float y, int count) {
+    if (emitter < 0 || emitter >= static_cast<int>(configs.size())) return;
+    for (int i = 0; i < count; ++i) {
+        spawn(emitter, x, y);
+    }
+}
+
+int ParticleSystem::startEmitter(int emitter, float x, float y) {
+    if (emitter < 0 || emitter >= static_cast<int>(configs.size())) return -1;
+    int id = nextEmitterId++;
+    runningEmitters.push_back({id, emitter, x, y, 0.0f});
+    return id;
+}
+
+void ParticleSystem::stopEmitter(int id) {
+    runningEmitters.erase(
+        std::remove_if(runningEmitters.begin(), runningEmitters.end(),
+                       [id](const RunningEmitter& running) { return running.id == id; }),
+        runningEmitters.end());
+}
+
+void ParticleSystem::spawn(int config, float originX, float originY) {
+    // A full pool drops new particles rather than cutting old ones short
+    if (count == MAX_PARTICLES) return;
+
+    const ParticleEmitterConfig& settings = configs[config];
+    float angle = (settings.direction + randomRange(-0.5f, 0.5f) * settings.spread) * PI / 180.0f;
+    float speed = randomRange(settings.minSpeed, settings.maxSpeed);
+    float offsetAngle = randomRange(0.0f, 2.0f * PI);
+    float offset = settings.radius * std::sqrt(randomRange(0.0f, 1.0f));
+
+    int i = count++;
+    x[i] = originX + std::cos(offsetAngle) * offset;
+    y[i] = originY + std::sin(offsetAngle) * offset;
+    velocityX[i] = std::cos(angle) * speed;
+    velocityY[i] = std::sin(angle) * speed;
+    gravity[i] = settings.gravity;
+    drag[i] = settings.drag;
+    age[i] = 0.0f;
+    lifetime[i] = randomRange(settings.minLifetime, settings.maxLifetime);
+    emitter[i] = static_cast<unsigned char>(config);
+}
+
+void ParticleSystem::update(float deltaTime) {
+    for (RunningEmitter& running : runningEmitters) {
+        running.pending += configs[running.config].rate * deltaTime;
+        int spawnCount = static_cast<int>(running.pending);
+        running.pending -= spawnCount;
+        burst(running.config, running.x, running.y, spawnCount);
+    }
+
+    // Branch-free over the live range. The pointers are taken up front so
+    // the loops only see plain arrays.
+    int live = count;
+    float* px = x.data();
+    float* py = y.data();
+    float* vx = velocityX.data();
+    float* vy = velocityY.data();
+    const float* g = gravity.data();
+    const float* d = drag.data();
+    float* a = age.data();
+    for (int i = 0; i < live; ++i) {
+        float damping = 1.0f / (1.0f + d[i] * deltaTime);
+        vx[i] *= damping;
+        vy[i] = vy[i] * damping + g[i] * deltaTime;
+    }
+    for (int i = 0; i < live; ++i) {
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        a[i] += deltaTime;
+    }
+
+    // Retire expired particles by moving the last live one into their slot
+    int i = 0;
+    while (i < count) {
+        if (age[i] < lifetime[i]) {
+            ++i;
+            continue;
+        }
+        int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        velocityX[i] = velocityX[last];
+        velocityY[i] = velocityY[last];
+        gravity[i] = gravity[last];
+        drag[i] = drag[last];
+        age[i] = age[last];
+        lifetime[i] = lifetime[last];
+        emitter[i] = emitter[last];
+    }
+}
+
+void ParticleSystem::clear() {
+    count = 0;
+    runningEmitters.clear();
+}
+
+void ParticleSystem::draw(SpriteBatch& batch) const {
+    for (int i = 0; i < count; ++i) {
+        const ParticleEmitterConfig& config = configs[emitter[i]];
+        float t = age[i] / lifetime[i];
+        float size = lerp(config.startSize, config.endSize, t);
+
+        Sprite sprite;
+        if (config.image != INVALID_ATLAS_HANDLE) {
+            const AtlasRegion& region = TextureAtlas::shared().getRegion(config.image);
+            sprite.texture = region.texture;
+            sprite.u1 = region.u1; sprite.v1 = region.v1;
+            sprite.u2 = region.u2; sprite.v2 = region.v2;
+        } else {
+            sprite.texture = batch.getCircleTexture();
+        }
+        sprite.x = x[i] - size * 0.5f;
+        sprite.y = y[i] - size * 0.5f;
+        sprite.width = size;
+        sprite.height = size;
+        sprite.r = lerp(config.startColor[0], config.endColor[0], t);
+        sprite.g = lerp(config.startColor[1], config.endColor[1], t);
+        sprite.b = lerp(config.startColor[2], config.endColor[2], t);
+        sprite.a = lerp(config.startColor[3], config.endColor[3], t);
+        sprite.layer = SpriteLayer::Effect;
+        sprite.blend = config.additive ? BlendMode::Additive : BlendMode::Alpha;
+        batch.submit(sprite);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "render/TextureAtlas.h"
+
+class SpriteBatch;
+
+// How an emitter spawns particles and how they look over their life. Colour
+// and size run linearly from their start to their end value.
+struct ParticleEmitterConfig {
+    std::string name;
+    AtlasHandle image = INVALID_ATLAS_HANDLE;  // Invalid draws a soft disc
+    bool additive = false;
+    int burst = 0;                 // Particles per burst() call
+    float rate = 0.0f;             // Particles per second while a started emitter runs
+    float minLifetime = 0.5f, maxLifetime = 0.5f;
+    float minSpeed = 0.0f, maxSpeed = 0.0f;
+    float direction = 0.0f;        // Degrees, 0 is right and 90 is down
+    float spread = 360.0f;         // Degrees around direction
+    float radius = 0.0f;           // Particles start anywhere within this of the emitter
+    float gravity = 0.0f;          // World units per second squared, down
+    float drag = 0.0f;             // Fraction of speed lost per second, roughly
+    float startSize = 4.0f, endSize = 4.0f;
+    float startColor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float endColor[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+};
+
+// Fixed-capacity pool of small, short-lived particles such as hit sparks and
+// blood sprays. Particles are kept as separate arrays per attribute, so the
+// update is a few straight loops over floats the compiler can vectorise.
+// Dead particles are swapped with the last live one, keeping the live range
+// packed at the front.
+class ParticleSystem {
+public:
+    static constexpr int MAX_PARTICLES = 8192;
+    static constexpr int MAX_EMITTER_CONFIGS = 16;  // Emitter indices fit in a byte and a uniform array
+
+    ParticleSystem();
+
+    // Read emitter definitions from a JSON file. Images they name are added
+    // to the shared atlas, so this has to run before the atlas is built.
+    static bool loadEmitterConfigs(const std::string& filePath, const std::string& assetPath);
+    // Index of the emitter called name, or -1 if there is none
+    static int findEmitter(const std::string& name);
+    static const std::vector<ParticleEmitterConfig>& getEmitterConfigs() { return configs; }
+
+    // Spawn the emitter's burst count at (x, y). Does nothing for -1.
+    void burst(int emitter, float x, float y);
+    void burst(int emitter, float x, float y, int count);
+
+    // Continuous emitters spawn at their rate until stopped. Returns an id
+    // for stopEmitter(), or -1 if emitter is -1.
+    int startEmitter(int emitter, float x, float y);
+    void stopEmitter(int id);
+
+    void update(float deltaTime);
+    void clear();
+
+    // Fallback for contexts without instancing; queues one sprite per live
+    // particle on the effect layer
+    void draw(SpriteBatch& batch) const;
+
+    int getCount() const { return count; }
+    // Read-only views used by ParticleRenderer
+    const float* getX() const { return x.data(); }
+    const float* getY() const { return y.data(); }
+    const float* getAge() const { return age.data(); }
+    const float* getLifetime() const { return lifetime.data(); }
+    const unsigned char* getEmitter() const { return emitter.data(); }
+
+    // Half the largest particle, for padding cull rects
+    static float getCullMargin();
+
+private:
+    struct RunningEmitter {
+        int id;
+        int config;
+        float x, y;
+        float pending;  // Fractional particles carried to the next update
+    };
+
+    static std::vector<ParticleEmitterConfig> configs;
+
+    // Particle attributes, MAX_PARTICLES long; only [0, count) is live
+    std::vector<float> x, y;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> gravity, drag;
+    std::vector<float> age, lifetime;
+    std::vector<unsigned char> emitter;
+    int count;
+
+    std::vector<RunningEmitter> runningEmitters;
+    int nextEmitterId;
+    std::mt19937 random;
+
+    void spawn(int config, float originX, float originY);
+    float randomRange(float min, float max);
+};
@@ -3,8 +3,11 @@
 #include "projectile/Projectile.h"
 #include "map/TileMap.h"
 #include "ui/UI.h"
+#include "render/DebugDraw.h"
+#include "render/SpriteBatch.h"
+#include "render/TextureCache.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
 #include <spdlog/spdlog.h>
 #include <cmath>
 #include <random>
@@ -63,37 +66,30 @@ Enemy::Enemy(float x, float y, EnemyType type)
 }
 
 Enemy::~Enemy() {
-    if (textureID != 0) {
-        glDeleteTextures(1, &textureID);
-    }
-    if (hitTextureID != 0) {
-        glDeleteTextures(1, &hitTextureID);
-    }
+    // Textures are shared through the TextureCache and released with the handles
 }
 
-void Enemy::draw() const {
+void Enemy::draw(SpriteBatch& batch, SpriteBatch* emissive) const {
     // Draw death animation if dying or dead
     if (state == EnemyState::Dying || state == EnemyState::Dead) {
         if (deathTextureID == 0) return;
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, deathTextureID);
         int framesPerRow = deathTextureWidth / deathFrameWidth;
         int row = 0;
         int col = deathCurrentFrame % framesPerRow;
-        float u1 = static_cast<float>(col * deathFrameWidth) / deathTextureWidth;
-        float v1 = static_cast<float>(row * deathFrameHeight) / deathTextureHeight;
-        float u2 = static_cast<float>((col + 1) * deathFrameWidth) / deathTextureWidth;
-        float v2 = static_cast<float>((row + 1) * deathFrameHeight) / deathTextureHeight;
-        if (!facingRight) { float temp = u1; u1 = u2; u2 = temp; }
-        float drawX = x - deathFrameWidth / 2.0f;
-        float drawY = y - deathFrameHeight / 2.0f;
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(drawX, drawY);
-        glTexCoord2f(u2, v2); glVertex2f(drawX + deathFrameWidth, drawY);
-        glTexCoord2f(u2, v1); glVertex2f(drawX + deathFrameWidth, drawY + deathFrameHeight);
-        glTexCoord2f(u1, v1); glVertex2f(drawX, drawY + deathFrameHeight);
-        glEnd();
-        glDisable(GL_TEXTURE_2D);
+        Sprite sprite;
+        sprite.texture = deathTextureID;
+        sprite.x = x - deathFrameWidth / 2.0f;
+        sprite.y = y - deathFrameHeight / 2.0f;
+        sprite.width = static_cast<float>(deathFrameWidth);
+        sprite.height = static_cast<float>(deathFrameHeight);
+        sprite.u1 = static_cast<float>(col * deathFrameWidth) / deathTextureWidth;
+        sprite.v1 = static_cast<float>((row + 1) * deathFrameHeight) / deathTextureHeight;
+        sprite.u2 = static_cast<float>((col + 1) * deathFrameWidth) / deathTextureWidth;
+        sprite.v2 = static_cast<float>(row * deathFrameHeight) / deathTextureHeight;
+        sprite.flipX = !facingRight;
+        sprite.layer = SpriteLayer::Entity;
+        sprite.depth = y;
+        batch.submit(sprite);
         return;
     }
     if (!alive) return;
@@ -105,8 +101,6 @@ void Enemy::draw() const {
     // If no texture is available, don't draw
     if (currentTextureID == 0) return;
 
-    glEnable(GL_TEXTURE_2D);
-    
     // Choose which texture properties to use
     int currentFrameWidth = useHitTexture ? hitFrameWidth : frameWidth;
     int currentFrameHeight = useHitTexture ? hitFrameHeight : frameHeight;
@@ -127,8 +121,6 @@ void Enemy::draw() const {
         currentFrameIndex = currentFrame;
     }
     
-    glBindTexture(GL_TEXTURE_2D, currentTextureID);
-
     // Calculate texture coordinates for current frame
     int framesPerRow = currentTextureWidth / currentFrameWidth;
     int row, col;
@@ -143,85 +135,61 @@ void Enemy::draw() const {
         col = currentFrameIndex % framesPerRow;
     }
 
-    float u1 = static_cast<float>(col * currentFrameWidth) / currentTextureWidth;
-    float v1 = static_cast<float>(row * currentFrameHeight) / currentTextureHeight;
-    float u2 = static_cast<float>((col + 1) * currentFrameWidth) / currentTextureWidth;
-    float v2 = static_cast<float>((row + 1) * currentFrameHeight) / currentTextureHeight;
-
-    // Flip texture coordinates if facing left
-    if (!facingRight) {
-        float temp = u1;
-        u1 = u2;
-        u2 = temp;
+    // Draw enemy centered on tile; flip texture coordinates if facing left
+    Sprite sprite;
+    sprite.texture = currentTextureID;
+    sprite.x = x - currentFrameWidth / 2.0f;
+    sprite.y = y - currentFrameHeight / 2.0f;
+    sprite.width = static_cast<float>(currentFrameWidth);
+    sprite.height = static_cast<float>(currentFrameHeight);
+    sprite.u1 = static_cast<float>(col * currentFrameWidth) / currentTextureWidth;
+    sprite.v1 = static_cast<float>((row + 1) * currentFrameHeight) / currentTextureHeight;
+    sprite.u2 = static_cast<float>((col + 1) * currentFrameWidth) / currentTextureWidth;
+    sprite.v2 = static_cast<float>(row * currentFrameHeight) / currentTextureHeight;
+    sprite.flipX = !facingRight;
+    sprite.layer = SpriteLayer::Entity;
+    sprite.depth = y;
+
+    batch.submit(sprite);
+
+    // Flying eyes (purple) and shrooms (green) glow; the bloom pass spreads
+    // this copy into a halo
+    float glowR, glowG, glowB, glowA;
+    if (emissive && getEmissiveColor(type, glowR, glowG, glowB, glowA)) {
+        sprite.r = glowR; sprite.g = glowG; sprite.b = glowB; sprite.a = glowA;
+        emissive->submit(sprite);
     }
+}
 
-    // Draw enemy centered on tile
-    float drawX = x - currentFrameWidth / 2.0f;
-    float drawY = y - currentFrameHeight / 2.0f;
-
-    // Special effect for flying eye
-    if (type == EnemyType::FlyingEye) {
-        // Add a subtle glow effect
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        glColor4f(0.8f, 0.4f, 1.0f, 0.3f); // Purple glow
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(drawX - 2, drawY - 2);
-        glTexCoord2f(u2, v2); glVertex2f(drawX + currentFrameWidth + 2, drawY - 2);
-        glTexCoord2f(u2, v1); glVertex2f(drawX + currentFrameWidth + 2, drawY + currentFrameHeight + 2);
-        glTexCoord2f(u1, v1); glVertex2f(drawX - 2, drawY + currentFrameHeight + 2);
-        glEnd();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
-    }
-    
-    // Special effect for shroom
-    if (type == EnemyType::Shroom) {
-        // Add a green glow effect
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        glColor4f(0.2f, 0.8f, 0.3f, 0.4f); // Green glow
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(drawX - 3, drawY - 3);
-        glTexCoord2f(u2, v2); glVertex2f(drawX + currentFrameWidth + 3, drawY - 3);
-        glTexCoord2f(u2, v1); glVertex2f(drawX + currentFrameWidth + 3, drawY + currentFrameHeight + 3);
-        glTexCoord2f(u1, v1); glVertex2f(drawX - 3, drawY + currentFrameHeight + 3);
-        glEnd();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
+bool Enemy::getEmissiveColor(EnemyType type, float& r, float& g, float& b, float& a) {
+    switch (type) {
+        case EnemyType::FlyingEye:
+            r = 0.8f; g = 0.4f; b = 1.0f; a = 0.6f;
+            return true;
+        case EnemyType::Shroom:
+            r = 0.2f; g = 0.8f; b = 0.3f; a = 0.7f;
+            return true;
+        default:
+            return false;
     }
+}
 
-    glBegin(GL_QUADS);
-    glTexCoord2f(u1, v2); glVertex2f(drawX, drawY);
-    glTexCoord2f(u2, v2); glVertex2f(drawX + currentFrameWidth, drawY);
-    glTexCoord2f(u2, v1); glVertex2f(drawX + currentFrameWidth, drawY + currentFrameHeight);
-    glTexCoord2f(u1, v1); glVertex2f(drawX, drawY + currentFrameHeight);
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
+void Enemy::drawOverlay() const {
+    if (!alive || state == EnemyState::Dying || state == EnemyState::Dead) return;
 
     // Draw health bar right above enemy hitbox
     UI::drawEnemyHealthBar(x, getTop() - 3.0f, currentHealth, maxHealth);
 
-    // Draw collision rectangle (bounding box) in different colors for different enemy types
-    glLineWidth(2.0f);
-    glDisable(GL_BLEND);
+    if (!DebugDraw::isEnabled(DebugCategory::Hitboxes)) return;
+
+    // Collision rectangle (bounding box) in different colors for different enemy types
+    unsigned char r = 0, g = 0, b = 255; // Blue for other enemies
     if (type == EnemyType::FlyingEye) {
-        glColor3f(1.0f, 0.0f, 1.0f); // Magenta for flying eye
+        r = 255; g = 0; b = 255; // Magenta for flying eye
     } else if (type == EnemyType::Shroom) {
-        glColor3f(0.0f, 1.0f, 0.0f); // Green for shroom
-    } else {
-        glColor3f(0.0f, 0.0f, 1.0f); // Blue for other enemies
+        r = 0; g = 255; b = 0; // Green for shroom
     }
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(getLeft(), getTop());
-    glVertex2f(getRight(), getTop());
-    glVertex2f(getRight(), getBottom());
-    glVertex2f(getLeft(), getBottom());
-    glEnd();
-    glEnable(GL_BLEND);
-    glLineWidth(1.0f);
-    glColor3f(1.0f, 1.0f, 1.0f); // Reset color to white
+    DebugDraw::rect(DebugCategory::Hitboxes, getLeft(), getTop(), getRight(), getBottom(), r, g, b, 255, 2.0f);
 }
 
 void Enemy::loadTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames) {
@@ -229,36 +197,19 @@ void Enemy::loadTexture(const std::string& filePath, int frameWidth, int frameHe
     this->frameHeight = frameHeight;
     this->totalFrames = totalFrames;
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    // Sheets are shared by every enemy of a type, so respawns reuse the cached texture.
+    // Rows are stored bottom-up, which is what the draw code's UVs expect.
+    TextureLoadOptions options;
+    options.flipVertically = true;
+    texture = TextureCache::shared().load(filePath, options);
+    if (!texture) {
         spdlog::error("Failed to load enemy texture: {}", filePath);
         return;
     }
 
-    spdlog::info("Loaded enemy texture: {} ({}x{})", filePath, width, height);
-
-    textureWidth = width;
-    textureHeight = height;
-
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    // Use NEAREST filtering for pixel-perfect graphics
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-
-    spdlog::debug("Enemy texture loaded successfully with ID: {}", textureID);
+    textureID = texture->getID();
+    textureWidth = texture->getWidth();
+    textureHeight = texture->getHeight();
 }
 
 void Enemy::loadHitTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames) {
@@ -266,36 +217,17 @@ void Enemy::loadHitTexture(const std::string& filePath, int frameWidth, int fram
     this->hitFrameHeight = frameHeight;
     this->hitTotalFrames = totalFrames;
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    TextureLoadOptions options;
+    options.flipVertically = true;
+    hitTexture = TextureCache::shared().load(filePath, options);
+    if (!hitTexture) {
         spdlog::error("Failed to load enemy hit texture: {}", filePath);
         return;
     }
 
-    spdlog::info("Loaded enemy hit texture: {} ({}x{})", filePath, width, height);
-
-    hitTextureWidth = width;
-    hitTextureHeight = height;
-
-    glGenTextures(1, &hitTextureID);
-    glBindTexture(GL_TEXTURE_2D, hitTextureID);
-
-    // Use NEAREST filtering for pixel-perfect graphics
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-
-    spdlog::debug("Enemy hit texture loaded successfully with ID: {}", hitTextureID);
+    hitTextureID = hitTexture->getID();
+    hitTextureWidth = hitTexture->getWidth();
+    hitTextureHeight = hitTexture->getHeight();
 }
 
 void Enemy::loadDeathTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames) {
@@ -303,35 +235,17 @@ void Enemy::loadDeathTexture(const std::string& filePath, int frameWidth, int fr
     this->deathFrameHeight = frameHeight;
     this->deathTotalFrames = totalFrames;
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    TextureLoadOptions options;
+    options.flipVertically = true;
+    deathTexture = TextureCache::shared().load(filePath, options);
+    if (!deathTexture) {
         spdlog::error("Failed to load enemy death texture: {}", filePath);
         return;
     }
 
-    spdlog::info("Loaded enemy death texture: {} ({}x{})", filePath, width, height);
-
-    deathTextureWidth = width;
-    deathTextureHeight = height;
-
-    glGenTextures(1, &deathTextureID);
-    glBindTexture(GL_TEXTURE_2D, deathTextureID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-
-    spdlog::debug("Enemy death texture loaded successfully with ID: {}", deathTextureID);
+    deathTextureID = deathTexture->getID();
+    deathTextureWidth = deathTexture->getWidth();
+    deathTextureHeight = deathTexture->getHeight();
 }
 
 void Enemy::updateAnimation(float deltaTime) {
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <random>
+#include "render/TextureCache.h"
 
 enum class EnemyType {
     Skeleton,
@@ -22,13 +23,16 @@ enum class EnemyState {
 
 class Projectile;  // Forward declaration
 class BloodEffect;  // Forward declaration
+class SpriteBatch;
 
 class Enemy {
 public:
     Enemy(float x, float y, EnemyType type = EnemyType::Skeleton);
     ~Enemy();
 
-    void draw() const;
+    // Glowing enemy types also submit a tinted copy to the emissive batch
+    void draw(SpriteBatch& batch, SpriteBatch* emissive = nullptr) const;
+    void drawOverlay() const;  // Health bar, plus the bounding box when hitboxes are shown
     void loadTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames);
     void loadHitTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames);
     void updateAnimation(float deltaTime);
@@ -48,9 +52,13 @@ public:
     float getBottom() const { return y - boundingBoxOffsetY + boundingBoxHeight; }
     float getBoundingBoxWidth() const { return boundingBoxWidth; }
     float getBoundingBoxHeight() const { return boundingBoxHeight; }
+    float getChaseRadius() const { return chaseRadius; }
+    float getShootRange() const { return shootRange; }
     
     // Enemy type and state
     EnemyType getType() const { return type; }
+    // Glow color of a type, false if it doesn't glow
+    static bool getEmissiveColor(EnemyType type, float& r, float& g, float& b, float& a);
     EnemyState getState() const { return state; }
     bool isAlive() const { return alive; }
     void setAlive(bool isAlive) { alive = isAlive; }
@@ -75,6 +83,7 @@ private:
     float boundingBoxOffsetX = 8.0f;
     float boundingBoxOffsetY = 8.0f;
     
+    TextureHandle texture;
     unsigned int textureID;
     int frameWidth, frameHeight;
     int textureWidth, textureHeight;
@@ -83,6 +92,7 @@ private:
     int currentFrame;
     
     // Hit animation properties
+    TextureHandle hitTexture;
     unsigned int hitTextureID = 0;
     int hitFrameWidth = 0, hitFrameHeight = 0;
     int hitTextureWidth = 0, hitTextureHeight = 0;
@@ -133,6 +143,7 @@ private:
     float lastMoveX = 0.0f;
 
     // Death animation properties
+    TextureHandle deathTexture;
     unsigned int deathTextureID = 0;
     int deathFrameWidth = 0, deathFrameHeight = 0;
     int deathTextureWidth = 0, deathTextureHeight = 0;
@@ -1,8 +1,15 @@
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <AL/al.h>
 #include "player/Player.h"
 #include "enemy/Enemy.h"
 #include "projectile/Projectile.h"
+#include "render/GLState.h"
+#include "render/GpuProfiler.h"
+#include "render/RenderBackend.h"
+#include "render/TextureAtlas.h"
+#include "render/TextureCache.h"
+#include "render/TextureStreamer.h"
 #include "effects/BloodEffect.h"
 #include "audio/AudioManager.h"
 #include "audio/UIAudioManager.h"
@@ -54,6 +61,14 @@ int main() {
     // Initialize config manager for settings
     ConfigManager configManager;
     configManager.initialize(initializer.getAssetPath("config/game_config.cfg"));
+
+    // Pick the renderer before anything uploads geometry through it
+    RenderBackend::select(RenderBackend::parseType(configManager.getString("render_backend", "gl33"),
+                                                   RenderBackendType::GL33),
+                          initializer.getAssetPath("shaders/"));
+    if (configManager.getBool("gpu_profiler", false) && GpuProfiler::shared().init()) {
+        GpuProfiler::shared().setEnabled(true);
+    }
     
     // Initialize gameplay manager
     GameplayManager gameplayManager;
@@ -74,12 +89,27 @@ int main() {
     int windowHeight = 1080;
 
     float lastTime = glfwGetTime();
+    float statsTimer = 0.0f;
 
     while (!glfwWindowShouldClose(window)) {
         float currentTime = glfwGetTime();
         float deltaTime = currentTime - lastTime;
         lastTime = currentTime;
 
+        GLState::beginFrame();
+        GpuProfiler::shared().beginFrame();
+        TextureStreamer::shared().update();
+        statsTimer += deltaTime;
+        if (statsTimer >= 5.0f) {
+            statsTimer = 0.0f;
+            const GLState::FrameStats& stats = GLState::getLastFrameStats();
+            spdlog::debug("GL frame: {} draws, {} texture binds, {} framebuffer binds, {} state changes, {} redundant calls skipped",
+                          stats.drawCalls, stats.textureBinds, stats.framebufferBinds, stats.stateChanges, stats.redundantSkipped);
+            for (const GpuProfiler::PassStats& pass : GpuProfiler::shared().getStats()) {
+                spdlog::debug("GPU {}: {:.3f} ms avg, {:.3f} ms max", pass.name, pass.averageMs, pass.maxMs);
+            }
+        }
+
         glClear(GL_COLOR_BUFFER_BIT);
 
         // Update game state manager
@@ -100,6 +130,17 @@ int main() {
     // Cleanup projectile texture
     Projectile::cleanupProjectileTexture();
 
+    // Release the atlas pages while the GL context is still alive
+    TextureAtlas::shared().cleanup();
+    TextureStreamer::shared().shutdown();
+    TextureCache::shared().clear();
+    std::string profilePath = configManager.getString("gpu_profile_export", "");
+    if (GpuProfiler::shared().isEnabled() && !profilePath.empty()) {
+        GpuProfiler::shared().exportTimeline(profilePath);
+    }
+    GpuProfiler::shared().release();
+    RenderBackend::shutdown();
+
     spdlog::info("Shutting down Ortos II application");
     // GameInitializer will handle cleanup in its destructor
     return 0;
@@ -1,57 +1,72 @@
 #include "map/TileMap.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include "render/TextureCache.h"
 #include <fstream>
 #include <sstream>
-#include <stb_image.h>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "external/tinyxml2.h"
+#include <stb_image.h>
 #include <spdlog/spdlog.h>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 using json = nlohmann::json;
 
-Tilemap::Tilemap() : textureID(0), tileWidth(0), tileHeight(0), 
+namespace {
+    unsigned int lastGeneration = 0;
+}
+
+Tilemap::Tilemap() : tileWidth(0), tileHeight(0),
                     width(0), height(0) {}
 
 Tilemap::~Tilemap() {
-    if (textureID) {
-        glDeleteTextures(1, &textureID);
-    }
+    releaseChunkBuffers();
+    releaseTileIndexTextures();
 }
 
-bool Tilemap::loadTilesetTexture(const std::string& imagePath, int tileW, int tileH) {
-    this->tileWidth = tileW;
-    this->tileHeight = tileH;
+void Tilemap::update(float deltaTime) {
+    animationTime += deltaTime;
+}
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
-        spdlog::error("Failed to load tileset texture: {}", imagePath);
+bool Tilemap::loadFromJSON(const std::string& jsonPath) {
+    Tilemap loaded;
+    if (!loaded.load(jsonPath)) {
         return false;
     }
-    spdlog::info("Loaded tileset texture: {} ({}x{})", imagePath, width, height);
-
-    textureWidth = width;
-    textureHeight = height;
-
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGBA;
-    if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    
+    loaded.generation = ++lastGeneration;
+    swap(loaded);
+    // loaded now holds the previous map and frees its GPU resources
     return true;
 }
 
-bool Tilemap::loadFromJSON(const std::string& jsonPath) {
+void Tilemap::swap(Tilemap& other) {
+    std::swap(tileWidth, other.tileWidth);
+    std::swap(tileHeight, other.tileHeight);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(generation, other.generation);
+    std::swap(editedTiles, other.editedTiles);
+    std::swap(tilesets, other.tilesets);
+    std::swap(useTileArray, other.useTileArray);
+    tileArray.swap(other.tileArray);
+    std::swap(gidArrayLayers, other.gidArrayLayers);
+    std::swap(usedArrayLayers, other.usedArrayLayers);
+    std::swap(useTileIndex, other.useTileIndex);
+    std::swap(animationTexture, other.animationTexture);
+    std::swap(gidAnimations, other.gidAnimations);
+    std::swap(animationFrames, other.animationFrames);
+    std::swap(animationTime, other.animationTime);
+    std::swap(layerCount, other.layerCount);
+    std::swap(chunksX, other.chunksX);
+    std::swap(chunksY, other.chunksY);
+    std::swap(chunks, other.chunks);
+    std::swap(residentChunks, other.residentChunks);
+}
+
+bool Tilemap::load(const std::string& jsonPath) {
     std::ifstream file(jsonPath);
     if (!file.is_open()) {
         spdlog::error("ERROR: Failed to open JSON file: {}", jsonPath);
@@ -67,29 +82,68 @@ bool Tilemap::loadFromJSON(const std::string& jsonPath) {
         return false;
     }
 
-    // Load tileset - resolve path relative to the JSON file's directory
-    std::filesystem::path jsonDir = std::filesystem::path(jsonPath).parent_path();
-    std::string resolvedPath = (jsonDir / "catacombs.tsx").string();
-    if (!loadTilesetFromTSX(resolvedPath)) {
-        spdlog::error("ERROR: Failed to load tileset: {}", resolvedPath);
-        return false;
-    }
-
     // Store map dimensions
     width = j["width"];
     height = j["height"];
     tileWidth = j["tilewidth"];
     tileHeight = j["tileheight"];
 
-    // Clear existing layers and collision data
-    layers.clear();
-    collisionLayer.clear();
+    // Tilesets are either external .tsx files or embedded in the map; paths
+    // are relative to the JSON file's directory
+    std::filesystem::path jsonDir = std::filesystem::path(jsonPath).parent_path();
+    for (const auto& entry : j.value("tilesets", json::array())) {
+        int firstGid = entry.value("firstgid", 1);
+        if (entry.contains("source")) {
+            std::string resolvedPath = (jsonDir / entry["source"].get<std::string>()).string();
+            if (!loadTilesetFromTSX(resolvedPath, firstGid)) {
+                spdlog::error("ERROR: Failed to load tileset: {}", resolvedPath);
+                return false;
+            }
+            continue;
+        }
+
+        Tileset tileset;
+        tileset.firstGid = firstGid;
+        tileset.tileCount = entry.value("tilecount", 0);
+        tileset.columns = entry.value("columns", 0);
+        tileset.margin = entry.value("margin", 0);
+        tileset.spacing = entry.value("spacing", 0);
+        tileset.imagePath = (jsonDir / entry.value("image", std::string())).string();
+        for (const auto& tile : entry.value("tiles", json::array())) {
+            if (!tile.contains("animation")) continue;
+            TileAnimation animation{tile.value("id", 0), {}};
+            for (const auto& frame : tile["animation"]) {
+                animation.frames.emplace_back(frame.value("tileid", 0), frame.value("duration", 0));
+            }
+            tileset.animations.push_back(std::move(animation));
+        }
+        if (!addTileset(tileset, entry.value("tilewidth", 0), entry.value("tileheight", 0))) {
+            spdlog::error("ERROR: Failed to load embedded tileset {}", entry.value("name", std::string()));
+            return false;
+        }
+    }
+    if (tilesets.empty()) {
+        spdlog::error("ERROR: Map {} has no tilesets", jsonPath);
+        return false;
+    }
+
+    // Count drawable layers up front so chunk storage can be sized once
+    layerCount = 0;
+    for (const auto& layer : j["layers"]) {
+        if (!layer.contains("data")) continue;
+        if (layer["id"] == 3) continue;
+        if (layer["type"] == "tilelayer") ++layerCount;
+    }
+
+    // Allocate the chunk grid
+    chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunks.resize(static_cast<size_t>(chunksX) * chunksY);
 
     // Process each layer
+    int layerIndex = 0;
     for (const auto& layer : j["layers"]) {
-        std::string layerName = layer["name"];
         std::string layerType = layer["type"];
-        bool visible = layer["visible"];
         int layerId = layer["id"];
 
         if (!layer.contains("data")) {
@@ -97,93 +151,637 @@ bool Tilemap::loadFromJSON(const std::string& jsonPath) {
         }
 
         const auto& data = layer["data"];
+        bool isCollision = (layerId == 3);
+        if (!isCollision && layerType != "tilelayer") {
+            continue;
+        }
 
-        // Handle collision layer
-        if (layerId == 3) {
-            collisionLayer.resize(height, std::vector<int>(width, 0));
-            for (int y = 0; y < height; ++y) {
-                for (int x = 0; x < width; ++x) {
-                    int index = y * width + x;
-                    if (index < data.size()) {
-                        // Mask out Tiled flip flags
-                        collisionLayer[y][x] = static_cast<int>(data[index]) & 0x1FFFFFFF;
-                    }
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                size_t index = static_cast<size_t>(y) * width + x;
+                if (index >= data.size()) continue;
+
+                // Mask out Tiled flip flags
+                int gid = static_cast<int>(data[index]) & 0x1FFFFFFF;
+                if (gid == 0) continue;
+
+                // Only chunks that actually contain tiles get storage
+                TileChunk* chunk = getChunkForTile(x, y);
+                if (isCollision) {
+                    if (chunk->collision.empty()) chunk->collision.resize(CHUNK_SIZE * CHUNK_SIZE, 0);
+                    chunk->collision[getLocalIndex(x, y)] = gid;
+                } else {
+                    if (chunk->tiles.empty()) chunk->tiles.resize(static_cast<size_t>(layerCount) * CHUNK_SIZE * CHUNK_SIZE, 0);
+                    chunk->tiles[layerIndex * CHUNK_SIZE * CHUNK_SIZE + getLocalIndex(x, y)] = gid;
                 }
             }
-            continue;
         }
 
-        // Handle visible tile layers
-        if (layerType == "tilelayer") {
-            layers.emplace_back();
-            auto& currentLayer = layers.back();
-            currentLayer.resize(height, std::vector<int>(width, 0));
+        if (!isCollision) {
+            ++layerIndex;
+        }
+    }
 
-            for (int y = 0; y < height; ++y) {
-                for (int x = 0; x < width; ++x) {
-                    int index = y * width + x;
-                    if (index < data.size()) {
-                        // Mask out Tiled flip flags
-                        currentLayer[y][x] = static_cast<int>(data[index]) & 0x1FFFFFFF;
-                    }
-                }
+    // Only the tiles the map actually draws go into the array, which keeps
+    // large tilesets under the layer limit
+    std::vector<int> usedGids;
+    std::vector<bool> seen;
+    for (const TileChunk& chunk : chunks) {
+        for (int gid : chunk.tiles) {
+            if (gid == 0) continue;
+            if (static_cast<size_t>(gid) >= seen.size()) seen.resize(gid + 1, false);
+            if (seen[gid]) continue;
+            seen[gid] = true;
+            usedGids.push_back(gid);
+        }
+    }
+
+    appendAnimationFrames(usedGids);
+
+    useTileArray = RenderBackend::current().supportsTextureArrays() && createTileArray(usedGids);
+    if (!useTileArray && !loadTilesetTextures()) {
+        return false;
+    }
+    useTileIndex = useTileArray && setupTileIndex(usedGids);
+
+    spdlog::info("Map loaded: {}x{} tiles, tile size: {}x{}, {} layers in {}x{} chunks, {} tilesets ({})",
+                 width, height, tileWidth, tileHeight, layerCount, chunksX, chunksY, tilesets.size(),
+                 useTileArray ? fmt::format("{} tiles in a texture array, {} animated, drawn {}",
+                                            usedArrayLayers, animationFrames.size(),
+                                            useTileIndex ? "from chunk index textures" : "as chunk geometry")
+                              : "separate textures");
+    return true;
+}
+
+bool Tilemap::addTileset(const Tileset& tileset, int tilesetTileWidth, int tilesetTileHeight) {
+    // Array layers all have one size, and chunks lay tiles out on the map grid
+    if (tilesetTileWidth != tileWidth || tilesetTileHeight != tileHeight) {
+        spdlog::error("Tileset {} has {}x{} tiles, the map uses {}x{}",
+                      tileset.imagePath, tilesetTileWidth, tilesetTileHeight, tileWidth, tileHeight);
+        return false;
+    }
+    if (tileset.tileCount <= 0 || tileset.columns <= 0) {
+        spdlog::error("Tileset {} doesn't give its tile count and columns", tileset.imagePath);
+        return false;
+    }
+
+    auto position = std::upper_bound(tilesets.begin(), tilesets.end(), tileset.firstGid,
+                                     [](int gid, const Tileset& other) { return gid < other.firstGid; });
+    tilesets.insert(position, tileset);
+    return true;
+}
+
+int Tilemap::findTileset(int gid) const {
+    // The last tileset starting at or before gid, if gid is within its range
+    auto position = std::upper_bound(tilesets.begin(), tilesets.end(), gid,
+                                     [](int value, const Tileset& tileset) { return value < tileset.firstGid; });
+    if (position == tilesets.begin()) return -1;
+    --position;
+    if (gid >= position->firstGid + position->tileCount) return -1;
+    return static_cast<int>(position - tilesets.begin());
+}
+
+bool Tilemap::createTileArray(const std::vector<int>& gids) {
+    int totalTiles = 0;
+    for (const Tileset& tileset : tilesets) {
+        totalTiles += tileset.tileCount;
+    }
+    // Room for every tile when it fits, so later setTileAt calls find space
+    int capacity = std::min(totalTiles, TextureArray::getMaxLayers());
+    if (static_cast<int>(gids.size()) > capacity) {
+        spdlog::warn("Map uses {} distinct tiles, more than a texture array holds ({}); drawing from tileset textures",
+                     gids.size(), capacity);
+        return false;
+    }
+    if (!tileArray.create(tileWidth, tileHeight, std::max(capacity, 1))) {
+        return false;
+    }
+
+    const Tileset& last = tilesets.back();
+    gidArrayLayers.assign(static_cast<size_t>(last.firstGid + last.tileCount), -1);
+    usedArrayLayers = 0;
+    if (!uploadArrayLayers(gids)) {
+        tileArray.release();
+        return false;
+    }
+    return true;
+}
+
+bool Tilemap::uploadArrayLayers(const std::vector<int>& gids) {
+    // Each tileset image is decoded once for all the tiles it contributes
+    for (size_t tilesetIndex = 0; tilesetIndex < tilesets.size(); ++tilesetIndex) {
+        const Tileset& tileset = tilesets[tilesetIndex];
+        std::vector<int> pending;
+        for (int gid : gids) {
+            gid &= 0x1FFFFFFF;
+            if (findTileset(gid) != static_cast<int>(tilesetIndex) || gidArrayLayers[gid] >= 0) continue;
+            if (std::find(pending.begin(), pending.end(), gid) == pending.end()) pending.push_back(gid);
+        }
+        if (pending.empty()) continue;
+
+        if (usedArrayLayers + static_cast<int>(pending.size()) > tileArray.getLayerCount()) {
+            spdlog::error("Tile texture array is full ({} layers)", tileArray.getLayerCount());
+            return false;
+        }
+
+        int imageWidth, imageHeight, channels;
+        unsigned char* pixels = TextureCache::decode(tileset.imagePath, false, 4, imageWidth, imageHeight, channels);
+        if (!pixels) {
+            spdlog::error("Failed to load tileset image: {} ({})", tileset.imagePath, stbi_failure_reason());
+            return false;
+        }
+
+        for (int gid : pending) {
+            int tileIndex = gid - tileset.firstGid;
+            int cellX = tileset.margin + (tileIndex % tileset.columns) * (tileWidth + tileset.spacing);
+            int cellY = tileset.margin + (tileIndex / tileset.columns) * (tileHeight + tileset.spacing);
+            if (cellX + tileWidth > imageWidth || cellY + tileHeight > imageHeight) {
+                spdlog::warn("Tile {} lies outside its tileset image {}", gid, tileset.imagePath);
+                continue;
             }
+            tileArray.uploadLayer(usedArrayLayers, pixels, imageWidth, cellX, cellY);
+            gidArrayLayers[gid] = usedArrayLayers++;
+        }
+        stbi_image_free(pixels);
+    }
+    return true;
+}
+
+const Tilemap::TileAnimation* Tilemap::findAnimation(int gid) const {
+    int tilesetIndex = findTileset(gid);
+    if (tilesetIndex < 0) return nullptr;
+    const Tileset& tileset = tilesets[tilesetIndex];
+    for (const TileAnimation& animation : tileset.animations) {
+        if (animation.tileId == gid - tileset.firstGid) return &animation;
+    }
+    return nullptr;
+}
+
+void Tilemap::appendAnimationFrames(std::vector<int>& gids) const {
+    size_t count = gids.size();
+    for (size_t i = 0; i < count; ++i) {
+        const TileAnimation* animation = findAnimation(gids[i] & 0x1FFFFFFF);
+        if (!animation) continue;
+        int firstGid = tilesets[findTileset(gids[i] & 0x1FFFFFFF)].firstGid;
+        for (const auto& frame : animation->frames) {
+            gids.push_back(firstGid + frame.first);
+        }
+    }
+}
+
+int Tilemap::registerAnimation(int gid) {
+    if (static_cast<size_t>(gid) >= gidAnimations.size()) return -1;
+    if (gidAnimations[gid] >= 0) return gidAnimations[gid];
+
+    const TileAnimation* animation = findAnimation(gid);
+    if (!animation) return -1;
+    int firstGid = tilesets[findTileset(gid)].firstGid;
+    std::vector<int> frameGids;
+    for (const auto& frame : animation->frames) {
+        frameGids.push_back(firstGid + frame.first);
+    }
+    if (!uploadArrayLayers(frameGids)) return -1;
+
+    // Frames store when they end, so the shader can stop at the first one
+    // that ends after the current time
+    std::vector<std::pair<int, int>> frames;
+    int endMs = 0;
+    for (size_t i = 0; i < frameGids.size(); ++i) {
+        int arrayLayer = gidArrayLayers[frameGids[i]];
+        if (arrayLayer < 0) continue;
+        endMs += std::max(1, animation->frames[i].second);
+        frames.emplace_back(arrayLayer, endMs);
+    }
+    if (frames.empty()) return -1;
+
+    animationFrames.push_back(std::move(frames));
+    gidAnimations[gid] = static_cast<int>(animationFrames.size() - 1);
+    return gidAnimations[gid];
+}
+
+int Tilemap::getTileIndexValue(int gid) const {
+    if (gid <= 0) return 0;
+    if (static_cast<size_t>(gid) < gidAnimations.size() && gidAnimations[gid] >= 0) {
+        return -(gidAnimations[gid] + 1);
+    }
+    if (static_cast<size_t>(gid) < gidArrayLayers.size() && gidArrayLayers[gid] >= 0) {
+        return gidArrayLayers[gid] + 1;
+    }
+    return 0;
+}
+
+bool Tilemap::setupTileIndex(const std::vector<int>& gids) {
+    if (layerCount == 0 || layerCount > TextureArray::getMaxLayers()) {
+        return false;
+    }
+
+    // Index textures themselves are built per chunk as the view reaches them,
+    // so only the animations every chunk shares are set up front
+    const Tileset& last = tilesets.back();
+    gidAnimations.assign(static_cast<size_t>(last.firstGid + last.tileCount), -1);
+    animationFrames.clear();
+    for (int gid : gids) {
+        registerAnimation(gid);
+    }
+
+    uploadAnimationTexture();
+    return true;
+}
+
+void Tilemap::uploadAnimationTexture() {
+    if (animationFrames.empty()) return;
+
+    // One row per animation: frame count and total length, then the frames
+    size_t maxFrames = 0;
+    for (const auto& frames : animationFrames) {
+        maxFrames = std::max(maxFrames, frames.size());
+    }
+    size_t rowWidth = maxFrames + 1;
+    std::vector<GLint> texels(rowWidth * animationFrames.size() * 2, 0);
+    for (size_t row = 0; row < animationFrames.size(); ++row) {
+        const auto& frames = animationFrames[row];
+        GLint* texel = &texels[row * rowWidth * 2];
+        texel[0] = static_cast<GLint>(frames.size());
+        texel[1] = frames.back().second;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            texel[(i + 1) * 2] = frames[i].first;
+            texel[(i + 1) * 2 + 1] = frames[i].second;
         }
     }
 
-    spdlog::info("Map loaded: {}x{} tiles, tile size: {}x{}", width, height, tileWidth, tileHeight);
+    if (animationTexture == 0) {
+        glGenTextures(1, &animationTexture);
+    }
+    GLState::bindTexture(animationTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32I, static_cast<GLsizei>(rowWidth),
+                 static_cast<GLsizei>(animationFrames.size()), 0, GL_RG_INTEGER, GL_INT, texels.data());
+}
+
+void Tilemap::releaseTileIndexTextures() {
+    if (animationTexture != 0) {
+        GLState::deleteTextures(1, &animationTexture);
+        animationTexture = 0;
+    }
+}
+
+bool Tilemap::loadTilesetTextures() {
+    for (Tileset& tileset : tilesets) {
+        // The cache keeps tilesets around, so switching back to an earlier
+        // map skips the decode
+        tileset.texture = TextureCache::shared().load(tileset.imagePath);
+        if (!tileset.texture) {
+            spdlog::error("Failed to load tileset texture: {}", tileset.imagePath);
+            return false;
+        }
+    }
     return true;
 }
 
-void Tilemap::draw(float offsetX, float offsetY) const {
-    if (textureID == 0 || layers.empty()) {
+void Tilemap::draw(const ViewRect& view) const {
+    if (chunks.empty() || (!useTileArray && tilesets.empty())) {
         return;
     }
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    RenderBackend& backend = RenderBackend::current();
+    ChunkRange visible = getChunkRange(view);
+    float chunkWorldW = static_cast<float>(CHUNK_SIZE * tileWidth);
+    float chunkWorldH = static_cast<float>(CHUNK_SIZE * tileHeight);
+
+    // Chunks a little outside the view keep their buffers so that walking
+    // back and forth along a chunk border doesn't rebuild them every frame
+    evictChunksOutside(getChunkRange(view.expanded(std::max(chunkWorldW, chunkWorldH) * 2.0f)));
+
+    ViewRect bounds = getBounds();
+    TileLayerDraw layerDraw;
+    layerDraw.tileArray = tileArray.getID();
+    layerDraw.animationTexture = animationTexture;
+    layerDraw.tileWidth = static_cast<float>(tileWidth);
+    layerDraw.tileHeight = static_cast<float>(tileHeight);
+    layerDraw.timeMs = static_cast<GLuint>(static_cast<uint64_t>(animationTime * 1000.0) & 0xFFFFFFFFu);
+
+    // Chunks never overlap, so each one draws all of its layers in one call,
+    // or one per tileset run without the tile array. With index textures a
+    // chunk draws one quad per layer, clipped to the view.
+    for (int cy = visible.firstY; cy <= visible.lastY; ++cy) {
+        for (int cx = visible.firstX; cx <= visible.lastX; ++cx) {
+            int chunkIndex = cy * chunksX + cx;
+            const TileChunk& chunk = chunks[chunkIndex];
+            if (chunk.tiles.empty()) continue;
+
+            if (useTileIndex) {
+                if (chunk.dirty || chunk.indexTexture == 0) {
+                    buildChunk(chunkIndex);
+                }
+                layerDraw.indexTexture = chunk.indexTexture;
+                layerDraw.originX = cx * chunkWorldW;
+                layerDraw.originY = cy * chunkWorldH;
+                layerDraw.left = std::max({view.left, bounds.left, layerDraw.originX});
+                layerDraw.top = std::max({view.top, bounds.top, layerDraw.originY});
+                layerDraw.right = std::min({view.right, bounds.right, layerDraw.originX + chunkWorldW});
+                layerDraw.bottom = std::min({view.bottom, bounds.bottom, layerDraw.originY + chunkWorldH});
+                if (layerDraw.right <= layerDraw.left || layerDraw.bottom <= layerDraw.top) continue;
+
+                for (int layer = 0; layer < layerCount; ++layer) {
+                    layerDraw.mapLayer = layer;
+                    backend.drawTileLayer(layerDraw);
+                }
+                continue;
+            }
+
+            if (chunk.dirty || chunk.vertexBuffer == 0) {
+                buildChunk(chunkIndex);
+            }
+            if (chunk.vertexCount == 0) continue;
+
+            if (useTileArray) {
+                backend.drawTileArray(chunk.vertexBuffer, 0, chunk.vertexCount, tileArray.getID());
+                continue;
+            }
+            GLint first = 0;
+            for (const auto& run : chunk.tilesetRuns) {
+                backend.drawTextured(chunk.vertexBuffer, first, run.second, tilesets[run.first].texture->getID(),
+                                     1.0f, 1.0f, 1.0f, 1.0f);
+                first += run.second;
+            }
+        }
+    }
+
+    // Warm up the ring of chunks just outside the view for when the camera moves
+    prefetchChunks(getChunkRange(view.expanded(std::max(chunkWorldW, chunkWorldH))));
+}
 
-    for (const auto& layer : layers) {
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                int tileID = layer[y][x];
-                if (tileID == 0) continue;
+Tilemap::ChunkRange Tilemap::getChunkRange(const ViewRect& view) const {
+    float chunkWorldW = static_cast<float>(CHUNK_SIZE * tileWidth);
+    float chunkWorldH = static_cast<float>(CHUNK_SIZE * tileHeight);
 
-                int tilesPerRow = textureWidth / tileWidth;
-                int tileIndex = (tileID & 0x1FFFFFFF) - 1;
+    ChunkRange range;
+    range.firstX = std::max(0, static_cast<int>(std::floor(view.left / chunkWorldW)));
+    range.firstY = std::max(0, static_cast<int>(std::floor(view.top / chunkWorldH)));
+    range.lastX = std::min(chunksX - 1, static_cast<int>(std::ceil(view.right / chunkWorldW)) - 1);
+    range.lastY = std::min(chunksY - 1, static_cast<int>(std::ceil(view.bottom / chunkWorldH)) - 1);
+    return range;
+}
 
-                int tileX = tileIndex % tilesPerRow;
-                int tileY = tileIndex / tilesPerRow;
+void Tilemap::buildChunk(int chunkIndex) const {
+    const TileChunk& chunk = chunks[chunkIndex];
+    if (chunk.vertexBuffer == 0 && chunk.indexTexture == 0) {
+        residentChunks.push_back(chunkIndex);
+    }
+    if (useTileIndex) {
+        buildChunkIndexTexture(chunkIndex);
+    } else {
+        buildChunkGeometry(chunkIndex);
+    }
+}
 
-                const float padding = 0.5f;
-                float u1 = (tileX * tileWidth + padding) / textureWidth;
-                float v1 = (tileY * tileHeight + padding) / textureHeight;
-                float u2 = ((tileX + 1) * tileWidth - padding) / textureWidth;
-                float v2 = ((tileY + 1) * tileHeight - padding) / textureHeight;
+void Tilemap::buildChunkIndexTexture(int chunkIndex) const {
+    const TileChunk& chunk = chunks[chunkIndex];
+    chunk.dirty = false;
 
-                float worldX = x * tileWidth + offsetX;
-                float worldY = y * tileHeight + offsetY;
+    std::vector<GLint> indices(chunk.tiles.size());
+    for (size_t i = 0; i < chunk.tiles.size(); ++i) {
+        indices[i] = getTileIndexValue(chunk.tiles[i] & 0x1FFFFFFF);
+    }
+
+    bool created = chunk.indexTexture == 0;
+    if (created) {
+        glGenTextures(1, &chunk.indexTexture);
+    }
+    GLState::bindTextureArray(chunk.indexTexture);
+    if (created) {
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32I, CHUNK_SIZE, CHUNK_SIZE, layerCount, 0,
+                     GL_RED_INTEGER, GL_INT, indices.data());
+    } else {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, CHUNK_SIZE, CHUNK_SIZE, layerCount,
+                        GL_RED_INTEGER, GL_INT, indices.data());
+    }
+}
 
-                std::swap(v1, v2);
+void Tilemap::buildChunkGeometry(int chunkIndex) const {
+    const TileChunk& chunk = chunks[chunkIndex];
+    chunk.dirty = false;
+
+    int originX = (chunkIndex % chunksX) * CHUNK_SIZE;
+    int originY = (chunkIndex / chunksX) * CHUNK_SIZE;
+
+    // Layers are appended bottom to top so draw order matches the layer order
+    std::vector<TileVertex> arrayVertices;
+    std::vector<TexturedVertex> tilesetVertices;
+    chunk.tilesetRuns.clear();
+    for (int layer = 0; layer < layerCount; ++layer) {
+        const int* layerTiles = &chunk.tiles[static_cast<size_t>(layer) * CHUNK_SIZE * CHUNK_SIZE];
+        for (int ly = 0; ly < CHUNK_SIZE; ++ly) {
+            for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+                int gid = layerTiles[ly * CHUNK_SIZE + lx] & 0x1FFFFFFF;
+                if (gid == 0) continue;
+
+                if (useTileArray) {
+                    if (static_cast<size_t>(gid) >= gidArrayLayers.size() || gidArrayLayers[gid] < 0) continue;
+                    appendTileQuad(arrayVertices, originX + lx, originY + ly, gidArrayLayers[gid]);
+                    continue;
+                }
 
-                glBegin(GL_QUADS);
-                    glTexCoord2f(u1, v2); glVertex2f(worldX, worldY);
-                    glTexCoord2f(u2, v2); glVertex2f(worldX + tileWidth, worldY);
-                    glTexCoord2f(u2, v1); glVertex2f(worldX + tileWidth, worldY + tileHeight);
-                    glTexCoord2f(u1, v1); glVertex2f(worldX, worldY + tileHeight);
-                glEnd();
+                int tilesetIndex = findTileset(gid);
+                if (tilesetIndex < 0) continue;
+                appendTilesetQuad(tilesetVertices, originX + lx, originY + ly, tilesets[tilesetIndex], gid);
+                if (chunk.tilesetRuns.empty() || chunk.tilesetRuns.back().first != tilesetIndex) {
+                    chunk.tilesetRuns.emplace_back(tilesetIndex, 0);
+                }
+                chunk.tilesetRuns.back().second += 6;
             }
         }
     }
 
-    glDisable(GL_TEXTURE_2D);
+    if (chunk.vertexBuffer == 0) {
+        glGenBuffers(1, &chunk.vertexBuffer);
+    }
+    GLState::bindArrayBuffer(chunk.vertexBuffer);
+    if (useTileArray) {
+        glBufferData(GL_ARRAY_BUFFER, arrayVertices.size() * sizeof(TileVertex), arrayVertices.data(), GL_STATIC_DRAW);
+        chunk.vertexCount = static_cast<int>(arrayVertices.size());
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, tilesetVertices.size() * sizeof(TexturedVertex), tilesetVertices.data(), GL_STATIC_DRAW);
+        chunk.vertexCount = static_cast<int>(tilesetVertices.size());
+    }
+    GLState::bindArrayBuffer(0);
+}
+
+void Tilemap::evictChunksOutside(const ChunkRange& keep) const {
+    for (size_t i = 0; i < residentChunks.size();) {
+        int chunkIndex = residentChunks[i];
+        if (keep.contains(chunkIndex % chunksX, chunkIndex / chunksX)) {
+            ++i;
+            continue;
+        }
+
+        releaseChunk(chunks[chunkIndex]);
+
+        // Order of resident chunks doesn't matter, swap-remove
+        residentChunks[i] = residentChunks.back();
+        residentChunks.pop_back();
+    }
+}
+
+void Tilemap::prefetchChunks(const ChunkRange& range) const {
+    // Bound the work so streaming never causes a frame spike
+    const int maxBuildsPerFrame = 2;
+    int builds = 0;
+    for (int cy = range.firstY; cy <= range.lastY && builds < maxBuildsPerFrame; ++cy) {
+        for (int cx = range.firstX; cx <= range.lastX && builds < maxBuildsPerFrame; ++cx) {
+            int chunkIndex = cy * chunksX + cx;
+            const TileChunk& chunk = chunks[chunkIndex];
+            if (chunk.tiles.empty() || chunk.vertexBuffer != 0 || chunk.indexTexture != 0) continue;
+            buildChunk(chunkIndex);
+            ++builds;
+        }
+    }
+}
+
+void Tilemap::releaseChunk(const TileChunk& chunk) const {
+    if (chunk.vertexBuffer != 0) {
+        GLState::deleteBuffers(1, &chunk.vertexBuffer);
+        chunk.vertexBuffer = 0;
+    }
+    if (chunk.indexTexture != 0) {
+        GLState::deleteTextures(1, &chunk.indexTexture);
+        chunk.indexTexture = 0;
+    }
+    chunk.vertexCount = 0;
+    chunk.dirty = true;
+}
+
+void Tilemap::releaseChunkBuffers() {
+    for (int chunkIndex : residentChunks) {
+        releaseChunk(chunks[chunkIndex]);
+    }
+    residentChunks.clear();
+}
+
+void Tilemap::appendTileQuad(std::vector<TileVertex>& vertices, int x, int y, int arrayLayer) const {
+    // Each layer is a whole tile, so the quad always spans it edge to edge
+    float worldX = static_cast<float>(x * tileWidth);
+    float worldY = static_cast<float>(y * tileHeight);
+    float layer = static_cast<float>(arrayLayer);
+
+    TileVertex topLeft = {worldX, worldY, 0.0f, 0.0f, layer};
+    TileVertex topRight = {worldX + tileWidth, worldY, 1.0f, 0.0f, layer};
+    TileVertex bottomRight = {worldX + tileWidth, worldY + tileHeight, 1.0f, 1.0f, layer};
+    TileVertex bottomLeft = {worldX, worldY + tileHeight, 0.0f, 1.0f, layer};
+
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+void Tilemap::appendTilesetQuad(std::vector<TexturedVertex>& vertices, int x, int y,
+                                const Tileset& tileset, int gid) const {
+    int textureWidth = tileset.texture->getWidth();
+    int textureHeight = tileset.texture->getHeight();
+    int tileIndex = gid - tileset.firstGid;
+    int pixelX = tileset.margin + (tileIndex % tileset.columns) * (tileWidth + tileset.spacing);
+    int pixelY = tileset.margin + (tileIndex / tileset.columns) * (tileHeight + tileset.spacing);
+
+    // Half a texel inset keeps filtering from reaching the neighbouring tile
+    const float padding = 0.5f;
+    float u1 = (pixelX + padding) / textureWidth;
+    float v1 = (pixelY + padding) / textureHeight;
+    float u2 = (pixelX + tileWidth - padding) / textureWidth;
+    float v2 = (pixelY + tileHeight - padding) / textureHeight;
+
+    float worldX = static_cast<float>(x * tileWidth);
+    float worldY = static_cast<float>(y * tileHeight);
+
+    TexturedVertex topLeft = {worldX, worldY, u1, v1};
+    TexturedVertex topRight = {worldX + tileWidth, worldY, u2, v1};
+    TexturedVertex bottomRight = {worldX + tileWidth, worldY + tileHeight, u2, v2};
+    TexturedVertex bottomLeft = {worldX, worldY + tileHeight, u1, v2};
+
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+Tilemap::TileChunk* Tilemap::getChunkForTile(int x, int y) {
+    return &chunks[(y / CHUNK_SIZE) * chunksX + (x / CHUNK_SIZE)];
+}
+
+const Tilemap::TileChunk* Tilemap::getChunkForTile(int x, int y) const {
+    return &chunks[(y / CHUNK_SIZE) * chunksX + (x / CHUNK_SIZE)];
+}
+
+int Tilemap::getLocalIndex(int x, int y) {
+    return (y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE);
+}
+
+int Tilemap::getTileAt(int layer, int x, int y) const {
+    if (layer < 0 || layer >= layerCount) return 0;
+    if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+    const TileChunk* chunk = getChunkForTile(x, y);
+    if (chunk->tiles.empty()) return 0;
+    return chunk->tiles[layer * CHUNK_SIZE * CHUNK_SIZE + getLocalIndex(x, y)];
+}
+
+void Tilemap::setTileAt(int layer, int x, int y, int gid) {
+    if (layer < 0 || layer >= layerCount) return;
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    if (getTileAt(layer, x, y) == gid) return;
+
+    // A tile the map hasn't used yet needs a free layer in the array, and
+    // so do its animation frames
+    int maskedGid = gid & 0x1FFFFFFF;
+    if (useTileArray && maskedGid != 0 && findTileset(maskedGid) >= 0) {
+        std::vector<int> needed{maskedGid};
+        appendAnimationFrames(needed);
+        if (!uploadArrayLayers(needed)) {
+            spdlog::warn("No room for tile {} in the tile texture array, it won't be drawn", maskedGid);
+        }
+    }
+
+    TileChunk* chunk = getChunkForTile(x, y);
+    if (chunk->tiles.empty()) chunk->tiles.resize(static_cast<size_t>(layerCount) * CHUNK_SIZE * CHUNK_SIZE, 0);
+    chunk->tiles[layer * CHUNK_SIZE * CHUNK_SIZE + getLocalIndex(x, y)] = gid;
+    editedTiles.emplace_back(x, y);
+
+    if (!useTileIndex) {
+        chunk->dirty = true;
+        return;
+    }
+    size_t animationCount = animationFrames.size();
+    registerAnimation(maskedGid);
+    if (animationFrames.size() != animationCount) {
+        uploadAnimationTexture();
+    }
+    // A resident chunk takes the one texel, the rest pick it up when built
+    if (chunk->indexTexture == 0) {
+        chunk->dirty = true;
+        return;
+    }
+    GLint value = getTileIndexValue(maskedGid);
+    GLState::bindTextureArray(chunk->indexTexture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x % CHUNK_SIZE, y % CHUNK_SIZE, layer, 1, 1, 1,
+                    GL_RED_INTEGER, GL_INT, &value);
 }
 
 int Tilemap::getNormalizedTileIdAt(int x, int y) const {
     if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+    const TileChunk* chunk = getChunkForTile(x, y);
+    if (chunk->tiles.empty()) return 0;
     // Iterate topmost to bottommost layer to find the first non-zero tile
-    for (int i = static_cast<int>(layers.size()) - 1; i >= 0; --i) {
-        int gid = layers[i][y][x];
+    int localIndex = getLocalIndex(x, y);
+    for (int i = layerCount - 1; i >= 0; --i) {
+        int gid = chunk->tiles[i * CHUNK_SIZE * CHUNK_SIZE + localIndex];
         if (gid != 0) {
             return gid & 0x1FFFFFFF;
         }
@@ -193,17 +791,26 @@ int Tilemap::getNormalizedTileIdAt(int x, int y) const {
 
 bool Tilemap::isTileSolid(int x, int y) const {
     if (x < 0 || y < 0 || x >= width || y >= height) return true;
-    if (collisionLayer.empty()) return false;
-    return collisionLayer[y][x] != 0;  // Assuming 0 means walkable
+    const TileChunk* chunk = getChunkForTile(x, y);
+    if (chunk->collision.empty()) return false;
+    return chunk->collision[getLocalIndex(x, y)] != 0;  // Assuming 0 means walkable
+}
+
+bool Tilemap::isGateTile(int x, int y) const {
+    int gid = getNormalizedTileIdAt(x, y);
+    return gid >= 120 && gid <= 123;
+}
+
+ViewRect Tilemap::getBounds() const {
+    return {0.0f, 0.0f, static_cast<float>(width * tileWidth), static_cast<float>(height * tileHeight)};
 }
 
 int Tilemap::getWidthInTiles() const { return width; }
 int Tilemap::getHeightInTiles() const { return height; }
 int Tilemap::getTileWidth() const { return tileWidth; }
 int Tilemap::getTileHeight() const { return tileHeight; }
-bool Tilemap::loadTilesetFromTSX(const std::string& tsxPath) {
+bool Tilemap::loadTilesetFromTSX(const std::string& tsxPath, int firstGid) {
     spdlog::info("Attempting to load TSX file: {}", tsxPath);
-    
 
     tinyxml2::XMLDocument doc;
     if (doc.LoadFile(tsxPath.c_str()) != tinyxml2::XML_SUCCESS) {
@@ -212,18 +819,18 @@ bool Tilemap::loadTilesetFromTSX(const std::string& tsxPath) {
         return false;
     }
 
-    auto* tileset = doc.FirstChildElement("tileset");
-    if (!tileset) {
+    auto* tilesetElement = doc.FirstChildElement("tileset");
+    if (!tilesetElement) {
         spdlog::error("No <tileset> element in TSX: {}", tsxPath);
         return false;
     }
 
-    tileWidth = tileset->IntAttribute("tilewidth");
-    tileHeight = tileset->IntAttribute("tileheight");
-    spdlog::info("Tileset dimensions: {}x{}", tileWidth, tileHeight);
+    int tilesetTileWidth = tilesetElement->IntAttribute("tilewidth");
+    int tilesetTileHeight = tilesetElement->IntAttribute("tileheight");
+    spdlog::info("Tileset dimensions: {}x{}", tilesetTileWidth, tilesetTileHeight);
 
-    auto* image = tileset->FirstChildElement("image");
-    if (!image) {
+    auto* image = tilesetElement->FirstChildElement("image");
+    if (!image || !image->Attribute("source")) {
         spdlog::error("No <image> in TSX: {}", tsxPath);
         return false;
     }
@@ -233,8 +840,26 @@ bool Tilemap::loadTilesetFromTSX(const std::string& tsxPath) {
 
     // Resolve image path relative to the TSX file's directory
     std::filesystem::path tsxDir = std::filesystem::path(tsxPath).parent_path();
-    std::string resolvedImagePath = (tsxDir / imagePath).string();
-    spdlog::info("Resolved image path: {}", resolvedImagePath);
-    
-    return loadTilesetTexture(resolvedImagePath, tileWidth, tileHeight);
+
+    Tileset tileset;
+    tileset.firstGid = firstGid;
+    tileset.tileCount = tilesetElement->IntAttribute("tilecount");
+    tileset.columns = tilesetElement->IntAttribute("columns");
+    tileset.margin = tilesetElement->IntAttribute("margin");
+    tileset.spacing = tilesetElement->IntAttribute("spacing");
+    tileset.imagePath = (tsxDir / imagePath).string();
+    spdlog::info("Resolved image path: {}", tileset.imagePath);
+
+    for (auto* tile = tilesetElement->FirstChildElement("tile"); tile; tile = tile->NextSiblingElement("tile")) {
+        auto* animationElement = tile->FirstChildElement("animation");
+        if (!animationElement) continue;
+        TileAnimation animation{tile->IntAttribute("id"), {}};
+        for (auto* frame = animationElement->FirstChildElement("frame"); frame;
+             frame = frame->NextSiblingElement("frame")) {
+            animation.frames.emplace_back(frame->IntAttribute("tileid"), frame->IntAttribute("duration"));
+        }
+        tileset.animations.push_back(std::move(animation));
+    }
+
+    return addTileset(tileset, tilesetTileWidth, tilesetTileHeight);
 }
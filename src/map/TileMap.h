@@ -3,30 +3,165 @@
 #include <vector>
 #include <string>
 #include <unordered_set>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include "render/RenderBackend.h"
+#include "render/TextureArray.h"
+#include "render/ViewRect.h"
+#include "render/TextureCache.h"
 
 class Tilemap {
 public:
+    // Maps are stored and streamed to the GPU in square chunks of this many tiles
+    static constexpr int CHUNK_SIZE = 32;
+
     Tilemap();
     ~Tilemap();
-    
-    bool loadTilesetTexture(const std::string& imagePath, int tileWidth, int tileHeight);
-    void draw(float offsetX = 0, float offsetY = 0) const;
+
+    Tilemap(const Tilemap&) = delete;
+    Tilemap& operator=(const Tilemap&) = delete;
+
+    // Advance animated tiles
+    void update(float deltaTime);
+    void draw(const ViewRect& view) const;
+    // Replaces the current map only once the new one has fully loaded, so a
+    // failed load leaves the previous map in place
     bool loadFromJSON(const std::string& jsonPath);
-    bool loadTilesetFromTSX(const std::string& tsxPath);
+    // Add an external Tiled tileset whose tiles start at firstGid
+    bool loadTilesetFromTSX(const std::string& tsxPath, int firstGid = 1);
     bool isTileSolid(int x, int y) const;
+    // Topmost tile is one of the level gate's tiles
+    bool isGateTile(int x, int y) const;
     int getNormalizedTileIdAt(int x, int y) const;
     int getTileWidth() const;
     int getTileHeight() const;
     int getWidthInTiles() const;
     int getHeightInTiles() const;
 
+    // Whole map in world units
+    ViewRect getBounds() const;
+
+    // Editing tiles invalidates the cached geometry of the owning chunk
+    void setTileAt(int layer, int x, int y, int gid);
+    int getTileAt(int layer, int x, int y) const;
+    int getLayerCount() const { return layerCount; }
+
+    // Changes on every load and is never shared by two maps, so anything
+    // derived from the tiles can tell when to rebuild
+    unsigned int getGeneration() const { return generation; }
+    // Tiles changed by setTileAt since the map was loaded, oldest first
+    const std::vector<std::pair<int, int>>& getEditedTiles() const { return editedTiles; }
+
+    // Number of chunks that currently hold a GPU buffer
+    int getResidentChunkCount() const { return static_cast<int>(residentChunks.size()); }
+
 private:
-    unsigned int textureID;
-    int textureWidth, textureHeight;
     int tileWidth, tileHeight;
     int width, height;
 
-    std::vector<std::vector<std::vector<int>>> layers; // Drawable layers
-    std::vector<std::vector<int>> collisionLayer;      // Collision layer
-};
\ No newline at end of file
+    unsigned int generation = 0;
+    std::vector<std::pair<int, int>> editedTiles;
+
+    // A Tiled <animation>: the tile shows each frame's tile in turn
+    struct TileAnimation {
+        int tileId;                               // Local id of the animated tile
+        std::vector<std::pair<int, int>> frames;  // Local tile id and duration in milliseconds
+    };
+
+    // One entry of the map's tilesets array, covering the gids from firstGid
+    // to firstGid + tileCount - 1
+    struct Tileset {
+        int firstGid = 1;
+        int tileCount = 0;
+        int columns = 0;
+        int margin = 0;
+        int spacing = 0;
+        std::string imagePath;
+        std::vector<TileAnimation> animations;
+        TextureHandle texture;  // Only loaded when tiles can't come from tileArray
+    };
+    std::vector<Tileset> tilesets;  // Sorted by firstGid
+
+    // Every tile the map uses gets its own layer in tileArray, so chunks from
+    // any mix of tilesets draw with one bind and nothing bleeds in from a
+    // neighbouring tile. Backends without texture arrays, or maps with more
+    // distinct tiles than the array can hold, draw from the tileset images.
+    bool useTileArray = false;
+    TextureArray tileArray;
+    std::vector<int> gidArrayLayers;  // Indexed by gid, -1 until the tile is uploaded
+    int usedArrayLayers = 0;
+
+    // With the tile array in place the map needs no geometry at all: each
+    // chunk keeps an index texture with a slice per map layer and a fragment
+    // shader looks the tile up, so a chunk layer draws as one quad. A texel
+    // holds the tile's array layer + 1, -(animation + 1) for animated tiles,
+    // or 0 for none. Animations play from animationTexture against a time
+    // uniform; chunk geometry remains for backends without texture arrays.
+    bool useTileIndex = false;
+    GLuint animationTexture = 0;
+    std::vector<int> gidAnimations;  // Indexed by gid, -1 for still tiles
+    std::vector<std::vector<std::pair<int, int>>> animationFrames;  // Array layer and end time in ms per frame
+    double animationTime = 0.0;
+
+    // A CHUNK_SIZE x CHUNK_SIZE block of the map. Tile storage is only
+    // allocated for chunks that contain something, and the vertex buffer or
+    // index texture only exists while the chunk is near the view.
+    struct TileChunk {
+        std::vector<int> tiles;      // layerCount * CHUNK_SIZE * CHUNK_SIZE, layer-major
+        std::vector<int> collision;  // CHUNK_SIZE * CHUNK_SIZE
+        mutable unsigned int vertexBuffer = 0;
+        mutable int vertexCount = 0;
+        mutable GLuint indexTexture = 0;  // GL_R32I array, CHUNK_SIZE square, one slice per layer
+        mutable bool dirty = true;
+        // Without the tile array the buffer holds one run per tileset switch
+        mutable std::vector<std::pair<int, int>> tilesetRuns;  // Tileset index and vertex count
+    };
+
+    int layerCount = 0;
+    int chunksX = 0, chunksY = 0;
+    std::vector<TileChunk> chunks;
+    mutable std::vector<int> residentChunks;  // Indices of chunks with a vertex buffer or index texture
+
+    struct ChunkRange {
+        int firstX, firstY, lastX, lastY;
+        bool contains(int cx, int cy) const {
+            return cx >= firstX && cx <= lastX && cy >= firstY && cy <= lastY;
+        }
+    };
+
+    // Fill a freshly constructed map from the file
+    bool load(const std::string& jsonPath);
+    void swap(Tilemap& other);
+
+    ChunkRange getChunkRange(const ViewRect& view) const;
+    TileChunk* getChunkForTile(int x, int y);
+    const TileChunk* getChunkForTile(int x, int y) const;
+    static int getLocalIndex(int x, int y);
+
+    bool addTileset(const Tileset& tileset, int tilesetTileWidth, int tilesetTileHeight);
+    int findTileset(int gid) const;  // Index into tilesets, -1 if no tileset covers gid
+
+    // Upload the given tiles into free array layers. False if they don't fit.
+    bool uploadArrayLayers(const std::vector<int>& gids);
+    bool createTileArray(const std::vector<int>& gids);
+    bool loadTilesetTextures();
+
+    const TileAnimation* findAnimation(int gid) const;
+    void appendAnimationFrames(std::vector<int>& gids) const;
+    // Animation index for an animated gid, adding it on first use; -1 if still
+    int registerAnimation(int gid);
+    int getTileIndexValue(int gid) const;
+    bool setupTileIndex(const std::vector<int>& gids);
+    void uploadAnimationTexture();
+    void releaseTileIndexTextures();
+
+    void buildChunk(int chunkIndex) const;
+    void buildChunkGeometry(int chunkIndex) const;
+    void buildChunkIndexTexture(int chunkIndex) const;
+    void releaseChunk(const TileChunk& chunk) const;
+    void evictChunksOutside(const ChunkRange& keep) const;
+    void prefetchChunks(const ChunkRange& range) const;
+    void releaseChunkBuffers();
+    void appendTileQuad(std::vector<TileVertex>& vertices, int x, int y, int arrayLayer) const;
+    void appendTilesetQuad(std::vector<TexturedVertex>& vertices, int x, int y, const Tileset& tileset, int gid) const;
+};
@@ -1,8 +1,9 @@
 #include "player/Player.h"
 #include "projectile/Projectile.h"
+#include "render/DebugDraw.h"
+#include "render/SpriteBatch.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
-#include <iostream>
 #include <spdlog/spdlog.h>
 
 Player::Player()
@@ -22,7 +23,7 @@ Player::~Player() {
     // Add cleanup logic if needed
 }
 
-void Player::draw() const {
+void Player::draw(SpriteBatch& batch) const {
     if ((isIdle && idleTextureID == 0) || (!isIdle && textureID == 0)) return;
 
     unsigned int texID = isIdle ? idleTextureID : textureID;
@@ -32,9 +33,6 @@ void Player::draw() const {
     int frameH = isIdle ? idleFrameHeight : frameHeight;
     int currentF = isIdle ? idleCurrentFrame : currentFrame;
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, texID);
-
     // Calculate texture coordinates
     int framesPerRow = texWidth / frameW;
 
@@ -62,32 +60,25 @@ void Player::draw() const {
     float u2 = static_cast<float>((col + 1) * frameW) / texWidth;
     float v2 = static_cast<float>((row + 1) * frameH) / texHeight;
 
-    // Draw player centered on tile
-    float drawX = x - frameW / 2.0f;
-    float drawY = y - frameH / 2.0f;
-
-    glBegin(GL_QUADS);
-    glTexCoord2f(u1, v2); glVertex2f(drawX, drawY);
-    glTexCoord2f(u2, v2); glVertex2f(drawX + frameW, drawY);
-    glTexCoord2f(u2, v1); glVertex2f(drawX + frameW, drawY + frameH);
-    glTexCoord2f(u1, v1); glVertex2f(drawX, drawY + frameH);
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
+    // Draw player centered on tile (texture is loaded flipped, so v runs bottom-up)
+    Sprite sprite;
+    sprite.texture = texID;
+    sprite.x = x - frameW / 2.0f;
+    sprite.y = y - frameH / 2.0f;
+    sprite.width = static_cast<float>(frameW);
+    sprite.height = static_cast<float>(frameH);
+    sprite.u1 = u1;
+    sprite.v1 = v2;
+    sprite.u2 = u2;
+    sprite.v2 = v1;
+    sprite.layer = SpriteLayer::Entity;
+    sprite.depth = y;
+    batch.submit(sprite);
+}
 
-    // Draw collision rectangle (bounding box) in red, thick and always visible
-    glLineWidth(3.0f); // Thicker line
-    glDisable(GL_BLEND); // Disable blending for solid color
-    glColor3f(1.0f, 0.0f, 0.0f); // Red
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(getLeft(), getTop());
-    glVertex2f(getRight(), getTop());
-    glVertex2f(getRight(), getBottom());
-    glVertex2f(getLeft(), getBottom());
-    glEnd();
-    glEnable(GL_BLEND); // Restore blending
-    glLineWidth(1.0f); // Restore line width
-    glColor3f(1.0f, 1.0f, 1.0f); // Reset color to white
+void Player::drawBoundingBox() const {
+    // Collision rectangle in thick red, queued with the other hitboxes
+    DebugDraw::rect(DebugCategory::Hitboxes, getLeft(), getTop(), getRight(), getBottom(), 255, 0, 0, 255, 3.0f);
 }
 
 // Rest of the Player class methods remain the same...
@@ -97,36 +88,18 @@ void Player::loadTexture(const std::string& filePath, int frameWidth, int frameH
     this->frameHeight = frameHeight;
     this->totalFrames = totalFrames;
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    // Rows are stored bottom-up, which is what the draw code's UVs expect
+    TextureLoadOptions options;
+    options.flipVertically = true;
+    texture = TextureCache::shared().load(filePath, options);
+    if (!texture) {
         spdlog::error("Failed to load texture: {}", filePath);
         return;
     }
 
-    spdlog::info("Loaded texture: {} ({}x{})", filePath, width, height);
-
-    textureWidth = width;
-    textureHeight = height;
-
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    // Use NEAREST filtering for pixel-perfect graphics
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-
-    spdlog::debug("Texture loaded successfully with ID: {}", textureID);
+    textureID = texture->getID();
+    textureWidth = texture->getWidth();
+    textureHeight = texture->getHeight();
 }
 
 void Player::updateAnimation(float deltaTime, bool isMoving) {
@@ -171,32 +144,17 @@ void Player::loadIdleTexture(const std::string& filePath, int frameWidth, int fr
     this->idleFrameHeight = frameHeight;
     this->idleTotalFrames = totalFrames;
 
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
-        std::cerr << "Failed to load idle texture: " << filePath << std::endl;
+    TextureLoadOptions options;
+    options.flipVertically = true;
+    idleTexture = TextureCache::shared().load(filePath, options);
+    if (!idleTexture) {
+        spdlog::error("Failed to load idle texture: {}", filePath);
         return;
     }
 
-    idleTextureWidth = width;
-    idleTextureHeight = height;
-
-    glGenTextures(1, &idleTextureID);
-    glBindTexture(GL_TEXTURE_2D, idleTextureID);
-
-    // Use NEAREST filtering for pixel-perfect graphics
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
+    idleTextureID = idleTexture->getID();
+    idleTextureWidth = idleTexture->getWidth();
+    idleTextureHeight = idleTexture->getHeight();
 }
 
 void Player::updateIdleAnimation(float deltaTime) {
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "render/TextureCache.h"
 
 enum class Direction {
     Down = 2,
@@ -10,6 +11,7 @@ enum class Direction {
 };
 
 class Projectile;  // Forward declaration
+class SpriteBatch;
 
 class Player {
 public:
@@ -17,7 +19,8 @@ public:
     ~Player();
 
     void move(float dx, float dy);
-    void draw() const;
+    void draw(SpriteBatch& batch) const;
+    void drawBoundingBox() const;  // Queued as a debug hitbox
     void loadTexture(const std::string& filePath, int frameWidth, int frameHeight, int totalFrames);
     void updateAnimation(float deltaTime, bool isMoving);
     void setDirection(Direction newDirection);
@@ -62,6 +65,7 @@ private:
     float boundingBoxHeight = 16.0f;  // Much smaller rectangle height for collision
     float boundingBoxOffsetX = 8.0f;  // Center the rectangle horizontally (16/2 = 8)
     float boundingBoxOffsetY = 8.0f;  // Center the rectangle vertically (16/2 = 8)
+    TextureHandle texture;
     unsigned int textureID;
     int frameWidth, frameHeight;
     int textureWidth, textureHeight;   // ✅ NEW
@@ -70,6 +74,7 @@ private:
     float animationSpeed, elapsedTime;
     int currentFrame;
     Direction direction;
+    TextureHandle idleTexture;
     unsigned int idleTextureID = 0;
     int idleFrameWidth = 0;
     int idleFrameHeight = 0;
@@ -1,25 +1,17 @@
 #include "projectile/Projectile.h"
 #include "map/TileMap.h"
+#include "render/SpriteBatch.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <spdlog/spdlog.h>
 #include <cmath>
-#include <stb_image.h>
 
 // Static member initialization
-unsigned int Projectile::textureID = 0;
-int Projectile::textureWidth = 0;
-int Projectile::textureHeight = 0;
+AtlasHandle Projectile::playerSheet = INVALID_ATLAS_HANDLE;
+AtlasHandle Projectile::eyeSheet = INVALID_ATLAS_HANDLE;
+AtlasHandle Projectile::shroomSheet = INVALID_ATLAS_HANDLE;
 int Projectile::spriteWidth = 16;   // 16x16 pixels per sprite
 int Projectile::spriteHeight = 16;  // 16x16 pixels per sprite
-bool Projectile::textureLoaded = false;
-unsigned int Projectile::eyeTextureID = 0;
-int Projectile::eyeTextureWidth = 0;
-int Projectile::eyeTextureHeight = 0;
-bool Projectile::eyeTextureLoaded = false;
-unsigned int Projectile::shroomTextureID = 0;
-int Projectile::shroomTextureWidth = 0;
-int Projectile::shroomTextureHeight = 0;
-bool Projectile::shroomTextureLoaded = false;
 
 Projectile::Projectile(float x, float y, float dx, float dy, ProjectileType type)
     : x(x), y(y), dx(dx), dy(dy), type(type),
@@ -32,13 +24,6 @@ Projectile::Projectile(float x, float y, float dx, float dy, ProjectileType type
         this->dy = dy / length;
     }
     
-    // Set color based on type (fallback for enemy projectiles)
-    if (type == ProjectileType::PlayerBullet) {
-        r = 0.0f; g = 1.0f; b = 0.0f;  // Green for player
-    } else {
-        r = 1.0f; g = 0.0f; b = 0.0f;  // Red for enemy
-    }
-    
     spdlog::debug("Projectile created at ({}, {}) with direction ({}, {})", x, y, this->dx, this->dy);
 }
 
@@ -47,112 +32,58 @@ Projectile::~Projectile() {
 }
 
 void Projectile::loadProjectileTexture(const std::string& filePath) {
-    if (textureLoaded) {
+    if (playerSheet != INVALID_ATLAS_HANDLE) {
         spdlog::warn("Projectile texture already loaded");
         return;
     }
     
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    playerSheet = TextureAtlas::shared().addImage(filePath);
+    if (playerSheet == INVALID_ATLAS_HANDLE) {
         spdlog::error("Failed to load projectile texture: {}", filePath);
         return;
     }
     
-    spdlog::info("Loaded projectile texture: {} ({}x{})", filePath, width, height);
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(playerSheet);
+    spdlog::info("Loaded projectile texture: {} ({}x{})", filePath, region.width, region.height);
     spdlog::info("Projectile texture dimensions: {}x{} pixels, {} sprites per row, {} rows total", 
-                 width, height, width / spriteWidth, height / spriteHeight);
-    
-    textureWidth = width;
-    textureHeight = height;
-    
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Use NEAREST filtering for pixel-perfect graphics
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    
-    textureLoaded = true;
-    spdlog::debug("Projectile texture loaded successfully with ID: {}", textureID);
+                 region.width, region.height, region.width / spriteWidth, region.height / spriteHeight);
 }
 
 void Projectile::cleanupProjectileTexture() {
-    if (textureLoaded && textureID != 0) {
-        glDeleteTextures(1, &textureID);
-        textureID = 0;
-        textureLoaded = false;
-        spdlog::debug("Projectile texture cleaned up");
-    }
+    // The atlas owns the sheet textures, just forget the regions
+    playerSheet = INVALID_ATLAS_HANDLE;
+    eyeSheet = INVALID_ATLAS_HANDLE;
+    shroomSheet = INVALID_ATLAS_HANDLE;
+    spdlog::debug("Projectile texture cleaned up");
 }
 
 // Add new texture loading functions for eye and shroom projectiles
 void Projectile::loadEyeProjectileTexture(const std::string& filePath) {
-    if (eyeTextureLoaded) {
+    if (eyeSheet != INVALID_ATLAS_HANDLE) {
         spdlog::warn("Eye projectile texture already loaded");
         return;
     }
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    eyeSheet = TextureAtlas::shared().addImage(filePath);
+    if (eyeSheet == INVALID_ATLAS_HANDLE) {
         spdlog::error("Failed to load eye projectile texture: {}", filePath);
         return;
     }
-    eyeTextureWidth = width;
-    eyeTextureHeight = height;
-    glGenTextures(1, &eyeTextureID);
-    glBindTexture(GL_TEXTURE_2D, eyeTextureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    eyeTextureLoaded = true;
-    spdlog::info("Loaded eye projectile texture: {} ({}x{})", filePath, width, height);
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(eyeSheet);
+    spdlog::info("Loaded eye projectile texture: {} ({}x{})", filePath, region.width, region.height);
 }
 
 void Projectile::loadShroomProjectileTexture(const std::string& filePath) {
-    if (shroomTextureLoaded) {
+    if (shroomSheet != INVALID_ATLAS_HANDLE) {
         spdlog::warn("Shroom projectile texture already loaded");
         return;
     }
-    int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    shroomSheet = TextureAtlas::shared().addImage(filePath);
+    if (shroomSheet == INVALID_ATLAS_HANDLE) {
         spdlog::error("Failed to load shroom projectile texture: {}", filePath);
         return;
     }
-    shroomTextureWidth = width;
-    shroomTextureHeight = height;
-    glGenTextures(1, &shroomTextureID);
-    glBindTexture(GL_TEXTURE_2D, shroomTextureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    shroomTextureLoaded = true;
-    spdlog::info("Loaded shroom projectile texture: {} ({}x{})", filePath, width, height);
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(shroomSheet);
+    spdlog::info("Loaded shroom projectile texture: {} ({}x{})", filePath, region.width, region.height);
 }
 
 void Projectile::loadAllProjectileTextures() {
@@ -188,101 +119,74 @@ void Projectile::update(float deltaTime) {
     spdlog::debug("Projectile moved from ({}, {}) to ({}, {})", oldX, oldY, x, y);
 }
 
-void Projectile::draw() const {
-    if (!active) return;
-    
-    // Player projectile
-    if (type == ProjectileType::PlayerBullet && textureLoaded) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        int row = PLAYER_ROW;
-        int col = currentFrame % 5;  // 5 sprites per row in green_projectiles.png
-        float u1 = static_cast<float>(col * spriteWidth) / textureWidth;
-        float v1 = static_cast<float>(row * spriteHeight) / textureHeight;
-        float u2 = static_cast<float>((col + 1) * spriteWidth) / textureWidth;
-        float v2 = static_cast<float>((row + 1) * spriteHeight) / textureHeight;
-        bool facingRight = dx > 0;
-        if (!facingRight) std::swap(u1, u2);
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(x - spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v2); glVertex2f(x + spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v1); glVertex2f(x + spriteWidth/2, y + spriteHeight/2);
-        glTexCoord2f(u1, v1); glVertex2f(x - spriteWidth/2, y + spriteHeight/2);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDisable(GL_TEXTURE_2D);
-        return;
-    }
-    // Eye enemy projectile
-    if (type == ProjectileType::EnemyEyeBullet && eyeTextureLoaded) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, eyeTextureID);
-        int row = EYE_ROW;
-        int col = currentFrame % 5;  // 5 sprites per row in purple_projectiles.png
-        float u1 = static_cast<float>(col * spriteWidth) / eyeTextureWidth;
-        float v1 = static_cast<float>(row * spriteHeight) / eyeTextureHeight;
-        float u2 = static_cast<float>((col + 1) * spriteWidth) / eyeTextureWidth;
-        float v2 = static_cast<float>((row + 1) * spriteHeight) / eyeTextureHeight;
-        bool facingRight = dx > 0;
-        if (!facingRight) std::swap(u1, u2);
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(x - spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v2); glVertex2f(x + spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v1); glVertex2f(x + spriteWidth/2, y + spriteHeight/2);
-        glTexCoord2f(u1, v1); glVertex2f(x - spriteWidth/2, y + spriteHeight/2);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDisable(GL_TEXTURE_2D);
-        return;
-    }
-    // Shroom enemy projectile
-    if (type == ProjectileType::EnemyShroomBullet && shroomTextureLoaded) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, shroomTextureID);
-        int row = SHROOM_ROW;
-        int col = currentFrame % 5;  // 5 sprites per row in pink_projectiles.png
-        float u1 = static_cast<float>(col * spriteWidth) / shroomTextureWidth;
-        float v1 = static_cast<float>(row * spriteHeight) / shroomTextureHeight;
-        float u2 = static_cast<float>((col + 1) * spriteWidth) / shroomTextureWidth;
-        float v2 = static_cast<float>((row + 1) * spriteHeight) / shroomTextureHeight;
-        bool facingRight = dx > 0;
-        if (!facingRight) std::swap(u1, u2);
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glBegin(GL_QUADS);
-        glTexCoord2f(u1, v2); glVertex2f(x - spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v2); glVertex2f(x + spriteWidth/2, y - spriteHeight/2);
-        glTexCoord2f(u2, v1); glVertex2f(x + spriteWidth/2, y + spriteHeight/2);
-        glTexCoord2f(u1, v1); glVertex2f(x - spriteWidth/2, y + spriteHeight/2);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDisable(GL_TEXTURE_2D);
-        return;
+ProjectileSpriteInfo Projectile::getSpriteInfo(ProjectileType type) {
+    // Pick the sheet and row for this projectile type
+    AtlasHandle sheet = INVALID_ATLAS_HANDLE;
+    int row = 0;
+    if (type == ProjectileType::PlayerBullet) {
+        sheet = playerSheet;
+        row = PLAYER_ROW;
+    } else if (type == ProjectileType::EnemyEyeBullet) {
+        sheet = eyeSheet;
+        row = EYE_ROW;
+    } else if (type == ProjectileType::EnemyShroomBullet) {
+        sheet = shroomSheet;
+        row = SHROOM_ROW;
+    }
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(sheet);
+
+    ProjectileSpriteInfo info;
+    if (region.texture != 0) {
+        info.texture = region.texture;
+        info.u = region.mapU(0.0f);
+        info.v = region.mapV(static_cast<float>((row + 1) * spriteHeight) / region.height);
+        info.frameU = region.mapU(static_cast<float>(spriteWidth) / region.width) - info.u;
+        info.frameV = region.mapV(static_cast<float>(row * spriteHeight) / region.height) - info.v;
+        info.width = static_cast<float>(spriteWidth);
+        info.height = static_cast<float>(spriteHeight);
+        return info;
     }
-    // Fallback: circle for other enemy projectiles
-    glDisable(GL_TEXTURE_2D);
-    glColor3f(r, g, b);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(x, y);
-    for (int i = 0; i <= 16; i++) {
-        float angle = 2.0f * M_PI * i / 16.0f;
-        float px = x + radius * std::cos(angle);
-        float py = y + radius * std::sin(angle);
-        glVertex2f(px, py);
+
+    // Fallback: colored circle, green for the player and red for enemies
+    const float fallbackRadius = 4.0f;
+    info.width = fallbackRadius * 2.0f;
+    info.height = fallbackRadius * 2.0f;
+    if (type == ProjectileType::PlayerBullet) {
+        info.r = 0.0f; info.g = 1.0f; info.b = 0.0f;
+    } else {
+        info.r = 1.0f; info.g = 0.0f; info.b = 0.0f;
     }
-    glEnd();
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < 16; i++) {
-        float angle = 2.0f * M_PI * i / 16.0f;
-        float px = x + radius * std::cos(angle);
-        float py = y + radius * std::sin(angle);
-        glVertex2f(px, py);
+    return info;
+}
+
+void Projectile::draw(SpriteBatch& batch) const {
+    if (!active) return;
+
+    ProjectileSpriteInfo info = getSpriteInfo(type);
+
+    Sprite sprite;
+    sprite.layer = SpriteLayer::Projectile;
+    sprite.x = x - info.width / 2;
+    sprite.y = y - info.height / 2;
+    sprite.width = info.width;
+    sprite.height = info.height;
+
+    if (info.texture != 0) {
+        // All sheets share an atlas page, so projectiles of every type batch together
+        int col = currentFrame % FRAMES_PER_ROW;
+        sprite.texture = info.texture;
+        sprite.u1 = info.u + col * info.frameU;
+        sprite.v1 = info.v;
+        sprite.u2 = sprite.u1 + info.frameU;
+        sprite.v2 = info.v + info.frameV;
+        sprite.flipX = dx <= 0;
+    } else {
+        sprite.texture = batch.getCircleTexture();
+        sprite.r = info.r;
+        sprite.g = info.g;
+        sprite.b = info.b;
     }
-    glEnd();
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
+    batch.submit(sprite);
 }
 
 bool Projectile::checkCollision(float targetX, float targetY, float targetRadius) const {
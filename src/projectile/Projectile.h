@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include "render/TextureAtlas.h"
+
+class SpriteBatch;
 
 enum class ProjectileType {
     PlayerBullet,
@@ -8,13 +11,24 @@ enum class ProjectileType {
     EnemyShroomBullet  // For Shroom
 };
 
+// How a projectile type is drawn: a row of animation frames in its atlas
+// sheet, or a tinted disc when the type has no sheet
+struct ProjectileSpriteInfo {
+    GLuint texture = 0;           // Atlas page, 0 draws a disc in the tint color
+    float u = 0.0f, v = 0.0f;     // UV of the first frame's top-left corner
+    float frameU = 0.0f;          // UV width of one frame; frames run left to right
+    float frameV = 0.0f;          // UV height of one frame, negative since sheet rows are bottom-up
+    float width = 0.0f, height = 0.0f;  // Size in world units
+    float r = 1.0f, g = 1.0f, b = 1.0f;
+};
+
 class Projectile {
 public:
     Projectile(float x, float y, float dx, float dy, ProjectileType type);
     ~Projectile();
 
     void update(float deltaTime);
-    void draw() const;
+    void draw(SpriteBatch& batch) const;
     bool isActive() const { return active; }
     void setActive(bool isActive) { active = isActive; }
     
@@ -22,6 +36,9 @@ public:
     float getX() const { return x; }
     float getY() const { return y; }
     float getRadius() const { return radius; }
+    float getDirX() const { return dx; }
+    float getDirY() const { return dy; }
+    int getCurrentFrame() const { return currentFrame; }
     
     // Collision detection
     bool checkCollision(float targetX, float targetY, float targetRadius) const;
@@ -38,6 +55,9 @@ public:
     static void loadShroomProjectileTexture(const std::string& filePath);
     static void loadAllProjectileTextures();
 
+    // Valid once the shared atlas has been built
+    static ProjectileSpriteInfo getSpriteInfo(ProjectileType type);
+    static constexpr int FRAMES_PER_ROW = 5;  // Same in every projectile sheet
 private:
     float x, y;
     float dx, dy;  // Direction vector
@@ -48,26 +68,12 @@ private:
     bool active = true;
     ProjectileType type;
     
-    // Visual properties
-    float r, g, b;  // Color (fallback for enemy projectiles)
-    
-    // Static texture properties
-    static unsigned int textureID;
-    static int textureWidth;
-    static int textureHeight;
+    // Projectile sheets, packed into the shared atlas
+    static AtlasHandle playerSheet;
+    static AtlasHandle eyeSheet;
+    static AtlasHandle shroomSheet;
     static int spriteWidth;
     static int spriteHeight;
-    static bool textureLoaded;
-
-    // Additional textures for enemy projectiles
-    static unsigned int eyeTextureID;
-    static int eyeTextureWidth;
-    static int eyeTextureHeight;
-    static bool eyeTextureLoaded;
-    static unsigned int shroomTextureID;
-    static int shroomTextureWidth;
-    static int shroomTextureHeight;
-    static bool shroomTextureLoaded;
 
     // Sprite row info for each type
     static constexpr int PLAYER_ROW = 14; // 15th row (0-indexed)
@@ -0,0 +1,103 @@
+#include "projectile/ProjectileRenderer.h"
+#include "projectile/Projectile.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <string>
+
+namespace {
+    constexpr int PROJECTILE_TYPE_COUNT = 4;  // Entries in ProjectileType
+}
+
+ProjectileRenderer::ProjectileRenderer()
+    : InstancedQuadRenderer("projectiles"), atlasTexture(0), cullMargin(0.0f), lastInstanceCount(0) {
+}
+
+bool ProjectileRenderer::init() {
+#ifdef ORTOS_HAS_GL33
+    // One texture for every type, so all sheets must sit on the same atlas page
+    ProjectileSpriteInfo infos[PROJECTILE_TYPE_COUNT];
+    for (int type = 0; type < PROJECTILE_TYPE_COUNT; ++type) {
+        infos[type] = Projectile::getSpriteInfo(static_cast<ProjectileType>(type));
+        if (infos[type].texture == 0) continue;
+        if (atlasTexture != 0 && infos[type].texture != atlasTexture) {
+            spdlog::warn("Projectile sheets are split across atlas pages");
+            return false;
+        }
+        atlasTexture = infos[type].texture;
+        cullMargin = std::max({cullMargin, infos[type].width * 0.5f, infos[type].height * 0.5f});
+    }
+
+    const std::string& shaderDirectory = RenderBackend::getShaderDirectory();
+    if (!shader.buildFromFiles(shaderDirectory + "projectile_vertex_shader.glsl",
+                               shaderDirectory + "projectile_fragment_shader.glsl")) {
+        return false;
+    }
+
+    // Per-type cell layout never changes after the atlas is built
+    shader.use();
+    glUniform1i(shader.getUniformLocation("atlas"), 0);
+    for (int type = 0; type < PROJECTILE_TYPE_COUNT; ++type) {
+        const ProjectileSpriteInfo& info = infos[type];
+        std::string index = "[" + std::to_string(type) + "]";
+        glUniform4f(shader.getUniformLocation(("frameCell" + index).c_str()),
+                    info.u, info.v, info.frameU, info.frameV);
+        glUniform3f(shader.getUniformLocation(("spriteSize" + index).c_str()),
+                    info.width, info.height, info.texture == 0 ? 1.0f : 0.0f);
+        glUniform3f(shader.getUniformLocation(("tint" + index).c_str()), info.r, info.g, info.b);
+    }
+
+    createQuadArrays();
+    const GLsizei stride = sizeof(ProjectileInstance);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offsetof(ProjectileInstance, x)));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(offsetof(ProjectileInstance, type)));
+    glVertexAttribDivisor(2, 1);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ProjectileRenderer::begin(const ViewRect& cullRect) {
+    instances.clear();
+    this->cullRect = cullRect.expanded(cullMargin);
+}
+
+void ProjectileRenderer::add(const Projectile& projectile) {
+    if (!projectile.isActive()) return;
+
+    float x = projectile.getX();
+    float y = projectile.getY();
+    if (!cullRect.intersects(x, y, x, y)) return;
+
+    ProjectileInstance instance;
+    instance.x = x;
+    instance.y = y;
+    instance.dirX = projectile.getDirX();
+    instance.dirY = projectile.getDirY();
+    instance.type = static_cast<unsigned char>(projectile.getType());
+    instance.frame = static_cast<unsigned char>(projectile.getCurrentFrame() % Projectile::FRAMES_PER_ROW);
+    instance.padding[0] = instance.padding[1] = 0;
+    instances.push_back(instance);
+}
+
+void ProjectileRenderer::flush() {
+    lastInstanceCount = static_cast<int>(instances.size());
+#ifdef ORTOS_HAS_GL33
+    if (!available || instances.empty()) return;
+
+    uploadInstances(instances.data(), instances.size(), sizeof(ProjectileInstance));
+    beginDraw();
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::bindTexture(atlasTexture);
+    drawInstances(static_cast<GLsizei>(instances.size()));
+    endDraw();
+#endif
+    instances.clear();
+}
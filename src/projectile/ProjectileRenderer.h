@@ -0,0 +1,43 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <vector>
+#include "render/InstancedQuadRenderer.h"
+#include "render/ViewRect.h"
+
+class Projectile;
+
+// Draws all visible projectiles with a single instanced call. Each projectile
+// is uploaded as a small per-instance record and the vertex shader expands it
+// into a quad, picking the sheet cell from its type and animation frame.
+// isAvailable() must come after the shared atlas has been built.
+class ProjectileRenderer : public InstancedQuadRenderer {
+public:
+    ProjectileRenderer();
+
+    void begin(const ViewRect& cullRect);
+    void add(const Projectile& projectile);
+    void flush();
+
+    int getLastInstanceCount() const { return lastInstanceCount; }
+
+private:
+    struct ProjectileInstance {
+        float x, y;             // Center in world units
+        float dirX, dirY;       // Travel direction; sprites face left when dirX <= 0
+        unsigned char type;     // ProjectileType
+        unsigned char frame;    // Animation frame within the sheet row
+        unsigned char padding[2];
+    };
+
+    GLuint atlasTexture;
+
+    std::vector<ProjectileInstance> instances;
+    ViewRect cullRect;
+    float cullMargin;  // Half the largest sprite, so partly visible projectiles stay
+
+    int lastInstanceCount;
+
+    bool init() override;
+};
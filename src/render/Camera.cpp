@@ -0,0 +1,84 @@
+#include "render/Camera.h"
+#include "render/RenderBackend.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float MIN_ZOOM = 0.25f;
+    constexpr float MAX_ZOOM = 8.0f;
+}
+
+Camera::Camera()
+    : centerX(0.0f), centerY(0.0f),
+      viewWidth(0.0f), viewHeight(0.0f),
+      zoom(1.0f), followSharpness(8.0f),
+      hasBounds(false) {
+}
+
+void Camera::setViewSize(float width, float height) {
+    viewWidth = width;
+    viewHeight = height;
+    clampToBounds();
+}
+
+void Camera::setBounds(const ViewRect& bounds) {
+    this->bounds = bounds;
+    hasBounds = true;
+    clampToBounds();
+}
+
+void Camera::setZoom(float zoom) {
+    this->zoom = std::clamp(zoom, MIN_ZOOM, MAX_ZOOM);
+    clampToBounds();
+}
+
+void Camera::follow(float targetX, float targetY, float deltaTime) {
+    if (followSharpness <= 0.0f) {
+        centerOn(targetX, targetY);
+        return;
+    }
+
+    // Frame-rate independent exponential ease
+    float t = 1.0f - std::exp(-followSharpness * deltaTime);
+    centerX += (targetX - centerX) * t;
+    centerY += (targetY - centerY) * t;
+    clampToBounds();
+}
+
+void Camera::centerOn(float x, float y) {
+    centerX = x;
+    centerY = y;
+    clampToBounds();
+}
+
+ViewRect Camera::getViewRect() const {
+    float halfWidth = viewWidth * 0.5f / zoom;
+    float halfHeight = viewHeight * 0.5f / zoom;
+    return {centerX - halfWidth, centerY - halfHeight, centerX + halfWidth, centerY + halfHeight};
+}
+
+void Camera::apply() const {
+    ViewRect view = getViewRect();
+    RenderBackend::loadOrtho(view.left, view.right, view.bottom, view.top);
+}
+
+void Camera::clampToBounds() {
+    if (!hasBounds) return;
+
+    float halfWidth = viewWidth * 0.5f / zoom;
+    float halfHeight = viewHeight * 0.5f / zoom;
+
+    // A view larger than the level is centered on it instead
+    if (halfWidth * 2.0f >= bounds.right - bounds.left) {
+        centerX = (bounds.left + bounds.right) * 0.5f;
+    } else {
+        centerX = std::clamp(centerX, bounds.left + halfWidth, bounds.right - halfWidth);
+    }
+    if (halfHeight * 2.0f >= bounds.bottom - bounds.top) {
+        centerY = (bounds.top + bounds.bottom) * 0.5f;
+    } else {
+        centerY = std::clamp(centerY, bounds.top + halfHeight, bounds.bottom - halfHeight);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "render/ViewRect.h"
+
+// 2D camera over the game world. Follows a target, stays inside the level
+// bounds and produces the view rect used for projection and culling.
+class Camera {
+public:
+    Camera();
+
+    // Size of the region visible at zoom 1, in world units
+    void setViewSize(float width, float height);
+
+    // Keep the view inside these world bounds
+    void setBounds(const ViewRect& bounds);
+
+    // Values above 1 zoom in and show less of the world
+    void setZoom(float zoom);
+    float getZoom() const { return zoom; }
+
+    // Ease towards the target; call once per update
+    void follow(float targetX, float targetY, float deltaTime);
+
+    // Jump straight to a position, e.g. after loading a level
+    void centerOn(float x, float y);
+
+    ViewRect getViewRect() const;
+
+    // Load an orthographic projection covering the view rect
+    void apply() const;
+
+    float getCenterX() const { return centerX; }
+    float getCenterY() const { return centerY; }
+
+private:
+    float centerX, centerY;
+    float viewWidth, viewHeight;
+    float zoom;
+    float followSharpness;  // Higher catches up faster, 0 snaps to the target
+
+    ViewRect bounds;
+    bool hasBounds;
+
+    void clampToBounds();
+};
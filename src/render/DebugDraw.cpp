@@ -0,0 +1,122 @@
+#include "render/DebugDraw.h"
+
+#ifdef ORTOS_DEBUG_DRAW
+
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+    constexpr int CATEGORY_COUNT = static_cast<int>(DebugCategory::Count);
+    constexpr int CIRCLE_SEGMENTS = 24;
+
+    const char* const CATEGORY_NAMES[CATEGORY_COUNT] = {
+        "hitboxes", "collision tiles", "AI targets", "spatial grid"
+    };
+    const int TOGGLE_KEYS[CATEGORY_COUNT] = {
+        GLFW_KEY_F1, GLFW_KEY_F2, GLFW_KEY_F3, GLFW_KEY_F4
+    };
+
+    // Hitboxes were always visible before they became a category
+    bool enabledCategories[CATEGORY_COUNT] = {true, false, false, false};
+    bool toggleKeyDown[CATEGORY_COUNT] = {};
+
+    // Lines of one width; the backend sets the width per draw
+    struct LineBatch {
+        float width;
+        std::vector<LineVertex> vertices;
+    };
+    std::vector<LineBatch> batches;
+
+    std::vector<LineVertex>& batchFor(float width) {
+        for (LineBatch& batch : batches) {
+            if (batch.width == width) return batch.vertices;
+        }
+        batches.push_back({width, {}});
+        return batches.back().vertices;
+    }
+
+    int indexOf(DebugCategory category) {
+        return static_cast<int>(category);
+    }
+}
+
+void DebugDraw::setEnabled(DebugCategory category, bool enabled) {
+    enabledCategories[indexOf(category)] = enabled;
+}
+
+bool DebugDraw::isEnabled(DebugCategory category) {
+    return enabledCategories[indexOf(category)];
+}
+
+void DebugDraw::toggle(DebugCategory category) {
+    bool enabled = !isEnabled(category);
+    setEnabled(category, enabled);
+    spdlog::info("Debug draw {}: {}", CATEGORY_NAMES[indexOf(category)], enabled ? "on" : "off");
+}
+
+void DebugDraw::handleToggleKeys(GLFWwindow* window) {
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        bool down = glfwGetKey(window, TOGGLE_KEYS[i]) == GLFW_PRESS;
+        if (down && !toggleKeyDown[i]) {
+            toggle(static_cast<DebugCategory>(i));
+        }
+        toggleKeyDown[i] = down;
+    }
+}
+
+void DebugDraw::line(DebugCategory category, float x1, float y1, float x2, float y2,
+                     unsigned char r, unsigned char g, unsigned char b, unsigned char a, float width) {
+    if (!isEnabled(category)) return;
+    std::vector<LineVertex>& vertices = batchFor(width);
+    vertices.push_back({x1, y1, r, g, b, a});
+    vertices.push_back({x2, y2, r, g, b, a});
+}
+
+void DebugDraw::rect(DebugCategory category, float left, float top, float right, float bottom,
+                     unsigned char r, unsigned char g, unsigned char b, unsigned char a, float width) {
+    if (!isEnabled(category)) return;
+    std::vector<LineVertex>& vertices = batchFor(width);
+    const LineVertex corners[8] = {
+        {left, top, r, g, b, a},     {right, top, r, g, b, a},
+        {right, top, r, g, b, a},    {right, bottom, r, g, b, a},
+        {right, bottom, r, g, b, a}, {left, bottom, r, g, b, a},
+        {left, bottom, r, g, b, a},  {left, top, r, g, b, a},
+    };
+    vertices.insert(vertices.end(), corners, corners + 8);
+}
+
+void DebugDraw::circle(DebugCategory category, float centerX, float centerY, float radius,
+                       unsigned char r, unsigned char g, unsigned char b, unsigned char a, float width) {
+    if (!isEnabled(category)) return;
+    std::vector<LineVertex>& vertices = batchFor(width);
+    const float step = 2.0f * static_cast<float>(M_PI) / CIRCLE_SEGMENTS;
+    float previousX = centerX + radius;
+    float previousY = centerY;
+    for (int i = 1; i <= CIRCLE_SEGMENTS; ++i) {
+        float x = centerX + radius * std::cos(step * i);
+        float y = centerY + radius * std::sin(step * i);
+        vertices.push_back({previousX, previousY, r, g, b, a});
+        vertices.push_back({x, y, r, g, b, a});
+        previousX = x;
+        previousY = y;
+    }
+}
+
+void DebugDraw::flush() {
+    for (LineBatch& batch : batches) {
+        if (batch.vertices.empty()) continue;
+        RenderBackend::current().drawLines(batch.vertices.data(), static_cast<GLsizei>(batch.vertices.size()),
+                                           batch.width);
+        batch.vertices.clear();
+    }
+}
+
+void DebugDraw::clear() {
+    for (LineBatch& batch : batches) {
+        batch.vertices.clear();
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Groups of debug visuals that can be switched on and off while playing
+enum class DebugCategory {
+    Hitboxes = 0,    // Player and enemy bounding boxes
+    CollisionTiles,  // Solid tiles near the camera
+    AITargets,       // Enemy chase and shoot ranges, lines to the target
+    SpatialGrid,     // Tile map chunk boundaries
+    Count
+};
+
+#ifdef ORTOS_DEBUG_DRAW
+
+// Collects world-space debug lines during the frame and draws them in one
+// call per line width on flush(). Shapes in a disabled category are dropped
+// when queued. Builds without ORTOS_DEBUG_DRAW get the empty version below,
+// so the calls and anything behind isEnabled() compile away.
+class DebugDraw {
+public:
+    static void setEnabled(DebugCategory category, bool enabled);
+    static bool isEnabled(DebugCategory category);
+    static void toggle(DebugCategory category);
+
+    // F1-F4 toggle the categories in declaration order
+    static void handleToggleKeys(GLFWwindow* window);
+
+    static void line(DebugCategory category, float x1, float y1, float x2, float y2,
+                     unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255, float width = 1.0f);
+    static void rect(DebugCategory category, float left, float top, float right, float bottom,
+                     unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255, float width = 1.0f);
+    static void circle(DebugCategory category, float centerX, float centerY, float radius,
+                       unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255, float width = 1.0f);
+
+    // Draw everything queued since the last flush with the current projection
+    static void flush();
+    static void clear();
+};
+
+#else
+
+class DebugDraw {
+public:
+    static void setEnabled(DebugCategory, bool) {}
+    static constexpr bool isEnabled(DebugCategory) { return false; }
+    static void toggle(DebugCategory) {}
+    static void handleToggleKeys(GLFWwindow*) {}
+    static void line(DebugCategory, float, float, float, float,
+                     unsigned char, unsigned char, unsigned char, unsigned char = 255, float = 1.0f) {}
+    static void rect(DebugCategory, float, float, float, float,
+                     unsigned char, unsigned char, unsigned char, unsigned char = 255, float = 1.0f) {}
+    static void circle(DebugCategory, float, float, float,
+                       unsigned char, unsigned char, unsigned char, unsigned char = 255, float = 1.0f) {}
+    static void flush() {}
+    static void clear() {}
+};
+
+#endif
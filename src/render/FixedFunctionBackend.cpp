@@ -0,0 +1,118 @@
+#include "render/FixedFunctionBackend.h"
+#include "render/GLState.h"
+#include <cstddef>
+
+bool FixedFunctionBackend::init(const std::string& shaderDirectory) {
+    (void)shaderDirectory;
+    return true;
+}
+
+void FixedFunctionBackend::drawSprites(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture) {
+    GLState::useProgram(0);
+    if (texture != 0) {
+        GLState::enable(GL_TEXTURE_2D);
+        GLState::bindTexture(texture);
+    } else {
+        GLState::disable(GL_TEXTURE_2D);
+    }
+
+    const GLsizei stride = sizeof(SpriteVertex);
+    GLState::bindArrayBuffer(vertexBuffer);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, x)));
+    glTexCoordPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, u)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, r)));
+
+    GLState::drawArrays(GL_TRIANGLES, first, count);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::invalidateColor();  // Current color is undefined after a color array draw
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void FixedFunctionBackend::drawTextured(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture,
+                                        float r, float g, float b, float a) {
+    GLState::useProgram(0);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(texture);
+    GLState::color(r, g, b, a);
+
+    const GLsizei stride = sizeof(TexturedVertex);
+    GLState::bindArrayBuffer(vertexBuffer);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(offsetof(TexturedVertex, x)));
+    glTexCoordPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(offsetof(TexturedVertex, u)));
+
+    GLState::drawArrays(GL_TRIANGLES, first, count);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void FixedFunctionBackend::drawTileArray(GLuint, GLint, GLsizei, GLuint) {
+    // Unreachable, supportsTextureArrays() is false
+}
+
+void FixedFunctionBackend::drawTileLayer(const TileLayerDraw&) {
+    // Unreachable, supportsTextureArrays() is false
+}
+
+void FixedFunctionBackend::drawLines(const LineVertex* vertices, GLsizei count, float width) {
+    GLState::useProgram(0);
+    GLState::bindArrayBuffer(0);  // Pointers below are client memory
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::lineWidth(width);
+
+    const GLsizei stride = sizeof(LineVertex);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, stride, &vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, stride, &vertices[0].r);
+
+    GLState::drawArrays(GL_LINES, 0, count);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    GLState::lineWidth(1.0f);
+    GLState::invalidateColor();
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+void FixedFunctionBackend::drawFullscreenTexture(GLuint texture) {
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::bindTexture(texture);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+    GLState::begin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(1.0f, 0.0f); glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(1.0f, 1.0f); glVertex2f(1.0f, 1.0f);
+    glTexCoord2f(0.0f, 1.0f); glVertex2f(-1.0f, 1.0f);
+    glEnd();
+    GLState::disable(GL_TEXTURE_2D);
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+}
+
+void FixedFunctionBackend::drawBlurredTexture(GLuint texture, float texelX, float texelY) {
+    (void)texelX;
+    (void)texelY;
+    drawFullscreenTexture(texture);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "render/RenderBackend.h"
+
+// Draws through client arrays and the fixed-function pipeline. Works on any
+// context, including the legacy 2.1 context macOS hands out.
+class FixedFunctionBackend : public RenderBackend {
+public:
+    RenderBackendType getType() const override { return RenderBackendType::FixedFunction; }
+    const char* getName() const override { return "fixed function"; }
+
+    void drawSprites(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture) override;
+    void drawTextured(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture,
+                      float r, float g, float b, float a) override;
+    bool supportsTextureArrays() const override { return false; }
+    void drawTileArray(GLuint vertexBuffer, GLint first, GLsizei count, GLuint textureArray) override;
+    void drawTileLayer(const TileLayerDraw& layer) override;
+    void drawLines(const LineVertex* vertices, GLsizei count, float width) override;
+    void drawFullscreenTexture(GLuint texture) override;
+    bool supportsBlur() const override { return false; }
+    void drawBlurredTexture(GLuint texture, float texelX, float texelY) override;
+
+protected:
+    bool init(const std::string& shaderDirectory) override;
+};
@@ -0,0 +1,287 @@
+#include "render/GL33Backend.h"
+#include "render/GLState.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+GL33Backend::GL33Backend()
+    : spriteUseTextureLocation(-1), textTintLocation(-1), blurTexelStepLocation(-1),
+      tileLayerAreaLocation(-1), tileLayerTileSizeLocation(-1), tileLayerOriginLocation(-1), tileLayerMapLayerLocation(-1), tileLayerTimeLocation(-1),
+      spriteVertexArray(0), texturedVertexArray(0), tileVertexArray(0), lineVertexArray(0), postVertexArray(0),
+      lineBuffer(0), lineBufferCapacity(0), projectionBuffer(0) {
+}
+
+GL33Backend::~GL33Backend() {
+    release();
+}
+
+#ifdef ORTOS_HAS_GL33
+
+bool GL33Backend::init(const std::string& shaderDirectory) {
+    if (!supportsGLVersion(3, 3)) {
+        spdlog::warn("OpenGL 3.3 backend needs a 3.3 context, got {}",
+                     reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+        return false;
+    }
+
+    if (!spriteProgram.buildFromFiles(shaderDirectory + "sprite_vertex_shader.glsl",
+                                      shaderDirectory + "sprite_fragment_shader.glsl") ||
+        !textProgram.buildFromFiles(shaderDirectory + "text_vertex_shader.glsl",
+                                    shaderDirectory + "text_fragment_shader.glsl") ||
+        !tileProgram.buildFromFiles(shaderDirectory + "tile_vertex_shader.glsl",
+                                    shaderDirectory + "tile_fragment_shader.glsl") ||
+        !tileLayerProgram.buildFromFiles(shaderDirectory + "tile_layer_vertex_shader.glsl",
+                                         shaderDirectory + "tile_layer_fragment_shader.glsl") ||
+        !lineProgram.buildFromFiles(shaderDirectory + "line_vertex_shader.glsl",
+                                    shaderDirectory + "line_fragment_shader.glsl") ||
+        !postProgram.buildFromFiles(shaderDirectory + "post_vertex_shader.glsl",
+                                    shaderDirectory + "post_fragment_shader.glsl") ||
+        !blurProgram.buildFromFiles(shaderDirectory + "post_vertex_shader.glsl",
+                                    shaderDirectory + "blur_fragment_shader.glsl")) {
+        release();
+        return false;
+    }
+
+    spriteProgram.use();
+    glUniform1i(spriteProgram.getUniformLocation("spriteTexture"), 0);
+    spriteUseTextureLocation = spriteProgram.getUniformLocation("useTexture");
+    textProgram.use();
+    glUniform1i(textProgram.getUniformLocation("glyphTexture"), 0);
+    textTintLocation = textProgram.getUniformLocation("tint");
+    tileProgram.use();
+    glUniform1i(tileProgram.getUniformLocation("tileTexture"), 0);
+    tileLayerProgram.use();
+    glUniform1i(tileLayerProgram.getUniformLocation("tileTexture"), 0);
+    glUniform1i(tileLayerProgram.getUniformLocation("tileIndices"), TILE_INDEX_UNIT);
+    glUniform1i(tileLayerProgram.getUniformLocation("tileAnimations"), TILE_ANIMATION_UNIT);
+    tileLayerAreaLocation = tileLayerProgram.getUniformLocation("area");
+    tileLayerTileSizeLocation = tileLayerProgram.getUniformLocation("tileSize");
+    tileLayerOriginLocation = tileLayerProgram.getUniformLocation("origin");
+    tileLayerMapLayerLocation = tileLayerProgram.getUniformLocation("mapLayer");
+    tileLayerTimeLocation = tileLayerProgram.getUniformLocation("timeMs");
+    postProgram.use();
+    glUniform1i(postProgram.getUniformLocation("sceneTexture"), 0);
+    blurProgram.use();
+    glUniform1i(blurProgram.getUniformLocation("sceneTexture"), 0);
+    blurTexelStepLocation = blurProgram.getUniformLocation("texelStep");
+    GLState::useProgram(0);
+
+    spriteProgram.bindUniformBlock("Projection", PROJECTION_BINDING);
+    textProgram.bindUniformBlock("Projection", PROJECTION_BINDING);
+    tileProgram.bindUniformBlock("Projection", PROJECTION_BINDING);
+    tileLayerProgram.bindUniformBlock("Projection", PROJECTION_BINDING);
+    lineProgram.bindUniformBlock("Projection", PROJECTION_BINDING);
+
+    glGenBuffers(1, &projectionBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, projectionBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(projection), projection, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, PROJECTION_BINDING, projectionBuffer);
+
+    // Attribute pointers are set per draw since callers own the buffers,
+    // the VAOs only remember which attributes are enabled
+    glGenVertexArrays(1, &spriteVertexArray);
+    glBindVertexArray(spriteVertexArray);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    glGenVertexArrays(1, &texturedVertexArray);
+    glBindVertexArray(texturedVertexArray);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    glGenVertexArrays(1, &tileVertexArray);
+    glBindVertexArray(tileVertexArray);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    glGenBuffers(1, &lineBuffer);
+    glGenVertexArrays(1, &lineVertexArray);
+    glBindVertexArray(lineVertexArray);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    // The post-process pass and tile layers generate their vertices from gl_VertexID
+    glGenVertexArrays(1, &postVertexArray);
+    glBindVertexArray(0);
+    return true;
+}
+
+void GL33Backend::release() {
+    spriteProgram.release();
+    textProgram.release();
+    tileProgram.release();
+    tileLayerProgram.release();
+    lineProgram.release();
+    postProgram.release();
+    blurProgram.release();
+
+    GLuint vertexArrays[] = {spriteVertexArray, texturedVertexArray, tileVertexArray, lineVertexArray, postVertexArray};
+    for (GLuint vertexArray : vertexArrays) {
+        if (vertexArray != 0) {
+            glDeleteVertexArrays(1, &vertexArray);
+        }
+    }
+    spriteVertexArray = texturedVertexArray = tileVertexArray = lineVertexArray = postVertexArray = 0;
+
+    if (lineBuffer != 0) {
+        GLState::deleteBuffers(1, &lineBuffer);
+        lineBuffer = 0;
+    }
+    lineBufferCapacity = 0;
+    if (projectionBuffer != 0) {
+        GLState::deleteBuffers(1, &projectionBuffer);
+        projectionBuffer = 0;
+    }
+}
+
+void GL33Backend::setProjection(const float* matrix) {
+    if (std::memcmp(matrix, projection, sizeof(projection)) == 0) {
+        return;
+    }
+    RenderBackend::setProjection(matrix);
+    if (projectionBuffer == 0) return;
+    glBindBuffer(GL_UNIFORM_BUFFER, projectionBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(projection), projection);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void GL33Backend::drawSprites(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture) {
+    spriteProgram.use();
+    glUniform1i(spriteUseTextureLocation, texture != 0 ? 1 : 0);
+    if (texture != 0) {
+        // Untextured runs leave the last texture bound; the shader ignores it
+        GLState::bindTexture(texture);
+    }
+
+    const GLsizei stride = sizeof(SpriteVertex);
+    glBindVertexArray(spriteVertexArray);
+    GLState::bindArrayBuffer(vertexBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, u)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<const void*>(offsetof(SpriteVertex, r)));
+
+    GLState::drawArrays(GL_TRIANGLES, first, count);
+
+    // Program, texture and buffer stay bound for the next run; immediate-mode
+    // drawing switches back to fixed function through GLState::begin
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawTextured(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture,
+                               float r, float g, float b, float a) {
+    textProgram.use();
+    glUniform4f(textTintLocation, r, g, b, a);
+    GLState::bindTexture(texture);
+
+    const GLsizei stride = sizeof(TexturedVertex);
+    glBindVertexArray(texturedVertexArray);
+    GLState::bindArrayBuffer(vertexBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(TexturedVertex, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(TexturedVertex, u)));
+
+    GLState::drawArrays(GL_TRIANGLES, first, count);
+
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawTileArray(GLuint vertexBuffer, GLint first, GLsizei count, GLuint textureArray) {
+    tileProgram.use();
+    GLState::bindTextureArray(textureArray);
+
+    const GLsizei stride = sizeof(TileVertex);
+    glBindVertexArray(tileVertexArray);
+    GLState::bindArrayBuffer(vertexBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(TileVertex, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(TileVertex, u)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(TileVertex, layer)));
+
+    GLState::drawArrays(GL_TRIANGLES, first, count);
+
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawTileLayer(const TileLayerDraw& layer) {
+    tileLayerProgram.use();
+    glUniform4f(tileLayerAreaLocation, layer.left, layer.top, layer.right, layer.bottom);
+    glUniform2f(tileLayerTileSizeLocation, layer.tileWidth, layer.tileHeight);
+    glUniform2f(tileLayerOriginLocation, layer.originX, layer.originY);
+    glUniform1i(tileLayerMapLayerLocation, layer.mapLayer);
+    glUniform1ui(tileLayerTimeLocation, layer.timeMs);
+
+    // Only unit 0 is tracked by GLState, the lookup textures go on their own units
+    glActiveTexture(GL_TEXTURE0 + TILE_INDEX_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, layer.indexTexture);
+    glActiveTexture(GL_TEXTURE0 + TILE_ANIMATION_UNIT);
+    glBindTexture(GL_TEXTURE_2D, layer.animationTexture);
+    glActiveTexture(GL_TEXTURE0);
+    GLState::bindTextureArray(layer.tileArray);
+
+    glBindVertexArray(postVertexArray);
+    GLState::drawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawLines(const LineVertex* vertices, GLsizei count, float width) {
+    if (count <= 0) return;
+    lineProgram.use();
+
+    // Lines come from client memory, so stream them through our own buffer
+    GLState::bindArrayBuffer(lineBuffer);
+    if (static_cast<size_t>(count) > lineBufferCapacity) {
+        lineBufferCapacity = std::max(static_cast<size_t>(count), lineBufferCapacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, lineBufferCapacity * sizeof(LineVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(LineVertex), vertices);
+
+    const GLsizei stride = sizeof(LineVertex);
+    glBindVertexArray(lineVertexArray);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(LineVertex, x)));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<const void*>(offsetof(LineVertex, r)));
+
+    // Wide lines only exist in compatibility contexts; core clamps to 1
+    GLState::lineWidth(width);
+    GLState::drawArrays(GL_LINES, 0, count);
+    GLState::lineWidth(1.0f);
+
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawFullscreenTexture(GLuint texture) {
+    postProgram.use();
+    GLState::bindTexture(texture);
+    glBindVertexArray(postVertexArray);
+    GLState::drawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+}
+
+void GL33Backend::drawBlurredTexture(GLuint texture, float texelX, float texelY) {
+    blurProgram.use();
+    glUniform2f(blurTexelStepLocation, texelX, texelY);
+    GLState::bindTexture(texture);
+    glBindVertexArray(postVertexArray);
+    GLState::drawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+}
+
+#else
+
+bool GL33Backend::init(const std::string& shaderDirectory) {
+    (void)shaderDirectory;
+    spdlog::warn("OpenGL 3.3 backend is not available on this platform");
+    return false;
+}
+
+void GL33Backend::release() {}
+void GL33Backend::setProjection(const float* matrix) { RenderBackend::setProjection(matrix); }
+void GL33Backend::drawSprites(GLuint, GLint, GLsizei, GLuint) {}
+void GL33Backend::drawTextured(GLuint, GLint, GLsizei, GLuint, float, float, float, float) {}
+void GL33Backend::drawTileArray(GLuint, GLint, GLsizei, GLuint) {}
+void GL33Backend::drawTileLayer(const TileLayerDraw&) {}
+void GL33Backend::drawLines(const LineVertex*, GLsizei, float) {}
+void GL33Backend::drawFullscreenTexture(GLuint) {}
+void GL33Backend::drawBlurredTexture(GLuint, float, float) {}
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+#include "render/RenderBackend.h"
+#include "render/ShaderProgram.h"
+#include <cstddef>
+
+// Shader-based backend written against the OpenGL 3.3 core API: one program
+// per vertex layout, a VAO each, and the projection in a uniform buffer
+// shared by all programs. Shaders are loaded from the shaders/ directory.
+class GL33Backend : public RenderBackend {
+public:
+    GL33Backend();
+    ~GL33Backend() override;
+
+    RenderBackendType getType() const override { return RenderBackendType::GL33; }
+    const char* getName() const override { return "OpenGL 3.3"; }
+
+    void drawSprites(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture) override;
+    void drawTextured(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture,
+                      float r, float g, float b, float a) override;
+    bool supportsTextureArrays() const override { return true; }
+    void drawTileArray(GLuint vertexBuffer, GLint first, GLsizei count, GLuint textureArray) override;
+    void drawTileLayer(const TileLayerDraw& layer) override;
+    void drawLines(const LineVertex* vertices, GLsizei count, float width) override;
+    void drawFullscreenTexture(GLuint texture) override;
+    bool supportsBlur() const override { return true; }
+    void drawBlurredTexture(GLuint texture, float texelX, float texelY) override;
+
+    // Uploads the uniform buffer when the matrix changed
+    void setProjection(const float* matrix) override;
+
+protected:
+    bool init(const std::string& shaderDirectory) override;
+
+private:
+    static constexpr GLint TILE_INDEX_UNIT = 1;
+    static constexpr GLint TILE_ANIMATION_UNIT = 2;
+
+    ShaderProgram spriteProgram;
+    ShaderProgram textProgram;
+    ShaderProgram tileProgram;
+    ShaderProgram tileLayerProgram;
+    ShaderProgram lineProgram;
+    ShaderProgram postProgram;
+    ShaderProgram blurProgram;
+
+    GLint spriteUseTextureLocation;
+    GLint textTintLocation;
+    GLint blurTexelStepLocation;
+    GLint tileLayerAreaLocation;
+    GLint tileLayerTileSizeLocation;
+    GLint tileLayerOriginLocation;
+    GLint tileLayerMapLayerLocation;
+    GLint tileLayerTimeLocation;
+
+    GLuint spriteVertexArray;
+    GLuint texturedVertexArray;
+    GLuint tileVertexArray;
+    GLuint lineVertexArray;
+    GLuint postVertexArray;
+
+    GLuint lineBuffer;
+    size_t lineBufferCapacity;  // In vertices
+
+    GLuint projectionBuffer;
+
+    void release();
+};
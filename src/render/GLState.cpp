@@ -0,0 +1,293 @@
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <array>
+#include <cstring>
+
+namespace {
+    // Capabilities are tracked by value; anything not listed passes straight through
+    constexpr std::array<GLenum, 4> TRACKED_CAPABILITIES = {
+        GL_BLEND, GL_TEXTURE_2D, GL_DEPTH_TEST, GL_SCISSOR_TEST
+    };
+
+    enum class Known : unsigned char { Unknown, Off, On };
+
+    struct CachedState {
+        std::array<Known, TRACKED_CAPABILITIES.size()> capabilities{};
+        bool blendKnown = false;
+        GLenum blendSource = 0, blendDestination = 0;
+        GLenum blendSourceAlpha = 0, blendDestinationAlpha = 0;
+        bool lineWidthKnown = false;
+        GLfloat lineWidth = 1.0f;
+        bool textureKnown = false;
+        GLuint texture = 0;
+        bool textureArrayKnown = false;
+        GLuint textureArray = 0;
+        bool arrayBufferKnown = false;
+        GLuint arrayBuffer = 0;
+        bool programKnown = false;
+        GLuint program = 0;
+        bool framebufferKnown = false;
+        GLuint framebuffer = 0;
+        bool viewportKnown = false;
+        GLint viewport[4] = {0, 0, 0, 0};
+        bool colorKnown = false;
+        GLfloat color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+        GLState::FrameStats frame;
+        GLState::FrameStats lastFrame;
+    };
+
+    CachedState& state() {
+        static CachedState cached;
+        return cached;
+    }
+
+    int capabilityIndex(GLenum capability) {
+        for (size_t i = 0; i < TRACKED_CAPABILITIES.size(); ++i) {
+            if (TRACKED_CAPABILITIES[i] == capability) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    void setCapability(GLenum capability, bool on) {
+        CachedState& s = state();
+        int index = capabilityIndex(capability);
+        Known wanted = on ? Known::On : Known::Off;
+        if (index >= 0 && s.capabilities[index] == wanted) {
+            ++s.frame.redundantSkipped;
+            return;
+        }
+        if (on) glEnable(capability);
+        else glDisable(capability);
+        if (index >= 0) s.capabilities[index] = wanted;
+        ++s.frame.stateChanges;
+    }
+}
+
+void GLState::enable(GLenum capability) {
+    setCapability(capability, true);
+}
+
+void GLState::disable(GLenum capability) {
+    setCapability(capability, false);
+}
+
+void GLState::blendFunc(GLenum source, GLenum destination) {
+    blendFuncSeparate(source, destination, source, destination);
+}
+
+void GLState::blendFuncSeparate(GLenum source, GLenum destination,
+                                GLenum sourceAlpha, GLenum destinationAlpha) {
+    CachedState& s = state();
+    if (s.blendKnown && s.blendSource == source && s.blendDestination == destination &&
+        s.blendSourceAlpha == sourceAlpha && s.blendDestinationAlpha == destinationAlpha) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    if (source == sourceAlpha && destination == destinationAlpha) {
+        glBlendFunc(source, destination);
+    } else {
+        glBlendFuncSeparate(source, destination, sourceAlpha, destinationAlpha);
+    }
+    s.blendKnown = true;
+    s.blendSource = source;
+    s.blendDestination = destination;
+    s.blendSourceAlpha = sourceAlpha;
+    s.blendDestinationAlpha = destinationAlpha;
+    ++s.frame.stateChanges;
+}
+
+void GLState::lineWidth(GLfloat width) {
+    CachedState& s = state();
+    if (s.lineWidthKnown && s.lineWidth == width) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glLineWidth(width);
+    s.lineWidthKnown = true;
+    s.lineWidth = width;
+    ++s.frame.stateChanges;
+}
+
+void GLState::bindTexture(GLuint texture) {
+    CachedState& s = state();
+    if (s.textureKnown && s.texture == texture) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, texture);
+    s.textureKnown = true;
+    s.texture = texture;
+    ++s.frame.textureBinds;
+}
+
+void GLState::bindTextureArray(GLuint texture) {
+    CachedState& s = state();
+    if (s.textureArrayKnown && s.textureArray == texture) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    s.textureArrayKnown = true;
+    s.textureArray = texture;
+    ++s.frame.textureBinds;
+}
+
+void GLState::bindArrayBuffer(GLuint buffer) {
+    CachedState& s = state();
+    if (s.arrayBufferKnown && s.arrayBuffer == buffer) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    s.arrayBufferKnown = true;
+    s.arrayBuffer = buffer;
+    ++s.frame.stateChanges;
+}
+
+void GLState::useProgram(GLuint program) {
+    CachedState& s = state();
+    if (s.programKnown && s.program == program) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glUseProgram(program);
+    s.programKnown = true;
+    s.program = program;
+    ++s.frame.stateChanges;
+}
+
+void GLState::bindFramebuffer(GLuint framebuffer) {
+    CachedState& s = state();
+    if (s.framebufferKnown && s.framebuffer == framebuffer) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    s.framebufferKnown = true;
+    s.framebuffer = framebuffer;
+    ++s.frame.framebufferBinds;
+}
+
+GLuint GLState::getFramebuffer() {
+    return state().framebuffer;
+}
+
+void GLState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    CachedState& s = state();
+    const GLint wanted[4] = {x, y, width, height};
+    if (s.viewportKnown && std::memcmp(s.viewport, wanted, sizeof(wanted)) == 0) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glViewport(x, y, width, height);
+    s.viewportKnown = true;
+    std::memcpy(s.viewport, wanted, sizeof(wanted));
+    ++s.frame.stateChanges;
+}
+
+void GLState::getViewport(GLint* viewport) {
+    std::memcpy(viewport, state().viewport, sizeof(state().viewport));
+}
+
+void GLState::color(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    CachedState& s = state();
+    const GLfloat wanted[4] = {r, g, b, a};
+    if (s.colorKnown && std::memcmp(s.color, wanted, sizeof(wanted)) == 0) {
+        ++s.frame.redundantSkipped;
+        return;
+    }
+    glColor4f(r, g, b, a);
+    s.colorKnown = true;
+    std::memcpy(s.color, wanted, sizeof(wanted));
+    ++s.frame.stateChanges;
+}
+
+void GLState::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    glDrawArrays(mode, first, count);
+    ++state().frame.drawCalls;
+}
+
+void GLState::drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+#ifdef ORTOS_HAS_GL33
+    glDrawArraysInstanced(mode, first, count, instanceCount);
+    ++state().frame.drawCalls;
+#else
+    (void)mode; (void)first; (void)count; (void)instanceCount;
+#endif
+}
+
+void GLState::begin(GLenum mode) {
+    useProgram(0);
+    glBegin(mode);
+    ++state().frame.drawCalls;
+}
+
+void GLState::deleteTextures(GLsizei count, const GLuint* textures) {
+    CachedState& s = state();
+    for (GLsizei i = 0; i < count; ++i) {
+        if (s.textureKnown && s.texture == textures[i]) {
+            s.texture = 0;  // GL reverts deleted bindings to 0
+        }
+        if (s.textureArrayKnown && s.textureArray == textures[i]) {
+            s.textureArray = 0;
+        }
+    }
+    glDeleteTextures(count, textures);
+}
+
+void GLState::deleteBuffers(GLsizei count, const GLuint* buffers) {
+    CachedState& s = state();
+    for (GLsizei i = 0; i < count; ++i) {
+        if (s.arrayBufferKnown && s.arrayBuffer == buffers[i]) {
+            s.arrayBuffer = 0;
+        }
+    }
+    glDeleteBuffers(count, buffers);
+}
+
+void GLState::deleteProgram(GLuint program) {
+    // A program in use is only flagged for deletion, so switch away first
+    if (program != 0 && state().programKnown && state().program == program) {
+        useProgram(0);
+    }
+    glDeleteProgram(program);
+}
+
+void GLState::deleteFramebuffers(GLsizei count, const GLuint* framebuffers) {
+    CachedState& s = state();
+    for (GLsizei i = 0; i < count; ++i) {
+        if (s.framebuffer == framebuffers[i]) {
+            s.framebuffer = 0;  // Deleting the bound framebuffer rebinds the window
+        }
+    }
+    glDeleteFramebuffers(count, framebuffers);
+}
+
+void GLState::invalidateColor() {
+    state().colorKnown = false;
+}
+
+void GLState::invalidate() {
+    CachedState& s = state();
+    s.capabilities.fill(Known::Unknown);
+    s.blendKnown = false;
+    s.lineWidthKnown = false;
+    s.textureKnown = false;
+    s.textureArrayKnown = false;
+    s.arrayBufferKnown = false;
+    s.programKnown = false;
+    s.framebufferKnown = false;
+    s.viewportKnown = false;
+    s.colorKnown = false;
+}
+
+void GLState::beginFrame() {
+    CachedState& s = state();
+    s.lastFrame = s.frame;
+    s.frame = FrameStats();
+}
+
+const GLState::FrameStats& GLState::getLastFrameStats() {
+    return state().lastFrame;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Thin tracker in front of the GL state the game toggles most: capabilities,
+// blend function, the bound 2D and array textures, array buffer, program and
+// framebuffer, the viewport, line width and the current color. Calls that
+// wouldn't change anything are dropped before they reach the driver, and
+// every call is counted per frame.
+//
+// The cache is only correct while all code changes this state through here.
+// Anything that changes it behind the tracker's back (deleting a bound
+// object, color arrays, third-party code) has to call the matching
+// invalidate function.
+class GLState {
+public:
+    struct FrameStats {
+        int drawCalls = 0;         // glDrawArrays*, plus one per glBegin/glEnd pair
+        int textureBinds = 0;      // Binds that reached the driver
+        int framebufferBinds = 0;  // Render target switches that reached the driver
+        int stateChanges = 0;      // Other state calls that reached the driver
+        int redundantSkipped = 0;  // Calls dropped because nothing would change
+    };
+
+    static void enable(GLenum capability);
+    static void disable(GLenum capability);
+    static void blendFunc(GLenum source, GLenum destination);
+    static void blendFuncSeparate(GLenum source, GLenum destination,
+                                  GLenum sourceAlpha, GLenum destinationAlpha);
+    static void lineWidth(GLfloat width);
+
+    // Binds to GL_TEXTURE_2D on the active texture unit
+    static void bindTexture(GLuint texture);
+    // Binds to GL_TEXTURE_2D_ARRAY, tracked separately from the 2D binding
+    static void bindTextureArray(GLuint texture);
+    static void bindArrayBuffer(GLuint buffer);
+    static void useProgram(GLuint program);
+
+    // Binds to GL_FRAMEBUFFER; 0 is the window
+    static void bindFramebuffer(GLuint framebuffer);
+    static GLuint getFramebuffer();
+
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    // The last viewport set through viewport(), x, y, width and height
+    static void getViewport(GLint* viewport);
+
+    static void color(GLfloat r, GLfloat g, GLfloat b, GLfloat a = 1.0f);
+
+    static void drawArrays(GLenum mode, GLint first, GLsizei count);
+    static void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount);
+
+    // glBegin for immediate-mode drawing. Unbinds any shader program first,
+    // since immediate mode relies on the fixed-function pipeline.
+    static void begin(GLenum mode);
+
+    // Delete objects and forget them if they were bound, so a recycled name
+    // isn't mistaken for the one already bound
+    static void deleteTextures(GLsizei count, const GLuint* textures);
+    static void deleteBuffers(GLsizei count, const GLuint* buffers);
+    static void deleteProgram(GLuint program);
+    static void deleteFramebuffers(GLsizei count, const GLuint* framebuffers);
+
+    // The current color is undefined after drawing with a color array
+    static void invalidateColor();
+    // Forget everything, e.g. after creating a context
+    static void invalidate();
+
+    // Close the current frame's counters and start new ones
+    static void beginFrame();
+    static const FrameStats& getLastFrameStats();
+};
@@ -0,0 +1,219 @@
+#include "render/GpuProfiler.h"
+#include "render/RenderBackend.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    double nowMs() {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+GpuProfiler::GpuProfiler()
+    : supported(false), enabled(false), frameOpen(false), activePass(-1), currentSlot(0),
+      frameNumber(0), droppedFrames(0), startTime(0.0) {
+}
+
+GpuProfiler& GpuProfiler::shared() {
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+bool GpuProfiler::init() {
+#ifdef ORTOS_HAS_GL33
+    // Timer queries are core in 3.3
+    supported = RenderBackend::supportsGLVersion(3, 3);
+#endif
+    if (!supported) {
+        spdlog::warn("GPU timer queries not available, GPU profiling disabled");
+        enabled = false;
+        return false;
+    }
+    startTime = nowMs();
+    return true;
+}
+
+void GpuProfiler::setEnabled(bool enabled) {
+    if (!enabled) {
+        endPass();
+        frameOpen = false;
+    }
+    this->enabled = enabled && supported;
+}
+
+int GpuProfiler::findPass(const char* name) {
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if (passes[i].name == name) return static_cast<int>(i);
+    }
+    passes.emplace_back();
+    passes.back().name = name;
+    return static_cast<int>(passes.size() - 1);
+}
+
+#ifdef ORTOS_HAS_GL33
+
+void GpuProfiler::release() {
+    endPass();
+    frameOpen = false;
+    for (FrameQueries& frame : slots) {
+        if (!frame.pool.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.pool.size()), frame.pool.data());
+        }
+        frame.pool.clear();
+        frame.recorded.clear();
+    }
+}
+
+void GpuProfiler::beginFrame() {
+    if (!enabled) return;
+    endPass();
+
+    // The slot about to be reused was recorded FRAME_LATENCY frames ago
+    currentSlot = (currentSlot + 1) % FRAME_LATENCY;
+    FrameQueries& frame = slots[currentSlot];
+    if (!frame.recorded.empty() && !collect(frame)) {
+        ++droppedFrames;
+    }
+    frame.recorded.clear();
+    frame.frameNumber = ++frameNumber;
+    frame.cpuStartMs = nowMs() - startTime;
+    frameOpen = true;
+}
+
+void GpuProfiler::beginPass(const char* name) {
+    if (!enabled || !frameOpen) return;
+    endPass();
+
+    FrameQueries& frame = slots[currentSlot];
+    if (frame.recorded.size() == frame.pool.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        frame.pool.push_back(query);
+    }
+    GLuint query = frame.pool[frame.recorded.size()];
+    activePass = findPass(name);
+    frame.recorded.push_back({activePass, query});
+    glBeginQuery(GL_TIME_ELAPSED, query);
+}
+
+void GpuProfiler::endPass() {
+    if (activePass < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    activePass = -1;
+}
+
+bool GpuProfiler::collect(FrameQueries& frame) {
+    // Queries finish in submission order, so the last one speaks for all
+    GLint available = 0;
+    glGetQueryObjectiv(frame.recorded.back().query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    FrameRecord record{frame.frameNumber, frame.cpuStartMs, {}};
+    for (const PassQuery& pass : frame.recorded) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(pass.query, GL_QUERY_RESULT, &elapsed);
+        double ms = static_cast<double>(elapsed) / 1.0e6;
+
+        PassHistory& history = passes[pass.pass];
+        history.lastMs = ms;
+        history.samples[history.next] = ms;
+        history.next = (history.next + 1) % STATS_WINDOW;
+        history.count = std::min(history.count + 1, STATS_WINDOW);
+        record.passes.emplace_back(pass.pass, ms);
+    }
+
+    timeline.push_back(std::move(record));
+    if (timeline.size() > TIMELINE_FRAMES) {
+        timeline.pop_front();
+    }
+    return true;
+}
+
+#else
+
+void GpuProfiler::release() {}
+void GpuProfiler::beginFrame() {}
+void GpuProfiler::beginPass(const char*) {}
+void GpuProfiler::endPass() {}
+bool GpuProfiler::collect(FrameQueries&) { return false; }
+
+#endif
+
+std::vector<GpuProfiler::PassStats> GpuProfiler::getStats() const {
+    std::vector<PassStats> stats;
+    stats.reserve(passes.size());
+    for (const PassHistory& history : passes) {
+        PassStats pass;
+        pass.name = history.name;
+        pass.lastMs = history.lastMs;
+        pass.samples = history.count;
+        double total = 0.0;
+        for (int i = 0; i < history.count; ++i) {
+            total += history.samples[i];
+            pass.maxMs = std::max(pass.maxMs, history.samples[i]);
+        }
+        pass.averageMs = history.count > 0 ? total / history.count : 0.0;
+        stats.push_back(pass);
+    }
+    return stats;
+}
+
+bool GpuProfiler::exportTimeline(const std::string& path) const {
+    using json = nlohmann::json;
+
+    // GPU passes of a frame are laid end to end from the frame's CPU start;
+    // elapsed-time queries give durations, not GPU timestamps
+    json events = json::array();
+    for (const FrameRecord& frame : timeline) {
+        double offsetMs = 0.0;
+        for (const auto& pass : frame.passes) {
+            events.push_back({
+                {"name", passes[pass.first].name},
+                {"cat", "gpu"},
+                {"ph", "X"},
+                {"ts", (frame.cpuStartMs + offsetMs) * 1000.0},
+                {"dur", pass.second * 1000.0},
+                {"pid", 1},
+                {"tid", 1},
+                {"args", {{"frame", frame.frameNumber}}}
+            });
+            offsetMs += pass.second;
+        }
+    }
+
+    json stats = json::object();
+    for (const PassStats& pass : getStats()) {
+        stats[pass.name] = {
+            {"last_ms", pass.lastMs},
+            {"average_ms", pass.averageMs},
+            {"max_ms", pass.maxMs},
+            {"samples", pass.samples}
+        };
+    }
+
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    json trace = {
+        {"traceEvents", events},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {
+            {"renderer", renderer ? renderer : "unknown"},
+            {"backend", RenderBackend::current().getName()},
+            {"dropped_frames", droppedFrames},
+            {"pass_stats", stats}
+        }}
+    };
+
+    std::ofstream file(path);
+    if (!file) {
+        spdlog::error("Failed to write GPU profile to {}", path);
+        return false;
+    }
+    file << trace.dump(2);
+    spdlog::info("Wrote GPU profile of {} frames to {}", timeline.size(), path);
+    return true;
+}
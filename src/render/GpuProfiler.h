@@ -0,0 +1,109 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Measures how long the GPU spends in each render pass with GL_TIME_ELAPSED
+// queries. Results are collected a few frames later from a ring of query
+// sets, so reading them never waits on the GPU; a frame whose queries still
+// aren't done when its slot comes around again is dropped instead.
+//
+// Passes don't nest (the GL allows one elapsed-time query at a time), so
+// starting a pass ends the one still open.
+class GpuProfiler {
+public:
+    struct PassStats {
+        std::string name;
+        double lastMs = 0.0;
+        double averageMs = 0.0;  // Over the last STATS_WINDOW samples
+        double maxMs = 0.0;
+        int samples = 0;
+    };
+
+    static GpuProfiler& shared();
+
+    // Needs a current context. Returns false (and stays disabled) if timer
+    // queries aren't available.
+    bool init();
+    void release();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    // Collect finished frames and start recording a new one
+    void beginFrame();
+
+    void beginPass(const char* name);
+    void endPass();
+
+    // Rolling per-pass stats, in the order passes were first seen
+    std::vector<PassStats> getStats() const;
+    int getDroppedFrameCount() const { return droppedFrames; }
+
+    // Write the recent frames as a Chrome trace (chrome://tracing, Perfetto)
+    // with the rolling stats attached. Returns false if the file can't be written.
+    bool exportTimeline(const std::string& path) const;
+
+private:
+    static constexpr int FRAME_LATENCY = 4;      // Query sets in flight
+    static constexpr int STATS_WINDOW = 120;     // Samples per pass in the rolling stats
+    static constexpr size_t TIMELINE_FRAMES = 600;
+
+    struct PassQuery {
+        int pass;
+        GLuint query;
+    };
+
+    struct FrameQueries {
+        std::vector<GLuint> pool;         // Query objects owned by this slot
+        std::vector<PassQuery> recorded;  // Passes timed this frame, in order
+        uint64_t frameNumber = 0;
+        double cpuStartMs = 0.0;
+    };
+
+    struct FrameRecord {
+        uint64_t frameNumber;
+        double cpuStartMs;
+        std::vector<std::pair<int, double>> passes;  // Pass index and GPU milliseconds
+    };
+
+    struct PassHistory {
+        std::string name;
+        double samples[STATS_WINDOW] = {};
+        int count = 0;
+        int next = 0;
+        double lastMs = 0.0;
+    };
+
+    GpuProfiler();
+
+    bool supported;
+    bool enabled;
+    bool frameOpen;
+    int activePass;
+    int currentSlot;
+    uint64_t frameNumber;
+    int droppedFrames;
+    double startTime;
+
+    FrameQueries slots[FRAME_LATENCY];
+    std::vector<PassHistory> passes;
+    std::deque<FrameRecord> timeline;
+
+    int findPass(const char* name);
+    // Read a slot's results if they're all available; false if not
+    bool collect(FrameQueries& frame);
+};
+
+// Times the enclosed block as one pass
+class GpuPassScope {
+public:
+    explicit GpuPassScope(const char* name) { GpuProfiler::shared().beginPass(name); }
+    ~GpuPassScope() { GpuProfiler::shared().endPass(); }
+
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+};
@@ -0,0 +1,105 @@
+#include "render/InstancedQuadRenderer.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+InstancedQuadRenderer::InstancedQuadRenderer(const char* name)
+    : vertexArray(0), cornerBuffer(0), instanceBuffer(0), instanceBufferCapacity(0),
+      available(false), name(name), initAttempted(false) {
+}
+
+InstancedQuadRenderer::~InstancedQuadRenderer() {
+    InstancedQuadRenderer::release();
+}
+
+bool InstancedQuadRenderer::isAvailable() {
+    if (!initAttempted) {
+        initAttempted = true;
+#ifdef ORTOS_HAS_GL33
+        // The projection comes from the GL33 backend's uniform buffer
+        available = RenderBackend::current().getType() == RenderBackendType::GL33 && init();
+        if (available) {
+            shader.bindUniformBlock("Projection", RenderBackend::PROJECTION_BINDING);
+        }
+        glBindVertexArray(0);
+        GLState::bindArrayBuffer(0);
+        GLState::useProgram(0);
+#endif
+        if (available) {
+            spdlog::info("Instanced renderer ready for {}", name);
+        } else {
+            release();
+            spdlog::info("Instanced renderer unavailable for {}, using the sprite batch", name);
+        }
+    }
+    return available;
+}
+
+void InstancedQuadRenderer::release() {
+#ifdef ORTOS_HAS_GL33
+    if (vertexArray != 0) {
+        glDeleteVertexArrays(1, &vertexArray);
+        vertexArray = 0;
+    }
+#endif
+    if (cornerBuffer != 0) {
+        GLState::deleteBuffers(1, &cornerBuffer);
+        cornerBuffer = 0;
+    }
+    if (instanceBuffer != 0) {
+        GLState::deleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    instanceBufferCapacity = 0;
+    shader.release();
+}
+
+void InstancedQuadRenderer::createQuadArrays() {
+#ifdef ORTOS_HAS_GL33
+    const float corners[] = {
+        0.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f,
+        0.0f, 0.0f,  1.0f, 1.0f,  1.0f, 0.0f
+    };
+
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+
+    glGenBuffers(1, &cornerBuffer);
+    GLState::bindArrayBuffer(cornerBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    glGenBuffers(1, &instanceBuffer);
+    GLState::bindArrayBuffer(instanceBuffer);
+#endif
+}
+
+void InstancedQuadRenderer::uploadInstances(const void* data, size_t count, size_t instanceSize) {
+    // Orphan the previous frame's data so the upload doesn't wait on the GPU
+    GLState::bindArrayBuffer(instanceBuffer);
+    if (count > instanceBufferCapacity) {
+        instanceBufferCapacity = std::max(count, instanceBufferCapacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, instanceBufferCapacity * instanceSize, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * instanceSize, data);
+}
+
+void InstancedQuadRenderer::beginDraw() {
+#ifdef ORTOS_HAS_GL33
+    shader.use();
+    GLState::enable(GL_BLEND);
+    glBindVertexArray(vertexArray);
+#endif
+}
+
+void InstancedQuadRenderer::drawInstances(GLsizei count) {
+    GLState::drawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+}
+
+void InstancedQuadRenderer::endDraw() {
+#ifdef ORTOS_HAS_GL33
+    glBindVertexArray(0);
+#endif
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include "render/ShaderProgram.h"
+
+// Base for renderers that draw many sprites in one call by expanding a small
+// per-instance record into a quad in the vertex shader. Owns the program,
+// the unit quad on attribute 0 and a streamed instance buffer; subclasses
+// build the program and point attributes 1 and up at their instance layout.
+// Needs the OpenGL 3.3 backend, whose Projection uniform block the programs
+// read; callers fall back to the sprite batch without it.
+class InstancedQuadRenderer {
+public:
+    virtual ~InstancedQuadRenderer();
+
+    InstancedQuadRenderer(const InstancedQuadRenderer&) = delete;
+    InstancedQuadRenderer& operator=(const InstancedQuadRenderer&) = delete;
+
+    // Sets up on first call, so it must be called with the GL context current
+    // and after whatever init() reads has been loaded
+    bool isAvailable();
+
+protected:
+    // name is what gets drawn, for the log
+    explicit InstancedQuadRenderer(const char* name);
+
+    // Builds the program and instance attributes, after createQuadArrays()
+    virtual bool init() = 0;
+    // Frees everything init() created; subclasses extend it with their own state
+    virtual void release();
+
+    // Creates the vertex array with the quad corners on attribute 0, and
+    // leaves it and the instance buffer bound for the instance attributes.
+    // isAvailable() unbinds both once init() returns.
+    void createQuadArrays();
+
+    // Replaces the instance buffer's contents with count records of
+    // instanceSize bytes
+    void uploadInstances(const void* data, size_t count, size_t instanceSize);
+
+    // Binds the program and the quad arrays
+    void beginDraw();
+    void drawInstances(GLsizei count);
+    void endDraw();
+
+    ShaderProgram shader;
+    GLuint vertexArray;
+    GLuint cornerBuffer;
+    GLuint instanceBuffer;
+    size_t instanceBufferCapacity;  // In instances
+    bool available;
+
+private:
+    const char* name;
+    bool initAttempted;
+};
@@ -0,0 +1,54 @@
+#include "render/PixelScaler.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <algorithm>
+
+PixelScaler::PixelScaler() : enabled(true), scale(1) {
+}
+
+bool PixelScaler::begin(int width, int height) {
+    if (!enabled || width <= 0 || height <= 0) return false;
+
+    GLint viewport[4];
+    GLState::getViewport(viewport);
+    window = {viewport[0], viewport[1], viewport[2], viewport[3]};
+
+    scale = std::min(window.width / width, window.height / height);
+    if (scale < 1) return false;  // Zoomed out past the window size
+
+    if (target.getWidth() != width || target.getHeight() != height) {
+        if (!target.create(width, height, GL_NEAREST)) {
+            enabled = false;
+            return false;
+        }
+    }
+
+    output.width = width * scale;
+    output.height = height * scale;
+    output.x = window.x + (window.width - output.width) / 2;
+    output.y = window.y + (window.height - output.height) / 2;
+
+    target.bind();
+    target.clear();
+    return true;
+}
+
+void PixelScaler::end() {
+    target.unbind();
+}
+
+void PixelScaler::present() {
+    beginOverlay();
+    GLState::disable(GL_BLEND);
+    RenderBackend::current().drawFullscreenTexture(target.getTexture());
+    GLState::enable(GL_BLEND);
+    endOverlay();
+}
+
+void PixelScaler::beginOverlay() {
+    GLState::viewport(output.x, output.y, output.width, output.height);
+}
+
+void PixelScaler::endOverlay() {
+    GLState::viewport(window.x, window.y, window.width, window.height);
+}
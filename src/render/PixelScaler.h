@@ -0,0 +1,48 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "render/RenderTarget.h"
+
+// Renders the world at its native pixel-art resolution and presents it
+// scaled by the largest whole factor that fits the window, so every art
+// pixel becomes an exact square block. The remaining space is letterboxed.
+class PixelScaler {
+public:
+    struct Viewport {
+        int x = 0, y = 0, width = 0, height = 0;
+    };
+
+    PixelScaler();
+
+    PixelScaler(const PixelScaler&) = delete;
+    PixelScaler& operator=(const PixelScaler&) = delete;
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+
+    // Bind and clear a width x height target for the world pass. Returns
+    // false (and binds nothing) when disabled, when the resolution doesn't
+    // fit the current viewport, or when the target can't be created; the
+    // caller then draws straight to the window.
+    bool begin(int width, int height);
+    void end();
+
+    // Draw the low-resolution frame into the window viewport that was
+    // current at begin()
+    void present();
+
+    // Switch the viewport to where present() put the frame, so world-space
+    // overlays can be drawn on top of it at window resolution
+    void beginOverlay();
+    void endOverlay();
+
+    const Viewport& getOutputViewport() const { return output; }
+    int getScale() const { return scale; }
+
+private:
+    bool enabled;
+    RenderTarget target;
+    Viewport window;
+    Viewport output;
+    int scale;
+};
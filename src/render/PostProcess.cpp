@@ -0,0 +1,99 @@
+#include "render/PostProcess.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+PostProcess::PostProcess()
+    : bloomEnabled(true), viewportWidth(0), viewportHeight(0) {
+}
+
+bool PostProcess::ensureTargets() {
+    GLint viewport[4];
+    GLState::getViewport(viewport);
+    if (viewport[2] == viewportWidth && viewport[3] == viewportHeight && emissiveMask.isValid()) {
+        return true;
+    }
+
+    viewportWidth = viewport[2];
+    viewportHeight = viewport[3];
+    if (viewportWidth <= 0 || viewportHeight <= 0) return false;
+
+    // Linear filtering is what blurs the mask on every downsample
+    bool created = emissiveMask.create(std::max(1, viewportWidth / 2), std::max(1, viewportHeight / 2), GL_LINEAR);
+    bool blurSupported = RenderBackend::current().supportsBlur();
+    int divisor = 4;
+    for (int i = 0; i < BLOOM_LEVELS; ++i) {
+        int width = std::max(1, viewportWidth / divisor);
+        int height = std::max(1, viewportHeight / divisor);
+        created = created && bloomLevels[i].create(width, height, GL_LINEAR);
+        if (blurSupported) {
+            created = created && blurScratch[i].create(width, height, GL_LINEAR);
+        }
+        divisor *= 2;
+    }
+    if (!created) {
+        spdlog::error("Failed to create bloom targets, disabling bloom");
+        releaseTargets();
+        bloomEnabled = false;
+        return false;
+    }
+    return true;
+}
+
+void PostProcess::releaseTargets() {
+    emissiveMask.release();
+    for (int i = 0; i < BLOOM_LEVELS; ++i) {
+        bloomLevels[i].release();
+        blurScratch[i].release();
+    }
+}
+
+bool PostProcess::beginEmissive() {
+    if (!bloomEnabled || !ensureTargets()) return false;
+    emissiveMask.bind();
+    emissiveMask.clear();
+    return true;
+}
+
+void PostProcess::endEmissive() {
+    emissiveMask.unbind();
+}
+
+void PostProcess::resample(GLuint source, RenderTarget& target) {
+    target.bind();
+    RenderBackend::current().drawFullscreenTexture(source);
+    target.unbind();
+}
+
+void PostProcess::blur(RenderTarget& level, RenderTarget& scratch) {
+    RenderBackend& backend = RenderBackend::current();
+    scratch.bind();
+    backend.drawBlurredTexture(level.getTexture(), 1.0f / level.getWidth(), 0.0f);
+    scratch.unbind();
+    level.bind();
+    backend.drawBlurredTexture(scratch.getTexture(), 0.0f, 1.0f / scratch.getHeight());
+    level.unbind();
+}
+
+void PostProcess::applyBloom() {
+    if (!bloomEnabled || !emissiveMask.isValid()) return;
+
+    GLState::disable(GL_BLEND);
+    GLuint source = emissiveMask.getTexture();
+    for (int i = 0; i < BLOOM_LEVELS; ++i) {
+        resample(source, bloomLevels[i]);
+        if (blurScratch[i].isValid()) {
+            blur(bloomLevels[i], blurScratch[i]);
+        }
+        source = bloomLevels[i].getTexture();
+    }
+
+    // The tight level keeps the glow close to the sprite, the wide one adds the halo
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
+    for (RenderTarget& level : bloomLevels) {
+        RenderBackend::current().drawFullscreenTexture(level.getTexture());
+    }
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
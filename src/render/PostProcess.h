@@ -0,0 +1,48 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "render/RenderTarget.h"
+
+// Full-screen effects applied after the world is drawn. Targets follow the
+// size of the current viewport and are recreated when it changes.
+//
+// Bloom: emissive sprites are drawn into a half-resolution mask between
+// beginEmissive() and endEmissive(). applyBloom() then downsamples the mask
+// twice with bilinear filtering, blurs each level with a separable Gaussian
+// when the backend has shaders for it, and adds both levels over the frame.
+// The cost depends on the window size, not on how many sprites glow.
+class PostProcess {
+public:
+    PostProcess();
+
+    PostProcess(const PostProcess&) = delete;
+    PostProcess& operator=(const PostProcess&) = delete;
+
+    void setBloomEnabled(bool enabled) { bloomEnabled = enabled; }
+    bool isBloomEnabled() const { return bloomEnabled; }
+
+    // Bind and clear the emissive mask. Returns false (and binds nothing)
+    // when bloom is off or the targets couldn't be created.
+    bool beginEmissive();
+    void endEmissive();
+
+    // Blur the mask and add it to the currently bound framebuffer
+    void applyBloom();
+
+private:
+    static constexpr int BLOOM_LEVELS = 2;  // 1/4 and 1/8 of the viewport
+
+    bool bloomEnabled;
+    int viewportWidth, viewportHeight;
+
+    RenderTarget emissiveMask;  // 1/2 of the viewport
+    RenderTarget bloomLevels[BLOOM_LEVELS];
+    RenderTarget blurScratch[BLOOM_LEVELS];  // Horizontal pass output, only with blur support
+
+    bool ensureTargets();
+    // Draw source into target, scaled to fill it
+    void resample(GLuint source, RenderTarget& target);
+    // Gaussian-blur level in place through its scratch target
+    void blur(RenderTarget& level, RenderTarget& scratch);
+    void releaseTargets();
+};
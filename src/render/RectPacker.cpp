@@ -0,0 +1,80 @@
+#include "render/RectPacker.h"
+#include <algorithm>
+
+RectPacker::RectPacker(int width, int height)
+    : pageWidth(width), pageHeight(height) {
+    skyline.push_back({0, 0, width});
+}
+
+bool RectPacker::pack(int width, int height, int& outX, int& outY) {
+    if (width <= 0 || height <= 0 || width > pageWidth || height > pageHeight) {
+        return false;
+    }
+
+    int bestY = -1;
+    int bestWidth = 0;
+    size_t bestIndex = 0;
+
+    // Prefer the lowest position, then the narrowest skyline segment
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y = fitAt(i, width, height);
+        if (y < 0) continue;
+        if (bestY < 0 || y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+            bestY = y;
+            bestWidth = skyline[i].width;
+            bestIndex = i;
+        }
+    }
+
+    if (bestY < 0) {
+        return false;
+    }
+
+    outX = skyline[bestIndex].x;
+    outY = bestY;
+    addSkylineLevel(bestIndex, outX, outY, width, height);
+    return true;
+}
+
+int RectPacker::fitAt(size_t index, int width, int height) const {
+    int x = skyline[index].x;
+    if (x + width > pageWidth) return -1;
+
+    // The rect rests on the highest skyline segment it spans
+    int y = 0;
+    int remaining = width;
+    for (size_t i = index; i < skyline.size() && remaining > 0; ++i) {
+        y = std::max(y, skyline[i].y);
+        if (y + height > pageHeight) return -1;
+        remaining -= skyline[i].width;
+    }
+    return y;
+}
+
+void RectPacker::addSkylineLevel(size_t index, int x, int y, int width, int height) {
+    skyline.insert(skyline.begin() + index, {x, y + height, width});
+
+    // Trim or remove the segments now covered by the new one
+    for (size_t i = index + 1; i < skyline.size();) {
+        SkylineNode& node = skyline[i];
+        const SkylineNode& previous = skyline[i - 1];
+        int previousEnd = previous.x + previous.width;
+        if (node.x >= previousEnd) break;
+
+        int shrink = previousEnd - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
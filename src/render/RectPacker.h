@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Skyline bottom-left rectangle packer. Places rectangles one at a time into
+// a fixed-size page, keeping the lowest possible placement for each.
+class RectPacker {
+public:
+    RectPacker(int width, int height);
+
+    // Returns false if the rectangle doesn't fit in the remaining space
+    bool pack(int width, int height, int& outX, int& outY);
+
+    int getWidth() const { return pageWidth; }
+    int getHeight() const { return pageHeight; }
+
+private:
+    struct SkylineNode {
+        int x, y, width;
+    };
+
+    int pageWidth, pageHeight;
+    std::vector<SkylineNode> skyline;
+
+    // Lowest y at which a rect of the given width fits starting at node index, or -1
+    int fitAt(size_t index, int width, int height) const;
+    void addSkylineLevel(size_t index, int x, int y, int width, int height);
+};
@@ -0,0 +1,143 @@
+#include "render/RenderBackend.h"
+#include "render/FixedFunctionBackend.h"
+#include "render/GL33Backend.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+    std::unique_ptr<RenderBackend> activeBackend;
+    std::string activeShaderDirectory;
+    std::vector<std::array<float, 16>> savedProjections;
+
+    // Column-major, the matrix glOrtho multiplies in with near -1 and far 1
+    void makeOrtho(float left, float right, float bottom, float top, float* out) {
+        std::fill(out, out + 16, 0.0f);
+        out[0] = 2.0f / (right - left);
+        out[5] = 2.0f / (top - bottom);
+        out[10] = -1.0f;
+        out[12] = -(right + left) / (right - left);
+        out[13] = -(top + bottom) / (top - bottom);
+        out[15] = 1.0f;
+    }
+}
+
+RenderBackend::RenderBackend() {
+    std::fill(std::begin(projection), std::end(projection), 0.0f);
+    projection[0] = projection[5] = projection[10] = projection[15] = 1.0f;
+}
+
+RenderBackend& RenderBackend::current() {
+    if (!activeBackend) {
+        activeBackend = std::make_unique<FixedFunctionBackend>();
+    }
+    return *activeBackend;
+}
+
+RenderBackendType RenderBackend::select(RenderBackendType type, const std::string& shaderDirectory) {
+    activeShaderDirectory = shaderDirectory;
+    std::unique_ptr<RenderBackend> backend;
+    if (type == RenderBackendType::GL33) {
+        backend = std::make_unique<GL33Backend>();
+        if (!backend->init(shaderDirectory)) {
+            spdlog::warn("Falling back to the fixed-function render backend");
+            backend.reset();
+        }
+    }
+    if (!backend) {
+        backend = std::make_unique<FixedFunctionBackend>();
+        backend->init(shaderDirectory);
+    }
+
+    // Keep whatever projection was loaded before the switch
+    backend->setProjection(current().getProjection());
+    activeBackend = std::move(backend);
+    spdlog::info("Using the {} render backend", activeBackend->getName());
+    return activeBackend->getType();
+}
+
+const std::string& RenderBackend::getShaderDirectory() {
+    return activeShaderDirectory;
+}
+
+void RenderBackend::shutdown() {
+    activeBackend.reset();
+}
+
+RenderBackendType RenderBackend::parseType(const std::string& name, RenderBackendType defaultType) {
+    if (name == "gl33") return RenderBackendType::GL33;
+    if (name == "fixed") return RenderBackendType::FixedFunction;
+    if (!name.empty()) {
+        spdlog::warn("Unknown render backend '{}'", name);
+    }
+    return defaultType;
+}
+
+void RenderBackend::drawRectOutline(float left, float top, float right, float bottom,
+                                    unsigned char r, unsigned char g, unsigned char b, unsigned char a,
+                                    float width) {
+    const LineVertex vertices[8] = {
+        {left, top, r, g, b, a},     {right, top, r, g, b, a},
+        {right, top, r, g, b, a},    {right, bottom, r, g, b, a},
+        {right, bottom, r, g, b, a}, {left, bottom, r, g, b, a},
+        {left, bottom, r, g, b, a},  {left, top, r, g, b, a},
+    };
+    drawLines(vertices, 8, width);
+}
+
+bool RenderBackend::supportsGLVersion(int major, int minor) {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    int contextMajor = 0, contextMinor = 0;
+    if (!version || std::sscanf(version, "%d.%d", &contextMajor, &contextMinor) != 2) {
+        return false;
+    }
+    return contextMajor > major || (contextMajor == major && contextMinor >= minor);
+}
+
+void RenderBackend::setProjection(const float* matrix) {
+    std::memcpy(projection, matrix, sizeof(projection));
+}
+
+void RenderBackend::loadOrtho(float left, float right, float bottom, float top) {
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(left, right, bottom, top, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    float matrix[16];
+    makeOrtho(left, right, bottom, top, matrix);
+    current().setProjection(matrix);
+}
+
+void RenderBackend::pushOrtho(float left, float right, float bottom, float top) {
+    std::array<float, 16> saved;
+    std::memcpy(saved.data(), current().getProjection(), sizeof(float) * 16);
+    savedProjections.push_back(saved);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(left, right, bottom, top, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    float matrix[16];
+    makeOrtho(left, right, bottom, top, matrix);
+    current().setProjection(matrix);
+}
+
+void RenderBackend::popOrtho() {
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+
+    if (savedProjections.empty()) return;
+    current().setProjection(savedProjections.back().data());
+    savedProjections.pop_back();
+}
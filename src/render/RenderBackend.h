@@ -0,0 +1,153 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <memory>
+#include <string>
+
+// macOS only offers GL 3.3 through a core profile context, which the
+// immediate-mode UI can't run in, so shader-based paths are compiled out there
+#if !defined(__APPLE__)
+#define ORTOS_HAS_GL33 1
+#endif
+
+// Vertex layouts shared by every backend
+
+// Batched sprites: position, texture coordinate and per-vertex tint
+struct SpriteVertex {
+    float x, y;
+    float u, v;
+    unsigned char r, g, b, a;
+};
+
+// Text glyphs and tile chunks: position and texture coordinate, one tint per draw
+struct TexturedVertex {
+    float x, y;
+    float u, v;
+};
+
+// Tile chunks drawn from a texture array: position, coordinate within the
+// tile and the tile's array layer
+struct TileVertex {
+    float x, y;
+    float u, v;
+    float layer;
+};
+
+// Debug and outline lines
+struct LineVertex {
+    float x, y;
+    unsigned char r, g, b, a;
+};
+
+// One map layer resolved per fragment from an integer tile-index texture
+struct TileLayerDraw {
+    GLuint indexTexture = 0;      // GL_R32I array, one slice per map layer
+    float originX = 0.0f, originY = 0.0f;  // World position of indexTexture's first tile
+    int mapLayer = 0;
+    GLuint tileArray = 0;         // Tile images, one per array layer
+    GLuint animationTexture = 0;  // GL_RG32I frame table, 0 without animations
+    float tileWidth = 0.0f, tileHeight = 0.0f;
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;  // World area to cover
+    GLuint timeMs = 0;            // Animation clock
+};
+
+enum class RenderBackendType {
+    FixedFunction,  // Client arrays and the fixed-function pipeline
+    GL33            // Shader programs, VAOs and a projection uniform buffer
+};
+
+// Issues the draws for the batched renderers (sprites, text, tile chunks,
+// lines and full-screen post-process passes). Callers own the vertex
+// buffers and set blending; the backend binds programs, vertex layouts and
+// textures.
+//
+// Projection is set explicitly through loadOrtho/pushOrtho, which also load
+// it onto the fixed-function matrix stack for the immediate-mode UI. Backends
+// never read matrices back from the driver.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Uniform buffer binding of the std140 Projection block. Only the GL33
+    // backend fills it.
+    static constexpr GLuint PROJECTION_BINDING = 0;
+
+    // Backend used by all batched drawing. Falls back to fixed function
+    // until select() succeeds.
+    static RenderBackend& current();
+
+    // Switch backends. GL33 falls back to fixed function if the context is
+    // older than 3.3 or the shaders in shaderDirectory fail to build.
+    static RenderBackendType select(RenderBackendType type, const std::string& shaderDirectory);
+
+    // Directory passed to the last select(), for renderers that build their
+    // own programs from shader files
+    static const std::string& getShaderDirectory();
+
+    // Release the active backend while the GL context is still alive
+    static void shutdown();
+
+    // "gl33" or "fixed"; anything else yields the default
+    static RenderBackendType parseType(const std::string& name, RenderBackendType defaultType);
+
+    // Whether the current context reports at least this GL version
+    static bool supportsGLVersion(int major, int minor);
+
+    // Replace the projection with glOrtho(left, right, bottom, top, -1, 1)
+    // and reset the modelview, for both the matrix stack and the backend
+    static void loadOrtho(float left, float right, float bottom, float top);
+
+    // Same, saving the previous projection for popOrtho
+    static void pushOrtho(float left, float right, float bottom, float top);
+    static void popOrtho();
+
+    // Column-major projection used by batched draws. The modelview is
+    // always identity while they run.
+    virtual void setProjection(const float* matrix);
+    const float* getProjection() const { return projection; }
+
+    virtual RenderBackendType getType() const = 0;
+    virtual const char* getName() const = 0;
+
+    // SpriteVertex triangles. A texture of 0 draws untextured.
+    virtual void drawSprites(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture) = 0;
+
+    // TexturedVertex triangles tinted by a single color
+    virtual void drawTextured(GLuint vertexBuffer, GLint first, GLsizei count, GLuint texture,
+                              float r, float g, float b, float a) = 0;
+
+    // Fixed function can't sample texture arrays; callers check this before
+    // using drawTileArray or drawTileLayer and fall back to drawTextured
+    virtual bool supportsTextureArrays() const = 0;
+
+    // TileVertex triangles sampling a GL_TEXTURE_2D_ARRAY
+    virtual void drawTileArray(GLuint vertexBuffer, GLint first, GLsizei count, GLuint textureArray) = 0;
+
+    // A quad over the layer's area; the fragment shader picks each tile
+    virtual void drawTileLayer(const TileLayerDraw& layer) = 0;
+
+    // Pairs of LineVertex from client memory
+    virtual void drawLines(const LineVertex* vertices, GLsizei count, float width) = 0;
+
+    // Outline of an axis-aligned rectangle, built on drawLines
+    void drawRectOutline(float left, float top, float right, float bottom,
+                         unsigned char r, unsigned char g, unsigned char b, unsigned char a, float width);
+
+    // Cover the viewport with a texture, for post-processing passes
+    virtual void drawFullscreenTexture(GLuint texture) = 0;
+
+    // Fixed function has no shaders to blur with; callers check this before
+    // using drawBlurredTexture
+    virtual bool supportsBlur() const = 0;
+
+    // drawFullscreenTexture through one pass of a separable Gaussian blur.
+    // texelX/texelY is one source texel along the blur direction.
+    virtual void drawBlurredTexture(GLuint texture, float texelX, float texelY) = 0;
+
+protected:
+    RenderBackend();
+
+    virtual bool init(const std::string& shaderDirectory) = 0;
+
+    float projection[16];
+};
@@ -0,0 +1,71 @@
+#include "render/RenderTarget.h"
+#include "render/GLState.h"
+#include <spdlog/spdlog.h>
+
+RenderTarget::RenderTarget()
+    : framebuffer(0), texture(0), width(0), height(0),
+      previousFramebuffer(0), previousViewport{0, 0, 0, 0} {
+}
+
+RenderTarget::~RenderTarget() {
+    release();
+}
+
+bool RenderTarget::create(int width, int height, GLint filter) {
+    release();
+
+    glGenTextures(1, &texture);
+    GLState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    GLuint boundFramebuffer = GLState::getFramebuffer();
+    glGenFramebuffers(1, &framebuffer);
+    GLState::bindFramebuffer(framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    GLState::bindFramebuffer(boundFramebuffer);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        spdlog::error("Render target {}x{} is incomplete (status 0x{:x})", width, height, status);
+        release();
+        return false;
+    }
+
+    this->width = width;
+    this->height = height;
+    return true;
+}
+
+void RenderTarget::release() {
+    if (framebuffer != 0) {
+        GLState::deleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (texture != 0) {
+        GLState::deleteTextures(1, &texture);
+        texture = 0;
+    }
+    width = height = 0;
+}
+
+void RenderTarget::bind() {
+    previousFramebuffer = GLState::getFramebuffer();
+    GLState::getViewport(previousViewport);
+    GLState::bindFramebuffer(framebuffer);
+    GLState::viewport(0, 0, width, height);
+}
+
+void RenderTarget::unbind() {
+    GLState::bindFramebuffer(previousFramebuffer);
+    GLState::viewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
+
+void RenderTarget::clear(float r, float g, float b, float a) {
+    glClearColor(r, g, b, a);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);  // The main loop clears with the default color
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// An offscreen framebuffer with one RGBA color texture. While bound, drawing
+// goes to the texture and the viewport covers it; unbind() restores the
+// framebuffer and viewport that were current before.
+class RenderTarget {
+public:
+    RenderTarget();
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // (Re)create the target. Returns false if the framebuffer is incomplete.
+    bool create(int width, int height, GLint filter = GL_NEAREST);
+    void release();
+
+    void bind();
+    void unbind();
+
+    // Clear the color texture; the target must be bound
+    void clear(float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 0.0f);
+
+    bool isValid() const { return framebuffer != 0; }
+    GLuint getTexture() const { return texture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    GLuint framebuffer;
+    GLuint texture;
+    int width, height;
+
+    GLuint previousFramebuffer;
+    GLint previousViewport[4];
+};
@@ -0,0 +1,120 @@
+#include "render/ShaderProgram.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <spdlog/spdlog.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+ShaderProgram::ShaderProgram() : program(0) {
+}
+
+ShaderProgram::~ShaderProgram() {
+    release();
+}
+
+GLuint ShaderProgram::compileStage(GLenum stage, const std::string& source) {
+    GLuint shader = glCreateShader(stage);
+    const char* text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 0 ? length : 1, '\0');
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        spdlog::error("Failed to compile {} shader: {}", stage == GL_VERTEX_SHADER ? "vertex" : "fragment",
+                      log.data());
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ShaderProgram::build(const std::string& vertexSource, const std::string& fragmentSource) {
+    release();
+
+    GLuint vertexShader = compileStage(GL_VERTEX_SHADER, vertexSource);
+    if (vertexShader == 0) return false;
+    GLuint fragmentShader = compileStage(GL_FRAGMENT_SHADER, fragmentSource);
+    if (fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    // The program keeps the compiled stages alive
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 0 ? length : 1, '\0');
+        glGetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        spdlog::error("Failed to link shader program: {}", log.data());
+        release();
+        return false;
+    }
+    return true;
+}
+
+bool ShaderProgram::readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("Failed to open shader: {}", path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+bool ShaderProgram::buildFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
+    std::string vertexSource, fragmentSource;
+    if (!readFile(vertexPath, vertexSource) || !readFile(fragmentPath, fragmentSource)) {
+        return false;
+    }
+    if (!build(vertexSource, fragmentSource)) {
+        spdlog::error("Shader program from {} and {} failed to build", vertexPath, fragmentPath);
+        return false;
+    }
+    return true;
+}
+
+void ShaderProgram::release() {
+    if (program != 0) {
+        GLState::deleteProgram(program);
+        program = 0;
+    }
+}
+
+void ShaderProgram::use() const {
+    GLState::useProgram(program);
+}
+
+GLint ShaderProgram::getUniformLocation(const char* name) const {
+    return glGetUniformLocation(program, name);
+}
+
+void ShaderProgram::bindUniformBlock(const char* name, GLuint binding) const {
+#ifdef ORTOS_HAS_GL33
+    GLuint index = glGetUniformBlockIndex(program, name);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, binding);
+    }
+#else
+    (void)name;
+    (void)binding;
+#endif
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <string>
+
+// A linked vertex + fragment shader pair. Compile and link errors are logged
+// and reported through build()'s return value.
+class ShaderProgram {
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    bool build(const std::string& vertexSource, const std::string& fragmentSource);
+    bool buildFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
+    void release();
+
+    void use() const;
+    bool isValid() const { return program != 0; }
+    GLuint getID() const { return program; }
+
+    // -1 if the uniform doesn't exist or was optimised out
+    GLint getUniformLocation(const char* name) const;
+
+    // Attach a named uniform block to a buffer binding point
+    void bindUniformBlock(const char* name, GLuint binding) const;
+
+private:
+    GLuint program;
+
+    static GLuint compileStage(GLenum stage, const std::string& source);
+    static bool readFile(const std::string& path, std::string& contents);
+};
@@ -0,0 +1,243 @@
+#include "render/SpriteBatch.h"
+#include "render/GLState.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int VERTICES_PER_SPRITE = 6;  // Two triangles
+    constexpr int CIRCLE_TEXTURE_SIZE = 32;
+
+    unsigned char toByte(float value) {
+        return static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    bool sameDrawState(const Sprite& a, const Sprite& b) {
+        return a.texture == b.texture && a.blend == b.blend;
+    }
+}
+
+SpriteBatch::SpriteBatch() {
+    sprites.reserve(256);
+    order.reserve(256);
+    sortKeys.reserve(256);
+    orderScratch.reserve(256);
+    sortKeysScratch.reserve(256);
+    vertices.reserve(256 * VERTICES_PER_SPRITE);
+}
+
+SpriteBatch::~SpriteBatch() {
+    if (vertexBuffer != 0) {
+        GLState::deleteBuffers(1, &vertexBuffer);
+    }
+    if (circleTexture != 0) {
+        GLState::deleteTextures(1, &circleTexture);
+    }
+}
+
+void SpriteBatch::begin() {
+    sprites.clear();
+    culling = false;
+    culledCount = 0;
+}
+
+void SpriteBatch::begin(const ViewRect& cullRect) {
+    begin();
+    this->cullRect = cullRect;
+    culling = true;
+}
+
+void SpriteBatch::submit(const Sprite& sprite) {
+    if (culling && !cullRect.intersects(sprite.x, sprite.y, sprite.x + sprite.width, sprite.y + sprite.height)) {
+        ++culledCount;
+        return;
+    }
+    sprites.push_back(sprite);
+}
+
+void SpriteBatch::flush() {
+    lastSpriteCount = static_cast<int>(sprites.size());
+    lastDrawCallCount = 0;
+    lastCulledCount = culledCount;
+    if (sprites.empty()) return;
+
+    sortSprites();
+    buildVertices();
+    uploadVertices();
+
+    RenderBackend& backend = RenderBackend::current();
+    GLState::enable(GL_BLEND);
+
+    // Draw each run of sprites sharing texture and blend mode with one call
+    size_t runStart = 0;
+    while (runStart < order.size()) {
+        const Sprite& first = sprites[order[runStart]];
+        size_t runEnd = runStart + 1;
+        while (runEnd < order.size() && sameDrawState(sprites[order[runEnd]], first)) {
+            ++runEnd;
+        }
+
+        if (first.blend == BlendMode::Additive) {
+            GLState::blendFunc(GL_SRC_ALPHA, GL_ONE);
+        } else if (premultipliedOutput) {
+            GLState::blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        } else {
+            GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+
+        backend.drawSprites(vertexBuffer,
+                            static_cast<GLint>(runStart * VERTICES_PER_SPRITE),
+                            static_cast<GLsizei>((runEnd - runStart) * VERTICES_PER_SPRITE),
+                            first.texture);
+        ++lastDrawCallCount;
+        runStart = runEnd;
+    }
+
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    sprites.clear();
+}
+
+uint64_t SpriteBatch::makeSortKey(const Sprite& sprite) {
+    // | layer:4 | depth:32 | blend:1 | texture:27 |, most significant first.
+    // Depth is biased so negative rows still sort below positive ones.
+    double row = std::floor(static_cast<double>(sprite.depth));
+    row = std::clamp(row, -2147483648.0, 2147483647.0);
+    uint64_t depth = static_cast<uint64_t>(static_cast<int64_t>(row) + 2147483648LL);
+    uint64_t layer = static_cast<uint64_t>(sprite.layer) & 0xF;
+    uint64_t blend = sprite.blend == BlendMode::Additive ? 1 : 0;
+    uint64_t texture = static_cast<uint64_t>(sprite.texture) & 0x7FFFFFF;
+    return (layer << 60) | (depth << 28) | (blend << 27) | texture;
+}
+
+void SpriteBatch::sortSprites() {
+    size_t count = sprites.size();
+    order.resize(count);
+    sortKeys.resize(count);
+    orderScratch.resize(count);
+    sortKeysScratch.resize(count);
+
+    // One pass builds the histograms of all eight key bytes
+    size_t histograms[8][256] = {};
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = makeSortKey(sprites[i]);
+        order[i] = static_cast<unsigned int>(i);
+        sortKeys[i] = key;
+        for (int digit = 0; digit < 8; ++digit) {
+            ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+        }
+    }
+
+    // Least significant byte first. Each pass is a stable counting sort, so
+    // equal keys keep their submission order. Bytes every key shares (most of
+    // the depth, usually the layer) are skipped.
+    for (int digit = 0; digit < 8; ++digit) {
+        size_t* histogram = histograms[digit];
+        int shift = digit * 8;
+        if (histogram[(sortKeys[0] >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            size_t target = histogram[(sortKeys[i] >> shift) & 0xFF]++;
+            sortKeysScratch[target] = sortKeys[i];
+            orderScratch[target] = order[i];
+        }
+        sortKeys.swap(sortKeysScratch);
+        order.swap(orderScratch);
+    }
+}
+
+void SpriteBatch::buildVertices() {
+    vertices.clear();
+    for (unsigned int index : order) {
+        appendQuad(sprites[index]);
+    }
+}
+
+void SpriteBatch::appendQuad(const Sprite& sprite) {
+    float u1 = sprite.u1;
+    float u2 = sprite.u2;
+    if (sprite.flipX) std::swap(u1, u2);
+
+    unsigned char r = toByte(sprite.r);
+    unsigned char g = toByte(sprite.g);
+    unsigned char b = toByte(sprite.b);
+    unsigned char a = toByte(sprite.a);
+
+    float left = sprite.x;
+    float top = sprite.y;
+    float right = sprite.x + sprite.width;
+    float bottom = sprite.y + sprite.height;
+
+    SpriteVertex topLeft = {left, top, u1, sprite.v1, r, g, b, a};
+    SpriteVertex topRight = {right, top, u2, sprite.v1, r, g, b, a};
+    SpriteVertex bottomRight = {right, bottom, u2, sprite.v2, r, g, b, a};
+    SpriteVertex bottomLeft = {left, bottom, u1, sprite.v2, r, g, b, a};
+
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+void SpriteBatch::uploadVertices() {
+    if (vertexBuffer == 0) {
+        glGenBuffers(1, &vertexBuffer);
+    }
+    GLState::bindArrayBuffer(vertexBuffer);
+
+    if (vertices.size() > vertexBufferCapacity) {
+        // Grow in powers of two so the buffer settles after a few frames
+        size_t newCapacity = std::max<size_t>(vertexBufferCapacity, 1024);
+        while (newCapacity < vertices.size()) newCapacity *= 2;
+        vertexBufferCapacity = newCapacity;
+        spdlog::debug("SpriteBatch vertex buffer grown to {} vertices", vertexBufferCapacity);
+    }
+
+    // Orphan last frame's storage so the driver doesn't stall on it
+    GLsizeiptr capacityBytes = static_cast<GLsizeiptr>(vertexBufferCapacity * sizeof(SpriteVertex));
+    glBufferData(GL_ARRAY_BUFFER, capacityBytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0,
+                    static_cast<GLsizeiptr>(vertices.size() * sizeof(SpriteVertex)),
+                    vertices.data());
+}
+
+GLuint SpriteBatch::getCircleTexture() {
+    if (circleTexture != 0) return circleTexture;
+
+    std::vector<unsigned char> pixels(CIRCLE_TEXTURE_SIZE * CIRCLE_TEXTURE_SIZE * 4);
+    float center = CIRCLE_TEXTURE_SIZE / 2.0f;
+    for (int py = 0; py < CIRCLE_TEXTURE_SIZE; ++py) {
+        for (int px = 0; px < CIRCLE_TEXTURE_SIZE; ++px) {
+            float dx = px + 0.5f - center;
+            float dy = py + 0.5f - center;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            // One texel of anti-aliased edge
+            float coverage = std::clamp(center - distance, 0.0f, 1.0f);
+            unsigned char* pixel = &pixels[(py * CIRCLE_TEXTURE_SIZE + px) * 4];
+            pixel[0] = 255;
+            pixel[1] = 255;
+            pixel[2] = 255;
+            pixel[3] = toByte(coverage);
+        }
+    }
+
+    glGenTextures(1, &circleTexture);
+    GLState::bindTexture(circleTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, CIRCLE_TEXTURE_SIZE, CIRCLE_TEXTURE_SIZE, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    GLState::bindTexture(0);
+
+    return circleTexture;
+}
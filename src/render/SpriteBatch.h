@@ -0,0 +1,98 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "render/RenderBackend.h"
+#include "render/ViewRect.h"
+
+// Draw order of batched world sprites. Lower layers are drawn first.
+enum class SpriteLayer {
+    Entity = 0,      // Player and enemies
+    Projectile,
+    Effect           // Blood and gate effects
+};
+
+enum class BlendMode {
+    Alpha,     // GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+    Additive   // GL_SRC_ALPHA, GL_ONE
+};
+
+// One textured quad queued for drawing.
+// (x, y) is the top-left corner in world units. (u1, v1) is sampled at the
+// top-left corner and (u2, v2) at the bottom-right one.
+// A texture of 0 draws a solid quad in the tint color.
+// Within a layer, sprites with a greater depth are drawn in front. Entities
+// use the Y of their position so whoever stands lower on screen overlaps.
+struct Sprite {
+    GLuint texture = 0;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    float u1 = 0.0f, v1 = 0.0f, u2 = 1.0f, v2 = 1.0f;
+    bool flipX = false;
+    float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
+    SpriteLayer layer = SpriteLayer::Entity;
+    float depth = 0.0f;  // Rounded down to whole world units when sorting
+    BlendMode blend = BlendMode::Alpha;
+};
+
+// Collects sprites for a frame and draws them from one streaming vertex buffer.
+// On flush every sprite gets a 64-bit key of layer, depth, blend mode and
+// texture, and the keys are radix sorted. Sprites at the same depth end up
+// grouped by texture, so a draw call covers every neighbour that shares one.
+class SpriteBatch {
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    void begin();
+    // Sprites entirely outside the cull rect are dropped on submit
+    void begin(const ViewRect& cullRect);
+    void submit(const Sprite& sprite);
+    void flush();
+    bool isEmpty() const { return sprites.empty(); }
+
+    // When drawing into a cleared render target, accumulate coverage in the
+    // target's alpha so the result can be composited as premultiplied alpha
+    void setPremultipliedOutput(bool enabled) { premultipliedOutput = enabled; }
+
+    // Soft white disc, used for untextured round sprites
+    GLuint getCircleTexture();
+
+    // Stats from the last flush
+    int getLastSpriteCount() const { return lastSpriteCount; }
+    int getLastDrawCallCount() const { return lastDrawCallCount; }
+    int getLastCulledCount() const { return lastCulledCount; }
+
+private:
+    std::vector<Sprite> sprites;
+    std::vector<unsigned int> order;
+    std::vector<uint64_t> sortKeys;
+    // Ping-pong buffers for the radix passes
+    std::vector<unsigned int> orderScratch;
+    std::vector<uint64_t> sortKeysScratch;
+    std::vector<SpriteVertex> vertices;
+
+    GLuint vertexBuffer = 0;
+    size_t vertexBufferCapacity = 0;  // In vertices
+    GLuint circleTexture = 0;
+
+    ViewRect cullRect;
+    bool culling = false;
+    bool premultipliedOutput = false;
+    int culledCount = 0;
+
+    int lastSpriteCount = 0;
+    int lastDrawCallCount = 0;
+    int lastCulledCount = 0;
+
+    static uint64_t makeSortKey(const Sprite& sprite);
+    void sortSprites();
+    void buildVertices();
+    void uploadVertices();
+    void appendQuad(const Sprite& sprite);
+};
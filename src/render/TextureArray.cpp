@@ -0,0 +1,73 @@
+#include "render/TextureArray.h"
+#include "render/GLState.h"
+#include <spdlog/spdlog.h>
+#include <utility>
+
+TextureArray::TextureArray()
+    : texture(0), width(0), height(0), layerCount(0) {
+}
+
+TextureArray::~TextureArray() {
+    release();
+}
+
+void TextureArray::swap(TextureArray& other) {
+    std::swap(texture, other.texture);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(layerCount, other.layerCount);
+}
+
+int TextureArray::getMaxLayers() {
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    return maxLayers;
+}
+
+bool TextureArray::create(int width, int height, int layerCount, GLint filter) {
+    release();
+
+    int maxLayers = getMaxLayers();
+    if (layerCount <= 0 || layerCount > maxLayers) {
+        spdlog::error("Texture array of {} layers is out of range (limit {})", layerCount, maxLayers);
+        return false;
+    }
+
+    glGenTextures(1, &texture);
+    GLState::bindTextureArray(texture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layerCount, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    this->width = width;
+    this->height = height;
+    this->layerCount = layerCount;
+    return true;
+}
+
+void TextureArray::release() {
+    if (texture != 0) {
+        GLState::deleteTextures(1, &texture);
+        texture = 0;
+    }
+    width = height = layerCount = 0;
+}
+
+void TextureArray::uploadLayer(int layer, const unsigned char* image, int imageWidth, int cellX, int cellY) {
+    if (texture == 0 || layer < 0 || layer >= layerCount) return;
+
+    // The unpack state picks the cell straight out of the whole image. RGBA
+    // rows are always 4-byte aligned, so the alignment can stay as it is.
+    GLState::bindTextureArray(texture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, imageWidth);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, cellX);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, cellY);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+}
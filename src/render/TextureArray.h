@@ -0,0 +1,39 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// A GL_TEXTURE_2D_ARRAY of equally sized RGBA layers. Each tile of a tileset
+// gets a layer of its own, so sampling never reaches a neighbouring tile and
+// tiles from different images draw with a single bind.
+class TextureArray {
+public:
+    TextureArray();
+    ~TextureArray();
+
+    TextureArray(const TextureArray&) = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+
+    // Most layers the context allows in one array
+    static int getMaxLayers();
+
+    // (Re)allocate layerCount empty layers. Returns false if layerCount is
+    // over getMaxLayers().
+    bool create(int width, int height, int layerCount, GLint filter = GL_NEAREST);
+    void release();
+    void swap(TextureArray& other);
+
+    // Copy one width x height cell of an RGBA image into a layer. The cell's
+    // top-left corner is at (cellX, cellY) in pixels from the image's top-left.
+    void uploadLayer(int layer, const unsigned char* image, int imageWidth, int cellX, int cellY);
+
+    bool isValid() const { return texture != 0; }
+    GLuint getID() const { return texture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getLayerCount() const { return layerCount; }
+
+private:
+    GLuint texture;
+    int width, height;
+    int layerCount;
+};
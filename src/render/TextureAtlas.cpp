@@ -0,0 +1,203 @@
+#include "render/TextureAtlas.h"
+#include "render/GLState.h"
+#include "render/RectPacker.h"
+#include "render/TextureCache.h"
+#include <stb_image.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr int DEFAULT_PAGE_SIZE = 1024;
+
+    int nextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+TextureAtlas::TextureAtlas() : pageSize(DEFAULT_PAGE_SIZE) {
+}
+
+TextureAtlas::~TextureAtlas() {
+    cleanup();
+}
+
+TextureAtlas& TextureAtlas::shared() {
+    static TextureAtlas atlas;
+    return atlas;
+}
+
+AtlasHandle TextureAtlas::addImage(const std::string& filePath) {
+    // Several users may register the same file
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (paths[i] == filePath) {
+            return static_cast<AtlasHandle>(i);
+        }
+    }
+
+    int width, height, channels;
+    unsigned char* data = TextureCache::decode(filePath, false, 4, width, height, channels); // Force RGBA
+    if (!data) {
+        spdlog::error("Failed to load atlas image: {}", filePath);
+        spdlog::error("STB Error: {}", stbi_failure_reason());
+        return INVALID_ATLAS_HANDLE;
+    }
+
+    AtlasHandle handle = static_cast<AtlasHandle>(regions.size());
+    AtlasRegion region;
+    region.width = width;
+    region.height = height;
+    regions.push_back(region);
+    paths.push_back(filePath);
+    pending.push_back({handle, data});
+
+    spdlog::debug("Queued atlas image {} ({}x{}) as handle {}", filePath, width, height, handle);
+    return handle;
+}
+
+bool TextureAtlas::build() {
+    if (pending.empty()) return true;
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize <= 0) {
+        maxTextureSize = DEFAULT_PAGE_SIZE;
+    }
+    pageSize = std::min(DEFAULT_PAGE_SIZE, static_cast<int>(maxTextureSize));
+
+    // Tallest images first packs noticeably tighter with a skyline packer
+    std::stable_sort(pending.begin(), pending.end(), [this](const PendingImage& a, const PendingImage& b) {
+        const AtlasRegion& ra = regions[a.handle];
+        const AtlasRegion& rb = regions[b.handle];
+        if (ra.height != rb.height) return ra.height > rb.height;
+        return ra.width > rb.width;
+    });
+
+    struct Placement {
+        AtlasHandle handle;
+        const unsigned char* pixels;
+        int x, y;
+    };
+    struct PageBuild {
+        RectPacker packer;
+        std::vector<Placement> placements;
+    };
+    std::vector<PageBuild> newPages;
+
+    for (const PendingImage& image : pending) {
+        const AtlasRegion& region = regions[image.handle];
+        int paddedWidth = region.width + PADDING * 2;
+        int paddedHeight = region.height + PADDING * 2;
+
+        bool placed = false;
+        for (PageBuild& page : newPages) {
+            int x, y;
+            if (page.packer.pack(paddedWidth, paddedHeight, x, y)) {
+                page.placements.push_back({image.handle, image.pixels, x, y});
+                placed = true;
+                break;
+            }
+        }
+        if (placed) continue;
+
+        // Images larger than a page get a page of their own
+        int width = std::max(pageSize, nextPowerOfTwo(paddedWidth));
+        int height = std::max(pageSize, nextPowerOfTwo(paddedHeight));
+        if (width > maxTextureSize || height > maxTextureSize) {
+            spdlog::error("Atlas image {} ({}x{}) exceeds the maximum texture size {}",
+                          paths[image.handle], region.width, region.height, maxTextureSize);
+            continue;
+        }
+        newPages.push_back({RectPacker(width, height), {}});
+        int x, y;
+        newPages.back().packer.pack(paddedWidth, paddedHeight, x, y);
+        newPages.back().placements.push_back({image.handle, image.pixels, x, y});
+    }
+
+    for (PageBuild& page : newPages) {
+        int width = page.packer.getWidth();
+        int height = page.packer.getHeight();
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4, 0);
+
+        for (const Placement& placement : page.placements) {
+            AtlasRegion& region = regions[placement.handle];
+            blitWithPadding(pixels, width, placement.pixels, region.width, region.height,
+                            placement.x, placement.y);
+        }
+
+        GLuint texture = createPage(width, height, pixels.data());
+        pages.push_back(texture);
+
+        for (const Placement& placement : page.placements) {
+            AtlasRegion& region = regions[placement.handle];
+            region.texture = texture;
+            region.u1 = static_cast<float>(placement.x + PADDING) / width;
+            region.v1 = static_cast<float>(placement.y + PADDING) / height;
+            region.u2 = static_cast<float>(placement.x + PADDING + region.width) / width;
+            region.v2 = static_cast<float>(placement.y + PADDING + region.height) / height;
+        }
+
+        spdlog::info("Built atlas page {} ({}x{}) with {} images", pages.size() - 1, width, height,
+                     page.placements.size());
+    }
+
+    for (PendingImage& image : pending) {
+        stbi_image_free(image.pixels);
+    }
+    pending.clear();
+    return true;
+}
+
+GLuint TextureAtlas::createPage(int width, int height, const unsigned char* pixels) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    GLState::bindTexture(texture);
+
+    // Use NEAREST filtering for pixel-perfect graphics
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    GLState::bindTexture(0);
+    return texture;
+}
+
+void TextureAtlas::blitWithPadding(std::vector<unsigned char>& page, int pageWidth,
+                                   const unsigned char* image, int width, int height, int x, int y) const {
+    // Copy rows including the padding ring, clamping source coordinates so
+    // the border repeats the image's edge pixels and sampling never bleeds
+    for (int row = -PADDING; row < height + PADDING; ++row) {
+        int sourceRow = std::clamp(row, 0, height - 1);
+        for (int column = -PADDING; column < width + PADDING; ++column) {
+            int sourceColumn = std::clamp(column, 0, width - 1);
+            const unsigned char* source = image + (static_cast<size_t>(sourceRow) * width + sourceColumn) * 4;
+            unsigned char* destination = &page[(static_cast<size_t>(y + PADDING + row) * pageWidth + (x + PADDING + column)) * 4];
+            std::memcpy(destination, source, 4);
+        }
+    }
+}
+
+const AtlasRegion& TextureAtlas::getRegion(AtlasHandle handle) const {
+    static const AtlasRegion emptyRegion;
+    if (handle < 0 || handle >= static_cast<AtlasHandle>(regions.size())) {
+        return emptyRegion;
+    }
+    return regions[handle];
+}
+
+void TextureAtlas::cleanup() {
+    for (PendingImage& image : pending) {
+        stbi_image_free(image.pixels);
+    }
+    pending.clear();
+
+    if (!pages.empty()) {
+        GLState::deleteTextures(static_cast<GLsizei>(pages.size()), pages.data());
+        pages.clear();
+    }
+    regions.clear();
+    paths.clear();
+}
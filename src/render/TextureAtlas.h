@@ -0,0 +1,69 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+
+using AtlasHandle = int;
+constexpr AtlasHandle INVALID_ATLAS_HANDLE = -1;
+
+// Where a packed image ended up. (u1, v1) is the first pixel row/column of the
+// source image and (u2, v2) the last, so a quad that used UVs 0..1 on the
+// standalone texture uses mapU/mapV on the atlas page instead.
+struct AtlasRegion {
+    GLuint texture = 0;  // Page texture, 0 until the atlas is built
+    float u1 = 0.0f, v1 = 0.0f, u2 = 1.0f, v2 = 1.0f;
+    int width = 0, height = 0;  // Size of the source image in pixels
+
+    float mapU(float u) const { return u1 + (u2 - u1) * u; }
+    float mapV(float v) const { return v1 + (v2 - v1) * v; }
+};
+
+// Packs many small images into a few large textures so that sprites and UI
+// art from different files can be drawn without rebinding textures.
+// Images are decoded when added and uploaded on build(); regions become
+// usable once the atlas has been built.
+class TextureAtlas {
+public:
+    TextureAtlas();
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Atlas shared by the game's sprites and HUD art
+    static TextureAtlas& shared();
+
+    // Decode an image and queue it for packing. Adding the same path twice
+    // returns the same handle. Returns INVALID_ATLAS_HANDLE on failure.
+    AtlasHandle addImage(const std::string& filePath);
+
+    // Pack and upload every image added since the last build
+    bool build();
+
+    const AtlasRegion& getRegion(AtlasHandle handle) const;
+    bool isBuilt() const { return pending.empty() && !regions.empty(); }
+    int getPageCount() const { return static_cast<int>(pages.size()); }
+
+    void cleanup();
+
+private:
+    struct PendingImage {
+        AtlasHandle handle;
+        unsigned char* pixels;  // RGBA, owned until build()
+    };
+
+    std::vector<AtlasRegion> regions;
+    std::vector<std::string> paths;
+    std::vector<PendingImage> pending;
+    std::vector<GLuint> pages;
+
+    int pageSize;
+
+    static constexpr int PADDING = 1;  // Edge pixels are repeated into the padding
+
+    // Upload RGBA pixels as a new page texture
+    GLuint createPage(int width, int height, const unsigned char* pixels);
+    void blitWithPadding(std::vector<unsigned char>& page, int pageWidth,
+                         const unsigned char* image, int width, int height, int x, int y) const;
+};
@@ -0,0 +1,119 @@
+#include "render/TextureCache.h"
+#include "render/GLState.h"
+#include "render/TextureStreamer.h"
+#include <stb_image.h>
+#include <spdlog/spdlog.h>
+#include <filesystem>
+
+Texture::Texture(GLuint id, int width, int height, int channels)
+    : id(id), width(width), height(height), channels(channels) {
+}
+
+Texture::~Texture() {
+    if (id != 0) {
+        GLState::deleteTextures(1, &id);
+    }
+}
+
+TextureCache& TextureCache::shared() {
+    static TextureCache cache;
+    return cache;
+}
+
+std::string TextureCache::makeKey(const std::string& filePath, const TextureLoadOptions& options) {
+    return filePath + "|" + (options.flipVertically ? "flip" : "noflip") +
+           "|" + std::to_string(options.desiredChannels) +
+           "|" + std::to_string(options.filter);
+}
+
+unsigned char* TextureCache::decode(const std::string& filePath, bool flipVertically, int desiredChannels,
+                                    int& width, int& height, int& channels) {
+    // The per-thread flag takes precedence over the global one
+    stbi_set_flip_vertically_on_load_thread(flipVertically ? 1 : 0);
+    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, desiredChannels);
+    if (data && desiredChannels != 0) {
+        channels = desiredChannels;
+    }
+    return data;
+}
+
+GLenum TextureCache::getFormat(int channels) {
+    if (channels == 3) return GL_RGB;
+    if (channels == 2) return GL_LUMINANCE_ALPHA;
+    if (channels == 1) return GL_RED;
+    return GL_RGBA;
+}
+
+TextureHandle TextureCache::load(const std::string& filePath, const TextureLoadOptions& options) {
+    std::string key = makeKey(filePath, options);
+    auto it = textures.find(key);
+    if (it != textures.end()) {
+        TextureStreamer::shared().finish(it->second);
+        return it->second->isReady() ? it->second : nullptr;
+    }
+
+    int width, height, channels;
+    unsigned char* data = decode(filePath, options.flipVertically, options.desiredChannels, width, height, channels);
+    if (!data) {
+        spdlog::error("Failed to load texture: {}", filePath);
+        spdlog::error("STB Error: {}", stbi_failure_reason());
+        return nullptr;
+    }
+
+    GLuint id;
+    glGenTextures(1, &id);
+    GLState::bindTexture(id);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, options.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, options.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    GLenum format = getFormat(channels);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    stbi_image_free(data);
+
+    TextureHandle texture = std::make_shared<Texture>(id, width, height, channels);
+    textures[key] = texture;
+    spdlog::info("Loaded texture: {} ({}x{}, channels: {}, ID: {})", filePath, width, height, channels, id);
+    return texture;
+}
+
+TextureHandle TextureCache::loadAsync(const std::string& filePath, const TextureLoadOptions& options) {
+    std::string key = makeKey(filePath, options);
+    auto it = textures.find(key);
+    if (it != textures.end()) {
+        return it->second;
+    }
+
+    // Decode errors only show up later; a missing file can be reported now
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filePath, error)) {
+        spdlog::error("Failed to load texture: {} (file not found)", filePath);
+        return nullptr;
+    }
+
+    TextureHandle texture = std::make_shared<Texture>(0, 0, 0, 0);
+    textures[key] = texture;
+    TextureStreamer::shared().enqueue(texture, filePath, options);
+    return texture;
+}
+
+void TextureCache::purgeUnused() {
+    size_t purged = 0;
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.use_count() == 1) {
+            it = textures.erase(it);
+            ++purged;
+        } else {
+            ++it;
+        }
+    }
+    if (purged > 0) {
+        spdlog::info("Purged {} unused textures from cache", purged);
+    }
+}
+
+void TextureCache::clear() {
+    textures.clear();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// How an image file is decoded and uploaded. Part of the cache key, so the
+// same file loaded with different options yields separate textures.
+struct TextureLoadOptions {
+    bool flipVertically = false;  // Replaces the global stbi_set_flip_vertically_on_load toggle
+    int desiredChannels = 0;      // 0 keeps the channel count of the file
+    GLint filter = GL_NEAREST;
+};
+
+// A GL texture shared between everything that loaded the same file
+class Texture {
+public:
+    Texture(GLuint id, int width, int height, int channels);
+    ~Texture();
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
+    // Textures from loadAsync have id 0 and no size until they're uploaded
+    bool isReady() const { return id != 0; }
+
+    GLuint getID() const { return id; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChannels() const { return channels; }
+
+private:
+    friend class TextureStreamer;
+
+    GLuint id;
+    int width, height, channels;
+};
+
+using TextureHandle = std::shared_ptr<Texture>;
+
+// Decodes each image once and hands out shared handles. The cache keeps its
+// own reference, so textures survive respawns and room resets even when every
+// user has released them. purgeUnused() drops the ones nobody holds anymore;
+// GameplayManager calls it when a run ends and after loading a saved game.
+class TextureCache {
+public:
+    static TextureCache& shared();
+
+    // Returns nullptr if the file can't be decoded. A texture still loading
+    // asynchronously is finished first.
+    TextureHandle load(const std::string& filePath, const TextureLoadOptions& options = TextureLoadOptions());
+
+    // Returns a placeholder at once and decodes and uploads the file over
+    // the next frames through TextureStreamer. nullptr if the file is missing.
+    TextureHandle loadAsync(const std::string& filePath, const TextureLoadOptions& options = TextureLoadOptions());
+
+    // Release textures only the cache still references
+    void purgeUnused();
+    void clear();
+
+    int getTextureCount() const { return static_cast<int>(textures.size()); }
+
+    // Decode with an explicit flip flag, independent of the global stbi state.
+    // The caller frees the result with stbi_image_free.
+    static unsigned char* decode(const std::string& filePath, bool flipVertically, int desiredChannels,
+                                 int& width, int& height, int& channels);
+
+    // Upload format for a decoded channel count
+    static GLenum getFormat(int channels);
+
+private:
+    std::unordered_map<std::string, TextureHandle> textures;
+
+    static std::string makeKey(const std::string& filePath, const TextureLoadOptions& options);
+};
@@ -0,0 +1,234 @@
+#include "render/TextureStreamer.h"
+#include "render/GLState.h"
+#include <stb_image.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+TextureStreamer& TextureStreamer::shared() {
+    static TextureStreamer streamer;
+    return streamer;
+}
+
+TextureStreamer::~TextureStreamer() {
+    // The context is gone by now, only the threads and pixels are left
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobQueued.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (DecodedImage& image : decodedImages) {
+        stbi_image_free(image.pixels);
+    }
+    for (Upload& upload : uploads) {
+        stbi_image_free(upload.image.pixels);
+    }
+}
+
+void TextureStreamer::enqueue(const TextureHandle& texture, const std::string& filePath,
+                              const TextureLoadOptions& options) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) {
+            stopping = false;
+            for (int i = 0; i < WORKER_COUNT; ++i) {
+                workers.emplace_back(&TextureStreamer::workerLoop, this);
+            }
+        }
+        jobs.push_back({texture, filePath, options});
+    }
+    jobQueued.notify_one();
+}
+
+void TextureStreamer::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobQueued.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            ++decoding;
+        }
+
+        DecodedImage image;
+        image.pixels = TextureCache::decode(job.filePath, job.options.flipVertically, job.options.desiredChannels,
+                                            image.width, image.height, image.channels);
+        if (!image.pixels) {
+            spdlog::error("Failed to load texture: {} ({})", job.filePath, stbi_failure_reason());
+        }
+        image.job = std::move(job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decodedImages.push_back(std::move(image));
+            --decoding;
+        }
+        imageDecoded.notify_all();
+    }
+}
+
+void TextureStreamer::takeDecodedImages() {
+    std::deque<DecodedImage> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(decodedImages);
+    }
+
+    for (DecodedImage& image : ready) {
+        if (!image.pixels) continue;
+
+        // Rows are streamed into a texture of their own, which only replaces
+        // the placeholder id once it's complete
+        Upload upload;
+        glGenTextures(1, &upload.staging);
+        GLState::bindTexture(upload.staging);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, image.job.options.filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, image.job.options.filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        GLenum format = TextureCache::getFormat(image.channels);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+        upload.image = std::move(image);
+        uploads.push_back(std::move(upload));
+    }
+}
+
+void TextureStreamer::update() {
+    upload(UPLOAD_BUDGET);
+}
+
+void TextureStreamer::upload(size_t budget) {
+    takeDecodedImages();
+
+    while (budget > 0 && !uploads.empty()) {
+        Upload& upload = uploads.front();
+        TextureHandle texture = upload.image.job.texture.lock();
+        if (!texture) {
+            // Purged from the cache while loading
+            discard(upload);
+            uploads.pop_front();
+            continue;
+        }
+
+        const DecodedImage& image = upload.image;
+        size_t rowBytes = static_cast<size_t>(image.width) * image.channels;
+        int rows = static_cast<int>(std::min<size_t>(image.height - upload.nextRow,
+                                                     std::max<size_t>(1, budget / rowBytes)));
+        uploadRows(upload, rows);
+        budget -= std::min(budget, rows * rowBytes);
+
+        if (upload.nextRow < image.height) continue;
+
+        texture->id = upload.staging;
+        texture->width = image.width;
+        texture->height = image.height;
+        texture->channels = image.channels;
+        spdlog::info("Streamed texture: {} ({}x{}, channels: {}, ID: {})", image.job.filePath,
+                     image.width, image.height, image.channels, upload.staging);
+        stbi_image_free(upload.image.pixels);
+        uploads.pop_front();
+    }
+}
+
+void TextureStreamer::uploadRows(Upload& upload, int rows) {
+    const DecodedImage& image = upload.image;
+    size_t rowBytes = static_cast<size_t>(image.width) * image.channels;
+    size_t bytes = rowBytes * rows;
+    const unsigned char* source = image.pixels + rowBytes * upload.nextRow;
+
+    // Cycling buffers and orphaning their storage means writing a band never
+    // waits for the GPU to finish reading the previous one
+    if (pixelBuffers[0] == 0) {
+        glGenBuffers(PIXEL_BUFFER_COUNT, pixelBuffers);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffers[nextPixelBuffer]);
+    nextPixelBuffer = (nextPixelBuffer + 1) % PIXEL_BUFFER_COUNT;
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    const void* pixels = nullptr;  // Offset into the bound buffer
+    if (void* mapped = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)) {
+        std::memcpy(mapped, source, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    } else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pixels = source;
+    }
+
+    GLint alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // RGB rows needn't be 4-byte aligned
+    GLState::bindTexture(upload.staging);
+    GLenum format = TextureCache::getFormat(image.channels);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.nextRow, image.width, rows, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    upload.nextRow += rows;
+}
+
+bool TextureStreamer::isQueued(const Texture* texture) const {
+    for (const Upload& upload : uploads) {
+        if (upload.image.job.texture.lock().get() == texture) return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (decoding > 0 || !decodedImages.empty()) return true;
+    return std::any_of(jobs.begin(), jobs.end(),
+                       [texture](const Job& job) { return job.texture.lock().get() == texture; });
+}
+
+void TextureStreamer::finish(const TextureHandle& texture) {
+    while (texture && !texture->isReady() && isQueued(texture.get())) {
+        upload(std::numeric_limits<size_t>::max());
+        if (texture->isReady()) break;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        imageDecoded.wait(lock, [this] { return !decodedImages.empty() || (decoding == 0 && jobs.empty()); });
+    }
+}
+
+int TextureStreamer::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(jobs.size() + decodedImages.size() + uploads.size()) + decoding;
+}
+
+void TextureStreamer::discard(Upload& upload) {
+    stbi_image_free(upload.image.pixels);
+    upload.image.pixels = nullptr;
+    if (upload.staging != 0) {
+        GLState::deleteTextures(1, &upload.staging);
+        upload.staging = 0;
+    }
+}
+
+void TextureStreamer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobQueued.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (DecodedImage& image : decodedImages) {
+        stbi_image_free(image.pixels);
+    }
+    decodedImages.clear();
+    for (Upload& upload : uploads) {
+        discard(upload);
+    }
+    uploads.clear();
+
+    if (pixelBuffers[0] != 0) {
+        glDeleteBuffers(PIXEL_BUFFER_COUNT, pixelBuffers);
+        std::fill(std::begin(pixelBuffers), std::end(pixelBuffers), 0);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "render/TextureCache.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads textures without stalling the frame. Worker threads decode the
+// files; update() then copies a bounded number of bytes per frame into the
+// textures through a small ring of pixel buffer objects. A texture stays at
+// id 0 until its last row is in, so nothing ever samples a half-filled one.
+//
+// Everything except the decoding runs on the thread that owns the context.
+class TextureStreamer {
+public:
+    static TextureStreamer& shared();
+
+    // Decode filePath in the background and fill in texture when done.
+    // Workers are started on first use.
+    void enqueue(const TextureHandle& texture, const std::string& filePath, const TextureLoadOptions& options);
+
+    // Upload what the workers have decoded, up to UPLOAD_BUDGET bytes. Call
+    // once per frame.
+    void update();
+
+    // Block until texture is uploaded, for callers that can't wait a frame.
+    // Returns at once if the texture isn't queued or its decode failed.
+    void finish(const TextureHandle& texture);
+
+    // Textures queued, decoding or partly uploaded
+    int getPendingCount() const;
+
+    // Stop the workers and free the pixel buffers while the context is alive
+    void shutdown();
+
+private:
+    static constexpr int WORKER_COUNT = 2;
+    static constexpr int PIXEL_BUFFER_COUNT = 3;
+    static constexpr size_t UPLOAD_BUDGET = 2 * 1024 * 1024;  // Bytes per frame
+
+    struct Job {
+        std::weak_ptr<Texture> texture;
+        std::string filePath;
+        TextureLoadOptions options;
+    };
+
+    struct DecodedImage {
+        Job job;
+        unsigned char* pixels = nullptr;  // nullptr if the decode failed
+        int width = 0, height = 0, channels = 0;
+    };
+
+    struct Upload {
+        DecodedImage image;
+        GLuint staging = 0;  // Becomes the texture's id once every row is in
+        int nextRow = 0;
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+
+    // Shared with the workers, guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable jobQueued;
+    std::condition_variable imageDecoded;
+    std::deque<Job> jobs;
+    std::deque<DecodedImage> decodedImages;
+    int decoding = 0;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    // Main thread only
+    std::deque<Upload> uploads;
+    GLuint pixelBuffers[PIXEL_BUFFER_COUNT] = {};
+    int nextPixelBuffer = 0;
+
+    void workerLoop();
+    void takeDecodedImages();
+    void upload(size_t budget);
+    void uploadRows(Upload& upload, int rows);
+    bool isQueued(const Texture* texture) const;
+    static void discard(Upload& upload);
+};
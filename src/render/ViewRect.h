@@ -0,0 +1,18 @@
+#pragma once
+
+// Axis-aligned region of the world that is currently visible, in world units
+struct ViewRect {
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+
+    bool intersects(float minX, float minY, float maxX, float maxY) const {
+        return maxX > left && minX < right && maxY > top && minY < bottom;
+    }
+
+    // Grow the rect by the given margin on every side
+    ViewRect expanded(float margin) const {
+        return {left - margin, top - margin, right + margin, bottom + margin};
+    }
+};
@@ -3,7 +3,6 @@
 #include "enemy/Enemy.h"
 #include "projectile/Projectile.h"
 #include "map/TileMap.h"
-#include <stb_image.h>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -143,7 +142,6 @@ SaveData GameStateManager::createSaveData(Player* player,
 
 void GameStateManager::loadEnemyTextures(Enemy* enemy, EnemyType type, const std::string& assetPath) {
     spdlog::info("Loading textures for enemy type {} with asset path: {}", static_cast<int>(type), assetPath);
-    stbi_set_flip_vertically_on_load(true);
     
     if (type == EnemyType::FlyingEye) {
         std::string texturePath = assetPath + "assets/graphic/enemies/flying_eye/flgyingeye.png";
@@ -165,13 +163,11 @@ void GameStateManager::loadEnemyTextures(Enemy* enemy, EnemyType type, const std
         enemy->loadDeathTexture(deathPath, 150, 150, 4);
     }
     
-    stbi_set_flip_vertically_on_load(false);
     spdlog::info("Enemy textures loaded successfully");
 }
 
 void GameStateManager::loadPlayerTextures(Player* player, const std::string& assetPath) {
     spdlog::info("Loading player textures with asset path: {}", assetPath);
-    stbi_set_flip_vertically_on_load(true);
     
     std::string walkPath = assetPath + "assets/graphic/enemies/vampire/Vampire_Walk.png";
     std::string idlePath = assetPath + "assets/graphic/enemies/vampire/Vampire_Idle.png";
@@ -179,6 +175,5 @@ void GameStateManager::loadPlayerTextures(Player* player, const std::string& ass
     spdlog::info("Loading player textures: {}, {}", walkPath, idlePath);
     player->loadTexture(walkPath, 64, 64, 4);
     player->loadIdleTexture(idlePath, 64, 64, 2);
-    stbi_set_flip_vertically_on_load(false);
     spdlog::info("Player textures loaded successfully");
 }
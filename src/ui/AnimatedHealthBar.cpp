@@ -1,6 +1,8 @@
 #include "AnimatedHealthBar.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
 #include <spdlog/spdlog.h>
 
 AnimatedHealthBar::AnimatedHealthBar()
@@ -8,9 +10,9 @@ AnimatedHealthBar::AnimatedHealthBar()
       frameWidth(0), frameHeight(0),
       barWidth(280.0f), barHeight(22.0f), barX(0.0f), barY(0.0f),
       initialized(false) {
-    // Initialize all texture IDs to 0
+    // No regions until the textures are registered with the atlas
     for (int i = 0; i < 6; i++) {
-        healthTextures[i] = 0;
+        healthRegions[i] = INVALID_ATLAS_HANDLE;
     }
 }
 
@@ -36,53 +38,30 @@ void AnimatedHealthBar::loadHealthTextures(const std::string& assetPath) {
         
         spdlog::info("Attempting to load health texture: {}", healthFile);
         
-        int width, height, channels;
-        unsigned char* data = stbi_load(healthFile.c_str(), &width, &height, &channels, 4); // Force 4 channels (RGBA)
-        if (!data) {
+        // Packed into the shared atlas, which owns the GL texture
+        healthRegions[i] = TextureAtlas::shared().addImage(healthFile);
+        if (healthRegions[i] == INVALID_ATLAS_HANDLE) {
             spdlog::error("Failed to load health texture: {}", healthFile);
-            spdlog::error("STB Error: {}", stbi_failure_reason());
-            healthTextures[i] = 0;
             continue;
         }
         
         // Set texture dimensions from first loaded texture
+        const AtlasRegion& region = TextureAtlas::shared().getRegion(healthRegions[i]);
         if (i == 0) {
-            textureWidth = width;
-            textureHeight = height;
-            frameWidth = width;
-            frameHeight = height;
+            textureWidth = region.width;
+            textureHeight = region.height;
+            frameWidth = region.width;
+            frameHeight = region.height;
         }
         
-        spdlog::info("Loaded health texture: {} ({}x{}, channels: {})", 
-                     healthFile, width, height, channels);
-        
-        glGenTextures(1, &healthTextures[i]);
-        glBindTexture(GL_TEXTURE_2D, healthTextures[i]);
-        
-        // Use NEAREST filtering for pixel-perfect graphics
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        
-        // Always use RGBA format since we forced 4 channels
-        GLenum format = GL_RGBA;
-        GLenum internalFormat = GL_RGBA;
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        stbi_image_free(data);
-        
-        spdlog::info("Health texture {} uploaded to OpenGL successfully, textureID: {}", 
-                     healthPercentages[i], healthTextures[i]);
+        spdlog::info("Loaded health texture: {} ({}x{})", healthFile, region.width, region.height);
     }
 }
 
 void AnimatedHealthBar::cleanupTextures() {
+    // The atlas owns the textures, just forget the regions
     for (int i = 0; i < 6; i++) {
-        if (healthTextures[i] != 0) {
-            glDeleteTextures(1, &healthTextures[i]);
-            healthTextures[i] = 0;
-        }
+        healthRegions[i] = INVALID_ATLAS_HANDLE;
     }
 }
 
@@ -110,17 +89,11 @@ void AnimatedHealthBar::draw(int currentHealth, int maxHealth, int windowWidth,
     
     // Get the appropriate health sprite index
     int healthIndex = getHealthLevelIndex(currentHealth, maxHealth);
-    if (healthTextures[healthIndex] == 0) return;
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(healthRegions[healthIndex]);
+    if (region.texture == 0) return;
     
     // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    RenderBackend::pushOrtho(0, windowWidth, windowHeight, 0);
     
     // Set health bar position and make it bigger, moved more to the right
     barX = 80.0f + barWidth / 2.0f; // Moved from 150.0f to 170.0f to move further right
@@ -138,46 +111,43 @@ void AnimatedHealthBar::draw(int currentHealth, int maxHealth, int windowWidth,
     float handsY = barY - scaledBarHeight / 2.0f;
     
     // Draw the appropriate health sprite rotated 90 degrees and scaled up
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);  // Enable blending for transparency
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Standard alpha blending
-    glBindTexture(GL_TEXTURE_2D, healthTextures[healthIndex]);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);  // Enable blending for transparency
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Standard alpha blending
+    GLState::bindTexture(region.texture);
     
     // Draw the health sprite with 90-degree rotation and proper scaling
     // Rotate 90 degrees by swapping UV coordinates and vertices
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);  // Use Color4f to include alpha channel
-    glBegin(GL_QUADS);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);  // Use Color4f to include alpha channel
+    GLState::begin(GL_QUADS);
     // Rotated 90 degrees: original top-left becomes bottom-left
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(handsX, handsY + scaledBarHeight);
+    glTexCoord2f(region.mapU(0.0f), region.mapV(1.0f)); glVertex2f(handsX, handsY + scaledBarHeight);
     // Original top-right becomes top-left
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(handsX + scaledBarWidth, handsY + scaledBarHeight);
+    glTexCoord2f(region.mapU(1.0f), region.mapV(1.0f)); glVertex2f(handsX + scaledBarWidth, handsY + scaledBarHeight);
     // Original bottom-right becomes top-right
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(handsX + scaledBarWidth, handsY);
+    glTexCoord2f(region.mapU(1.0f), region.mapV(0.0f)); glVertex2f(handsX + scaledBarWidth, handsY);
     // Original bottom-left becomes bottom-right
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(handsX, handsY);
+    glTexCoord2f(region.mapU(0.0f), region.mapV(0.0f)); glVertex2f(handsX, handsY);
     glEnd();
     
     // Draw a subtle border
-    glDisable(GL_TEXTURE_2D);
-    glColor3f(0.2f, 0.2f, 0.2f);
-    glBegin(GL_LINE_LOOP);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::color(0.2f, 0.2f, 0.2f);
+    GLState::begin(GL_LINE_LOOP);
     glVertex2f(handsX, handsY);
     glVertex2f(handsX + scaledBarWidth, handsY);
     glVertex2f(handsX + scaledBarWidth, handsY + scaledBarHeight);
     glVertex2f(handsX, handsY + scaledBarHeight);
     glEnd();
     
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
+    GLState::color(1.0f, 1.0f, 1.0f);  // Reset color
     
     // Restore matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RenderBackend::popOrtho();
     
     // Re-enable textures and disable blending
-    glEnable(GL_TEXTURE_2D);
-    glDisable(GL_BLEND);  // Disable blending to avoid affecting other rendering
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::disable(GL_BLEND);  // Disable blending to avoid affecting other rendering
 }
 
 void AnimatedHealthBar::cleanup() {
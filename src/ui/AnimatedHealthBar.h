@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "render/TextureAtlas.h"
 
 class AnimatedHealthBar {
 public:
@@ -12,8 +13,8 @@ public:
     void cleanup();
 
 private:
-    // Array of texture IDs for different health levels (100%, 80%, 60%, 40%, 20%, 0%)
-    unsigned int healthTextures[6];
+    // Atlas regions for different health levels (100%, 80%, 60%, 40%, 20%, 0%)
+    AtlasHandle healthRegions[6];
     int textureWidth, textureHeight;
     int frameWidth, frameHeight;
     
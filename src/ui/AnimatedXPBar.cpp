@@ -1,6 +1,8 @@
 #include "AnimatedXPBar.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
 #include <spdlog/spdlog.h>
 
 AnimatedXPBar::AnimatedXPBar()
@@ -8,9 +10,9 @@ AnimatedXPBar::AnimatedXPBar()
       frameWidth(0), frameHeight(0),
       barWidth(300.0f), barHeight(20.0f), barX(0.0f), barY(0.0f),
       initialized(false) {
-    // Initialize all texture IDs to 0
+    // No regions until the textures are registered with the atlas
     for (int i = 0; i < 5; i++) {
-        xpTextures[i] = 0;
+        xpRegions[i] = INVALID_ATLAS_HANDLE;
     }
 }
 
@@ -34,53 +36,30 @@ void AnimatedXPBar::loadXPTextures(const std::string& assetPath) {
         
         spdlog::info("Attempting to load XP texture: {}", xpFile);
         
-        int width, height, channels;
-        unsigned char* data = stbi_load(xpFile.c_str(), &width, &height, &channels, 4); // Force 4 channels (RGBA)
-        if (!data) {
+        // Packed into the shared atlas, which owns the GL texture
+        xpRegions[i] = TextureAtlas::shared().addImage(xpFile);
+        if (xpRegions[i] == INVALID_ATLAS_HANDLE) {
             spdlog::error("Failed to load XP texture: {}", xpFile);
-            spdlog::error("STB Error: {}", stbi_failure_reason());
-            xpTextures[i] = 0;
             continue;
         }
         
         // Set texture dimensions from first loaded texture
+        const AtlasRegion& region = TextureAtlas::shared().getRegion(xpRegions[i]);
         if (i == 0) {
-            textureWidth = width;
-            textureHeight = height;
-            frameWidth = width;
-            frameHeight = height;
+            textureWidth = region.width;
+            textureHeight = region.height;
+            frameWidth = region.width;
+            frameHeight = region.height;
         }
         
-        spdlog::info("Loaded XP texture: {} ({}x{}, channels: {})", 
-                     xpFile, width, height, channels);
-        
-        glGenTextures(1, &xpTextures[i]);
-        glBindTexture(GL_TEXTURE_2D, xpTextures[i]);
-        
-        // Use NEAREST filtering for pixel-perfect graphics
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        
-        // Always use RGBA format since we forced 4 channels
-        GLenum format = GL_RGBA;
-        GLenum internalFormat = GL_RGBA;
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        stbi_image_free(data);
-        
-        spdlog::info("XP texture {} uploaded to OpenGL successfully, textureID: {}", 
-                     i + 1, xpTextures[i]);
+        spdlog::info("Loaded XP texture: {} ({}x{})", xpFile, region.width, region.height);
     }
 }
 
 void AnimatedXPBar::cleanupTextures() {
+    // The atlas owns the textures, just forget the regions
     for (int i = 0; i < 5; i++) {
-        if (xpTextures[i] != 0) {
-            glDeleteTextures(1, &xpTextures[i]);
-            xpTextures[i] = 0;
-        }
+        xpRegions[i] = INVALID_ATLAS_HANDLE;
     }
 }
 
@@ -114,17 +93,11 @@ void AnimatedXPBar::draw(int currentXP, int maxXP, int windowWidth, int windowHe
 void AnimatedXPBar::drawWithState(int xpState, int windowWidth, int windowHeight) {
     if (!initialized || xpState < 0 || xpState >= 5) return;
     
-    if (xpTextures[xpState] == 0) return;
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(xpRegions[xpState]);
+    if (region.texture == 0) return;
     
     // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    RenderBackend::pushOrtho(0, windowWidth, windowHeight, 0);
     
     // Set XP bar position (same as original XP bar)
     barX = 960.0f;  // Center horizontally
@@ -140,29 +113,26 @@ void AnimatedXPBar::drawWithState(int xpState, int windowWidth, int windowHeight
     float xpBarY = barY - scaledBarHeight / 2.0f;
     
     // Draw the appropriate XP sprite
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);  // Enable blending for transparency
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Standard alpha blending
-    glBindTexture(GL_TEXTURE_2D, xpTextures[xpState]);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);  // Enable blending for transparency
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Standard alpha blending
+    GLState::bindTexture(region.texture);
     
     // Draw the XP sprite
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);  // Use Color4f to include alpha channel
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(xpBarX, xpBarY);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(xpBarX + scaledBarWidth, xpBarY);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(xpBarX + scaledBarWidth, xpBarY + scaledBarHeight);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(xpBarX, xpBarY + scaledBarHeight);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);  // Use Color4f to include alpha channel
+    GLState::begin(GL_QUADS);
+    glTexCoord2f(region.mapU(0.0f), region.mapV(0.0f)); glVertex2f(xpBarX, xpBarY);
+    glTexCoord2f(region.mapU(1.0f), region.mapV(0.0f)); glVertex2f(xpBarX + scaledBarWidth, xpBarY);
+    glTexCoord2f(region.mapU(1.0f), region.mapV(1.0f)); glVertex2f(xpBarX + scaledBarWidth, xpBarY + scaledBarHeight);
+    glTexCoord2f(region.mapU(0.0f), region.mapV(1.0f)); glVertex2f(xpBarX, xpBarY + scaledBarHeight);
     glEnd();
     
     // Disable blending and texture
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
+    GLState::disable(GL_BLEND);
+    GLState::disable(GL_TEXTURE_2D);
     
     // Restore matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RenderBackend::popOrtho();
 }
 
 void AnimatedXPBar::cleanup() {
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "render/TextureAtlas.h"
 
 class AnimatedXPBar {
 public:
@@ -13,8 +14,8 @@ public:
     void cleanup();
 
 private:
-    // Array of texture IDs for different XP states (xpbar_01 to xpbar_05)
-    unsigned int xpTextures[5];
+    // Atlas regions for different XP states (xpbar_01 to xpbar_05)
+    AtlasHandle xpRegions[5];
     int textureWidth, textureHeight;
     int frameWidth, frameHeight;
     
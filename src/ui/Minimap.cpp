@@ -0,0 +1,182 @@
+#include "ui/Minimap.h"
+#include "map/TileMap.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include "render/SpriteBatch.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // The texture has a one texel frame around the map
+    constexpr int BORDER = 1;
+    const unsigned char FRAME_COLOR[4] = {210, 210, 220, 255};
+    const unsigned char WALL_COLOR[4] = {140, 140, 155, 235};
+    const unsigned char FLOOR_COLOR[4] = {30, 30, 40, 200};
+    const unsigned char EMPTY_COLOR[4] = {0, 0, 0, 120};
+    const unsigned char GATE_COLOR[4] = {110, 220, 255, 255};
+
+    // A texel covering several tiles shows the most important of them
+    enum TileKind { TILE_EMPTY, TILE_FLOOR, TILE_WALL, TILE_GATE };
+    const unsigned char* const KIND_COLORS[] = {EMPTY_COLOR, FLOOR_COLOR, WALL_COLOR, GATE_COLOR};
+
+    TileKind getTileKind(const Tilemap& tilemap, int x, int y) {
+        if (tilemap.isGateTile(x, y)) return TILE_GATE;
+        if (tilemap.isTileSolid(x, y)) return TILE_WALL;
+        if (tilemap.getNormalizedTileIdAt(x, y) != 0) return TILE_FLOOR;
+        return TILE_EMPTY;
+    }
+}
+
+Minimap::Minimap()
+    : texture(0), mapWidth(0), mapHeight(0), tilesPerTexel(1), texelsX(0), texelsY(0), tileWidth(0), tileHeight(0),
+      generation(0), appliedEdits(0) {
+}
+
+Minimap::~Minimap() {
+    release();
+}
+
+void Minimap::release() {
+    if (texture != 0) {
+        GLState::deleteTextures(1, &texture);
+        texture = 0;
+    }
+    generation = 0;
+    appliedEdits = 0;
+}
+
+void Minimap::getTexelColor(const Tilemap& tilemap, int texelX, int texelY, unsigned char* rgba) const {
+    int left = texelX * tilesPerTexel;
+    int top = texelY * tilesPerTexel;
+    int right = std::min(mapWidth, left + tilesPerTexel);
+    int bottom = std::min(mapHeight, top + tilesPerTexel);
+    TileKind kind = TILE_EMPTY;
+    for (int y = top; y < bottom && kind != TILE_GATE; ++y) {
+        for (int x = left; x < right && kind != TILE_GATE; ++x) {
+            kind = std::max(kind, getTileKind(tilemap, x, y));
+        }
+    }
+    const unsigned char* color = KIND_COLORS[kind];
+    std::copy(color, color + 4, rgba);
+}
+
+void Minimap::build(const Tilemap& tilemap) {
+    mapWidth = tilemap.getWidthInTiles();
+    mapHeight = tilemap.getHeightInTiles();
+    tileWidth = tilemap.getTileWidth();
+    tileHeight = tilemap.getTileHeight();
+    generation = tilemap.getGeneration();
+    appliedEdits = tilemap.getEditedTiles().size();
+    if (mapWidth <= 0 || mapHeight <= 0) return;
+
+    // No more texels a side than the minimap has pixels
+    int maxTexels = static_cast<int>(MAX_EXTENT) - 2 * BORDER;
+    tilesPerTexel = (std::max(mapWidth, mapHeight) + maxTexels - 1) / maxTexels;
+    texelsX = (mapWidth + tilesPerTexel - 1) / tilesPerTexel;
+    texelsY = (mapHeight + tilesPerTexel - 1) / tilesPerTexel;
+
+    int textureWidth = texelsX + 2 * BORDER;
+    int textureHeight = texelsY + 2 * BORDER;
+    std::vector<unsigned char> pixels(static_cast<size_t>(textureWidth) * textureHeight * 4);
+    for (int y = 0; y < textureHeight; ++y) {
+        for (int x = 0; x < textureWidth; ++x) {
+            unsigned char* pixel = &pixels[(static_cast<size_t>(y) * textureWidth + x) * 4];
+            bool frame = x < BORDER || y < BORDER || x >= texelsX + BORDER || y >= texelsY + BORDER;
+            if (frame) {
+                std::copy(FRAME_COLOR, FRAME_COLOR + 4, pixel);
+            } else {
+                getTexelColor(tilemap, x - BORDER, y - BORDER, pixel);
+            }
+        }
+    }
+
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+    GLState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeight, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    spdlog::debug("Minimap built for a {}x{} map, {} tiles per texel", mapWidth, mapHeight, tilesPerTexel);
+}
+
+void Minimap::update(const Tilemap& tilemap) {
+    if (texture == 0 || generation != tilemap.getGeneration()) {
+        build(tilemap);
+        return;
+    }
+
+    const std::vector<std::pair<int, int>>& edits = tilemap.getEditedTiles();
+    if (appliedEdits == edits.size()) return;
+
+    GLState::bindTexture(texture);
+    for (size_t i = appliedEdits; i < edits.size(); ++i) {
+        // The edited tile's whole block is looked at again, since another
+        // tile in it may now decide the color
+        int texelX = edits[i].first / tilesPerTexel;
+        int texelY = edits[i].second / tilesPerTexel;
+        unsigned char pixel[4];
+        getTexelColor(tilemap, texelX, texelY, pixel);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, texelX + BORDER, texelY + BORDER, 1, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    }
+    appliedEdits = edits.size();
+}
+
+void Minimap::clearMarkers() {
+    markers.clear();
+}
+
+void Minimap::addMarker(float worldX, float worldY, float r, float g, float b) {
+    if (tileWidth <= 0 || tileHeight <= 0) return;
+    markers.push_back({worldX / tileWidth, worldY / tileHeight, r, g, b});
+}
+
+void Minimap::draw(SpriteBatch& batch, int windowWidth, int windowHeight) {
+    if (texture == 0) return;
+
+    // Whole screen pixels per texel when the map is small enough, so tiles stay square
+    float textureWidth = static_cast<float>(texelsX + 2 * BORDER);
+    float textureHeight = static_cast<float>(texelsY + 2 * BORDER);
+    float scale = std::min(MAX_EXTENT / textureWidth, MAX_EXTENT / textureHeight);
+    if (scale >= 1.0f) scale = std::floor(scale);
+    float width = textureWidth * scale;
+    float height = textureHeight * scale;
+    float left = windowWidth - MARGIN - width;
+    float top = windowHeight - MARGIN - height;
+
+    RenderBackend::pushOrtho(0, windowWidth, windowHeight, 0);
+
+    batch.begin();
+    Sprite map;
+    map.texture = texture;
+    map.x = left;
+    map.y = top;
+    map.width = width;
+    map.height = height;
+    map.layer = SpriteLayer::Effect;
+    batch.submit(map);
+
+    // In front of the map whatever the texture ids, and one run between them
+    Sprite marker;
+    marker.texture = batch.getCircleTexture();
+    marker.width = MARKER_SIZE;
+    marker.height = MARKER_SIZE;
+    marker.layer = SpriteLayer::Effect;
+    marker.depth = 1.0f;
+    for (const Marker& entry : markers) {
+        marker.x = left + (entry.x / tilesPerTexel + BORDER) * scale - MARKER_SIZE / 2.0f;
+        marker.y = top + (entry.y / tilesPerTexel + BORDER) * scale - MARKER_SIZE / 2.0f;
+        marker.r = entry.r;
+        marker.g = entry.g;
+        marker.b = entry.b;
+        batch.submit(marker);
+    }
+    batch.flush();
+
+    RenderBackend::popOrtho();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <vector>
+
+class Tilemap;
+class SpriteBatch;
+
+// Overview of the level in the bottom-right corner of the HUD. The map is a
+// texture with one texel per tile, or per square block of tiles on maps too
+// big to show a texel per tile, built when a level loads and patched a texel
+// at a time when tiles are edited, so a frame only draws two quads' worth of
+// state: the map and a single batch of entity markers.
+class Minimap {
+public:
+    Minimap();
+    ~Minimap();
+
+    Minimap(const Minimap&) = delete;
+    Minimap& operator=(const Minimap&) = delete;
+
+    // Bring the texture in line with tilemap. Does nothing unless the map
+    // was reloaded or had tiles edited since the last call.
+    void update(const Tilemap& tilemap);
+
+    void clearMarkers();
+    // A dot at a world position, in the given color
+    void addMarker(float worldX, float worldY, float r, float g, float b);
+
+    // Draws through batch, which must not be between begin() and flush()
+    void draw(SpriteBatch& batch, int windowWidth, int windowHeight);
+
+    void release();
+
+private:
+    struct Marker {
+        float x, y;  // In tiles
+        float r, g, b;
+    };
+
+    static constexpr float MAX_EXTENT = 200.0f;  // Longest side on screen, in pixels
+    static constexpr float MARGIN = 20.0f;
+    static constexpr float MARKER_SIZE = 6.0f;
+
+    GLuint texture;
+    int mapWidth, mapHeight;  // In tiles
+    int tilesPerTexel;        // Side of the block of tiles each texel shows
+    int texelsX, texelsY;     // Map area of the texture, without the frame
+    int tileWidth, tileHeight;
+    unsigned int generation;  // Tilemap generation the texture was built from
+    size_t appliedEdits;      // Edited tiles already patched into the texture
+    std::vector<Marker> markers;
+
+    void build(const Tilemap& tilemap);
+    void getTexelColor(const Tilemap& tilemap, int texelX, int texelY, unsigned char* rgba) const;
+};
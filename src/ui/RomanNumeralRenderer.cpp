@@ -1,6 +1,7 @@
 #include "ui/RomanNumeralRenderer.h"
+#include "render/GLState.h"
 #include <spdlog/spdlog.h>
-#include <stb_image.h>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 RomanNumeralRenderer::RomanNumeralRenderer() : isInitialized(false) {
@@ -37,39 +38,20 @@ bool RomanNumeralRenderer::initialize(const std::string& assetPath) {
 }
 
 bool RomanNumeralRenderer::loadNumeralTexture(const std::string& filepath, char symbol) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
-    
-    if (!data) {
+    AtlasHandle handle = TextureAtlas::shared().addImage(filepath);
+    if (handle == INVALID_ATLAS_HANDLE) {
         spdlog::error("Failed to load Roman numeral texture: {}", filepath);
         return false;
     }
     
-    spdlog::info("Loaded Roman numeral '{}': {} ({}x{}, {} channels)", 
-                 symbol, filepath, width, height, channels);
-    
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Use NEAREST filtering to maintain pixel art look
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    GLenum format = GL_RGBA;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
+    const AtlasRegion& region = TextureAtlas::shared().getRegion(handle);
+    spdlog::info("Loaded Roman numeral '{}': {} ({}x{})", 
+                 symbol, filepath, region.width, region.height);
     
     NumeralTexture tex;
-    tex.textureID = textureID;
-    tex.width = width;
-    tex.height = height;
+    tex.region = handle;
+    tex.width = region.width;
+    tex.height = region.height;
     
     numeralTextures[symbol] = tex;
     
@@ -118,6 +100,37 @@ void RomanNumeralRenderer::drawRomanNumeral(int number, float x, float y, float
         return;
     }
     
+    std::vector<NumeralQuad> quads;
+    layoutRomanNumeral(number, x, y, scale, quads);
+    if (quads.empty()) {
+        return;
+    }
+    
+    // Enable blending for transparent backgrounds
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f);
+    
+    for (const NumeralQuad& quad : quads) {
+        const AtlasRegion& region = TextureAtlas::shared().getRegion(quad.region);
+        GLState::bindTexture(region.texture);
+        
+        GLState::begin(GL_QUADS);
+        glTexCoord2f(region.u1, region.v1); glVertex2f(quad.x, quad.y);
+        glTexCoord2f(region.u2, region.v1); glVertex2f(quad.x + quad.width, quad.y);
+        glTexCoord2f(region.u2, region.v2); glVertex2f(quad.x + quad.width, quad.y + quad.height);
+        glTexCoord2f(region.u1, region.v2); glVertex2f(quad.x, quad.y + quad.height);
+        glEnd();
+    }
+}
+
+void RomanNumeralRenderer::layoutRomanNumeral(int number, float x, float y, float scale,
+                                              std::vector<NumeralQuad>& out) const {
+    if (!isInitialized) {
+        return;
+    }
+    
     std::string romanStr = toRomanNumeral(number);
     if (romanStr == "?") {
         return;
@@ -125,13 +138,7 @@ void RomanNumeralRenderer::drawRomanNumeral(int number, float x, float y, float
     
     float currentX = x;
     
-    // Enable blending for transparent backgrounds
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_TEXTURE_2D);
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    
-    // Draw each symbol
+    // Place each symbol
     for (size_t i = 0; i < romanStr.length(); i++) {
         char symbol = romanStr[i];
         
@@ -142,51 +149,43 @@ void RomanNumeralRenderer::drawRomanNumeral(int number, float x, float y, float
             // Check if this is a subtractive pair (like IV, IX, XL, XC)
             if ((symbol == 'I' && (nextSymbol == 'V' || nextSymbol == 'X')) ||
                 (symbol == 'X' && (nextSymbol == 'L' || nextSymbol == 'C'))) {
-                // Draw both symbols close together for subtractive notation
-                drawSymbol(symbol, currentX, y, scale);
-                auto it = numeralTextures.find(symbol);
-                if (it != numeralTextures.end()) {
-                    currentX += it->second.width * scale * 0.6f; // Closer spacing
-                }
-                drawSymbol(nextSymbol, currentX, y, scale);
-                it = numeralTextures.find(nextSymbol);
-                if (it != numeralTextures.end()) {
-                    currentX += it->second.width * scale + 2.0f * scale; // Small gap
+                // Place both symbols close together for subtractive notation
+                float width = placeSymbol(symbol, currentX, y, scale, out);
+                currentX += width * 0.6f; // Closer spacing
+                width = placeSymbol(nextSymbol, currentX, y, scale, out);
+                if (width > 0.0f) {
+                    currentX += width + 2.0f * scale; // Small gap
                 }
-                i++; // Skip next symbol since we already drew it
+                i++; // Skip next symbol since we already placed it
                 continue;
             }
         }
         
-        // Regular symbol drawing
-        drawSymbol(symbol, currentX, y, scale);
-        auto it = numeralTextures.find(symbol);
-        if (it != numeralTextures.end()) {
-            currentX += it->second.width * scale + 2.0f * scale; // Small gap between symbols
+        // Regular symbol
+        float width = placeSymbol(symbol, currentX, y, scale, out);
+        if (width > 0.0f) {
+            currentX += width + 2.0f * scale; // Small gap between symbols
         }
     }
 }
 
-void RomanNumeralRenderer::drawSymbol(char symbol, float x, float y, float scale) {
+float RomanNumeralRenderer::placeSymbol(char symbol, float x, float y, float scale,
+                                        std::vector<NumeralQuad>& out) const {
     auto it = numeralTextures.find(symbol);
     if (it == numeralTextures.end()) {
         spdlog::warn("Roman numeral symbol '{}' not found", symbol);
-        return;
+        return 0.0f;
     }
     
     const NumeralTexture& tex = it->second;
-    
     float width = tex.width * scale;
     float height = tex.height * scale;
     
-    glBindTexture(GL_TEXTURE_2D, tex.textureID);
-    
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(x, y);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(x + width, y);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(x + width, y + height);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(x, y + height);
-    glEnd();
+    // Symbols whose atlas page isn't built yet take up space but draw nothing
+    if (TextureAtlas::shared().getRegion(tex.region).texture != 0) {
+        out.push_back({tex.region, x, y, width, height});
+    }
+    return width;
 }
 
 float RomanNumeralRenderer::getRomanNumeralWidth(int number, float scale) const {
@@ -228,9 +227,7 @@ float RomanNumeralRenderer::getRomanNumeralWidth(int number, float scale) const
 }
 
 void RomanNumeralRenderer::cleanup() {
-    for (auto& pair : numeralTextures) {
-        glDeleteTextures(1, &pair.second.textureID);
-    }
+    // The atlas owns the textures
     numeralTextures.clear();
     isInitialized = false;
     spdlog::info("RomanNumeralRenderer cleaned up");
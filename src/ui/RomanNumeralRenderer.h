@@ -1,7 +1,16 @@
 #pragma once
 #include <string>
 #include <map>
+#include <vector>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include "render/TextureAtlas.h"
+
+// One numeral symbol placed on screen; (x, y) is the bottom-left corner
+struct NumeralQuad {
+    AtlasHandle region;
+    float x, y, width, height;
+};
 
 class RomanNumeralRenderer {
 public:
@@ -16,6 +25,9 @@ public:
     
     // Draw Roman numeral at specified position
     void drawRomanNumeral(int number, float x, float y, float scale = 1.0f);
+
+    // Place the symbols of a Roman numeral without drawing them
+    void layoutRomanNumeral(int number, float x, float y, float scale, std::vector<NumeralQuad>& out) const;
     
     // Get width of a Roman numeral rendering (for positioning)
     float getRomanNumeralWidth(int number, float scale = 1.0f) const;
@@ -25,7 +37,7 @@ public:
     
 private:
     struct NumeralTexture {
-        GLuint textureID;
+        AtlasHandle region;  // Packed into the shared atlas
         int width;
         int height;
     };
@@ -33,10 +45,10 @@ private:
     std::map<char, NumeralTexture> numeralTextures;  // I, V, X, C
     bool isInitialized;
     
-    // Load a single numeral texture
+    // Register a single numeral texture with the atlas
     bool loadNumeralTexture(const std::string& filepath, char symbol);
     
-    // Draw a single numeral symbol at position
-    void drawSymbol(char symbol, float x, float y, float scale);
+    // Place a single numeral symbol and return its width, 0 if it's missing
+    float placeSymbol(char symbol, float x, float y, float scale, std::vector<NumeralQuad>& out) const;
 };
 
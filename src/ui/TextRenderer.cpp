@@ -1,9 +1,19 @@
 #include "ui/TextRenderer.h"
+#include "render/GLState.h"
+#include "render/RectPacker.h"
+#include "render/RenderBackend.h"
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 #include <glm/gtc/matrix_transform.hpp>
 #include <spdlog/spdlog.h>
 
-TextRenderer::TextRenderer() : initialized(false), VBO(0), shaderProgram(0), ft(nullptr), face(nullptr) {
+namespace {
+    constexpr int MIN_ATLAS_SIZE = 128;
+    constexpr int GLYPH_PADDING = 1;  // Transparent gap so neighbouring glyphs never bleed
+}
+
+TextRenderer::TextRenderer() : atlasTexture(0), atlasWidth(0), atlasHeight(0), VBO(0), ft(nullptr), face(nullptr), initialized(false) {
     // Initialize FreeType
     if (FT_Init_FreeType(&ft)) {
         spdlog::error("ERROR::FREETYPE: Could not init FreeType Library");
@@ -39,105 +49,169 @@ bool TextRenderer::init(const std::string& fontPath, unsigned int fontSize) {
     // Set font size
     FT_Set_Pixel_Sizes(face, 0, fontSize);
     
-    // Disable byte-alignment restriction
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    
-    // Load first 128 characters of ASCII set
-    for (unsigned char c = 0; c < 128; c++) {
+    // Render every glyph first so they can be packed into a single texture
+    struct GlyphBitmap {
+        int code;
+        int width, height;
+        std::vector<unsigned char> coverage;
+        int x = 0, y = 0;  // Position in the atlas
+    };
+    std::vector<GlyphBitmap> bitmaps;
+
+    for (int c = 0; c < CHARACTER_COUNT; c++) {
         // Load character glyph
         if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
             spdlog::warn("ERROR::FREETYPE: Failed to load Glyph for character: {}", c);
             continue;
         }
-        
-        // Generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        
-        // Check if the glyph has bitmap data
-        if (face->glyph->bitmap.width > 0 && face->glyph->bitmap.rows > 0 && face->glyph->bitmap.buffer) {
-            // Prepare a two-channel buffer for GL_LUMINANCE_ALPHA
-            std::vector<unsigned char> buffer(face->glyph->bitmap.width * face->glyph->bitmap.rows * 2);
-            for (int i = 0; i < face->glyph->bitmap.width * face->glyph->bitmap.rows; ++i) {
-                buffer[2 * i] = 255; // Luminance (white)
-                buffer[2 * i + 1] = face->glyph->bitmap.buffer[i]; // Alpha
-            }
-            glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                GL_LUMINANCE_ALPHA,
-                face->glyph->bitmap.width,
-                face->glyph->bitmap.rows,
-                0,
-                GL_LUMINANCE_ALPHA,
-                GL_UNSIGNED_BYTE,
-                buffer.data()
-            );
-            
-            // Set texture options - use NEAREST for pixel fonts to maintain crisp appearance
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            
-            // Now store character for later use
-            Character character = {
-                texture,
-                glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                static_cast<GLuint>(face->glyph->advance.x)
-            };
-            characters.insert(std::pair<char, Character>(c, character));
-        } else {
-            // Handle characters with no bitmap data (like spaces)
-            // Create a minimal texture for spacing
-            unsigned char emptyData[4] = {255, 0, 255, 0}; // Transparent pixel
-            glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                GL_LUMINANCE_ALPHA,
-                1, 1,
-                0,
-                GL_LUMINANCE_ALPHA,
-                GL_UNSIGNED_BYTE,
-                emptyData
-            );
-            
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            
-            Character character = {
-                texture,
-                glm::ivec2(0, 0), // No visual size
-                glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                static_cast<GLuint>(face->glyph->advance.x)
-            };
-            characters.insert(std::pair<char, Character>(c, character));
+
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        Character& character = characters[c];
+        character.loaded = true;
+        character.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        character.advance = static_cast<GLuint>(face->glyph->advance.x);
+
+        // Characters with no bitmap data (like spaces) only advance the cursor
+        if (bitmap.width == 0 || bitmap.rows == 0 || !bitmap.buffer) {
+            character.size = glm::ivec2(0, 0);
+            continue;
         }
+        character.size = glm::ivec2(bitmap.width, bitmap.rows);
+
+        GlyphBitmap glyph;
+        glyph.code = c;
+        glyph.width = static_cast<int>(bitmap.width);
+        glyph.height = static_cast<int>(bitmap.rows);
+        glyph.coverage.resize(static_cast<size_t>(glyph.width) * glyph.height);
+        for (int row = 0; row < glyph.height; ++row) {
+            std::memcpy(&glyph.coverage[static_cast<size_t>(row) * glyph.width],
+                        bitmap.buffer + row * bitmap.pitch, glyph.width);
+        }
+        bitmaps.push_back(std::move(glyph));
     }
-    
-    glBindTexture(GL_TEXTURE_2D, 0);
-    
+
     // Destroy FreeType once we're finished
     FT_Done_Face(face);
-    
-    spdlog::info("TextRenderer initialized successfully with {} characters", characters.size());
+    face = nullptr;
+
+    // Tallest glyphs first packs noticeably tighter with a skyline packer
+    std::stable_sort(bitmaps.begin(), bitmaps.end(), [](const GlyphBitmap& a, const GlyphBitmap& b) {
+        return a.height > b.height;
+    });
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize <= 0) {
+        maxTextureSize = 1024;
+    }
+
+    // Start small and double the page until every glyph fits
+    int atlasSize = MIN_ATLAS_SIZE;
+    for (;;) {
+        RectPacker packer(atlasSize, atlasSize);
+        bool fits = true;
+        for (GlyphBitmap& glyph : bitmaps) {
+            if (!packer.pack(glyph.width + GLYPH_PADDING, glyph.height + GLYPH_PADDING, glyph.x, glyph.y)) {
+                fits = false;
+                break;
+            }
+        }
+        if (fits) break;
+
+        atlasSize *= 2;
+        if (atlasSize > maxTextureSize) {
+            spdlog::error("Font {} at size {} does not fit in a {}x{} glyph atlas", fontPath, fontSize,
+                          maxTextureSize, maxTextureSize);
+            characters = {};
+            return false;
+        }
+    }
+    atlasWidth = atlasSize;
+    atlasHeight = atlasSize;
+
+    // Two-channel buffer for GL_LUMINANCE_ALPHA: white luminance, coverage in alpha
+    std::vector<unsigned char> pixels(static_cast<size_t>(atlasWidth) * atlasHeight * 2, 0);
+    for (size_t i = 0; i < pixels.size(); i += 2) {
+        pixels[i] = 255;
+    }
+    for (const GlyphBitmap& glyph : bitmaps) {
+        for (int row = 0; row < glyph.height; ++row) {
+            for (int column = 0; column < glyph.width; ++column) {
+                size_t destination = (static_cast<size_t>(glyph.y + row) * atlasWidth + glyph.x + column) * 2;
+                pixels[destination + 1] = glyph.coverage[static_cast<size_t>(row) * glyph.width + column];
+            }
+        }
+
+        Character& character = characters[glyph.code];
+        character.u1 = static_cast<float>(glyph.x) / atlasWidth;
+        character.v1 = static_cast<float>(glyph.y) / atlasHeight;
+        character.u2 = static_cast<float>(glyph.x + glyph.width) / atlasWidth;
+        character.v2 = static_cast<float>(glyph.y + glyph.height) / atlasHeight;
+    }
+
+    // Disable byte-alignment restriction
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glGenTextures(1, &atlasTexture);
+    GLState::bindTexture(atlasTexture);
+
+    // Set texture options - use NEAREST for pixel fonts to maintain crisp appearance
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE_ALPHA, atlasWidth, atlasHeight, 0,
+                 GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    GLState::bindTexture(0);
+
+    spdlog::info("TextRenderer initialized successfully with {} glyphs in a {}x{} atlas",
+                 bitmaps.size(), atlasWidth, atlasHeight);
     initialized = true;
     return true;
 }
 
-bool TextRenderer::compileShaders() {
-    // For legacy OpenGL, we'll use a simple approach without shaders
-    // We'll render text using immediate mode OpenGL
-    return true;
+void TextRenderer::setupBuffers() {
+    // Upload this call's vertices, orphaning the previous contents so the
+    // driver doesn't stall on a draw that's still reading them
+    if (VBO == 0) {
+        glGenBuffers(1, &VBO);
+    }
+    GLState::bindArrayBuffer(VBO);
+
+    if (vertices.size() > vertexBufferCapacity) {
+        vertexBufferCapacity = std::max(vertices.size(), vertexBufferCapacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, vertexBufferCapacity * sizeof(TexturedVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(TexturedVertex), vertices.data());
 }
 
-void TextRenderer::setupBuffers() {
-    // For legacy OpenGL, we don't need VAOs or VBOs
-    // We'll use immediate mode rendering
+const Character* TextRenderer::findCharacter(char c) const {
+    unsigned char code = static_cast<unsigned char>(c);
+    if (code >= CHARACTER_COUNT || !characters[code].loaded) {
+        return nullptr;
+    }
+    return &characters[code];
+}
+
+template <typename Emit>
+void TextRenderer::layoutText(const std::string& text, float x, float y, float scale, Emit emit) const {
+    for (char c : text) {
+        const Character* ch = findCharacter(c);
+        if (!ch) {
+            spdlog::warn("Character '{}' not found in font", c);
+            continue;
+        }
+
+        if (ch->size.x > 0 && ch->size.y > 0) {
+            GLfloat xpos = x + ch->bearing.x * scale;
+            GLfloat ypos = y - (ch->size.y - ch->bearing.y) * scale;
+            emit(*ch, xpos, ypos, ch->size.x * scale, ch->size.y * scale);
+        }
+
+        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+        x += (ch->advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+    }
 }
 
 void TextRenderer::renderText(const std::string& text, float x, float y, float scale, float r, float g, float b) {
@@ -145,85 +219,94 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
         spdlog::warn("TextRenderer not initialized!");
         return;
     }
-    
-    // Rendering text
-    
-    // Activate corresponding render state
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Set text color
-    glColor3f(r, g, b);
-    
-    // Iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        if (characters.find(*c) == characters.end()) {
-            spdlog::warn("Character '{}' not found in font", *c);
-            continue;
-        }
-        
-        Character ch = characters[*c];
-        
-        GLfloat xpos = x + ch.bearing.x * scale;
-        GLfloat ypos = y - (ch.size.y - ch.bearing.y) * scale;
-        
-        GLfloat w = ch.size.x * scale;
-        GLfloat h = ch.size.y * scale;
-        
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        
-        // Draw the character
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(xpos, ypos + h);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(xpos, ypos);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(xpos + w, ypos);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(xpos + w, ypos + h);
-        glEnd();
-        
-        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (ch.advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
-    }
-    
-    glColor3f(1.0f, 1.0f, 1.0f); // Reset color
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
+
+    // Build two triangles per visible glyph, all sampling the same atlas
+    vertices.clear();
+    layoutText(text, x, y, scale, [this](const Character& ch, float xpos, float ypos, float w, float h) {
+        TexturedVertex topLeft = {xpos, ypos + h, ch.u1, ch.v1};
+        TexturedVertex bottomLeft = {xpos, ypos, ch.u1, ch.v2};
+        TexturedVertex bottomRight = {xpos + w, ypos, ch.u2, ch.v2};
+        TexturedVertex topRight = {xpos + w, ypos + h, ch.u2, ch.v1};
+
+        vertices.push_back(topLeft);
+        vertices.push_back(bottomLeft);
+        vertices.push_back(bottomRight);
+        vertices.push_back(topLeft);
+        vertices.push_back(bottomRight);
+        vertices.push_back(topRight);
+    });
+
+    if (vertices.empty()) return;
+
+    setupBuffers();
+
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderBackend::current().drawTextured(VBO, 0, static_cast<GLsizei>(vertices.size()), atlasTexture,
+                                          r, g, b, 1.0f);
+}
+
+void TextRenderer::appendText(const std::string& text, float x, float y, float scale,
+                              float r, float g, float b, float a, std::vector<SpriteVertex>& out) const {
+    if (!initialized) return;
+
+    auto toByte = [](float value) {
+        return static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    unsigned char cr = toByte(r), cg = toByte(g), cb = toByte(b), ca = toByte(a);
+
+    layoutText(text, x, y, scale, [&](const Character& ch, float xpos, float ypos, float w, float h) {
+        SpriteVertex topLeft = {xpos, ypos + h, ch.u1, ch.v1, cr, cg, cb, ca};
+        SpriteVertex bottomLeft = {xpos, ypos, ch.u1, ch.v2, cr, cg, cb, ca};
+        SpriteVertex bottomRight = {xpos + w, ypos, ch.u2, ch.v2, cr, cg, cb, ca};
+        SpriteVertex topRight = {xpos + w, ypos + h, ch.u2, ch.v1, cr, cg, cb, ca};
+
+        out.push_back(topLeft);
+        out.push_back(bottomLeft);
+        out.push_back(bottomRight);
+        out.push_back(topLeft);
+        out.push_back(bottomRight);
+        out.push_back(topRight);
+    });
 }
 
 float TextRenderer::getTextWidth(const std::string& text, float scale) {
     if (!initialized) return 0.0f;
     
     float width = 0.0f;
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = characters[*c];
-        width += (ch.advance >> 6) * scale;
+    for (char c : text) {
+        const Character* ch = findCharacter(c);
+        if (ch) {
+            width += (ch->advance >> 6) * scale;
+        }
     }
     return width;
 }
 
 float TextRenderer::getTextHeight(float scale) {
-    if (!initialized || characters.empty()) return 0.0f;
+    if (!initialized) return 0.0f;
     
     // Use the height of the first character as a reference
-    Character ch = characters.begin()->second;
-    return ch.size.y * scale;
+    for (const Character& ch : characters) {
+        if (ch.loaded) {
+            return ch.size.y * scale;
+        }
+    }
+    return 0.0f;
 }
 
 void TextRenderer::cleanup() {
     if (initialized) {
-        // Delete character textures
-        for (auto& pair : characters) {
-            glDeleteTextures(1, &pair.second.textureID);
-        }
-        characters.clear();
-        
+        // Delete the glyph atlas
+        if (atlasTexture) GLState::deleteTextures(1, &atlasTexture);
+        atlasTexture = 0;
+        characters = {};
+
         // Delete OpenGL objects
-        if (VBO) glDeleteBuffers(1, &VBO);
-        if (shaderProgram) glDeleteProgram(shaderProgram);
+        if (VBO) GLState::deleteBuffers(1, &VBO);
+        VBO = 0;
+        vertexBufferCapacity = 0;
         
         initialized = false;
     }
-} 
\ No newline at end of file
+}
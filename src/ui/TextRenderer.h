@@ -1,16 +1,20 @@
 #pragma once
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "ft2build.h"
 #include "freetype/freetype.h"
-#include <map>
+#include "render/RenderBackend.h"
+#include <array>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 struct Character {
-    GLuint textureID;   // ID handle of the glyph texture
+    bool loaded = false;
+    float u1 = 0.0f, v1 = 0.0f, u2 = 0.0f, v2 = 0.0f; // Glyph rectangle in the atlas, v1 is the top row
     glm::ivec2 size;    // Size of glyph
     glm::ivec2 bearing; // Offset from baseline to left/top of glyph
-    GLuint advance;     // Horizontal offset to advance to next glyph
+    GLuint advance = 0; // Horizontal offset to advance to next glyph
 };
 
 class TextRenderer {
@@ -21,9 +25,16 @@ public:
     // Initialize the text renderer with a font file
     bool init(const std::string& fontPath, unsigned int fontSize = 16);
     
-    // Render text
+    // Render text with a single draw call
     void renderText(const std::string& text, float x, float y, float scale, 
                    float r = 1.0f, float g = 1.0f, float b = 1.0f);
+
+    // Append the glyph triangles of text to a caller-owned buffer instead of
+    // drawing them, for geometry that is kept across frames. The triangles
+    // sample getAtlasTexture().
+    void appendText(const std::string& text, float x, float y, float scale,
+                    float r, float g, float b, float a, std::vector<SpriteVertex>& out) const;
+    GLuint getAtlasTexture() const { return atlasTexture; }
     
     // Get text width for centering calculations
     float getTextWidth(const std::string& text, float scale = 1.0f);
@@ -35,14 +46,23 @@ public:
     void cleanup();
 
 private:
-    std::map<GLchar, Character> characters;
+    static constexpr int CHARACTER_COUNT = 128;
+
+    // Indexed directly by the (ASCII) character code
+    std::array<Character, CHARACTER_COUNT> characters;
+    GLuint atlasTexture;
+    int atlasWidth, atlasHeight;
+    std::vector<TexturedVertex> vertices;
+    size_t vertexBufferCapacity = 0;  // In vertices
     GLuint VBO;
-    GLuint shaderProgram;
     FT_Library ft;
     FT_Face face;
     bool initialized;
     
     // Helper functions
-    bool compileShaders();
     void setupBuffers();
+    const Character* findCharacter(char c) const;
+    // Calls emit(character, left, bottom, width, height) for every visible glyph
+    template <typename Emit>
+    void layoutText(const std::string& text, float x, float y, float scale, Emit emit) const;
 }; 
\ No newline at end of file
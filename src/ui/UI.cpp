@@ -1,19 +1,146 @@
 #include "ui/UI.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
 #include <cmath>
 #include <spdlog/spdlog.h>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
-#include <stb_image.h>
+#include "render/TextureCache.h"
+#include "ui/UICanvas.h"
 
 // Static member initialization
 TextRenderer* UI::textRenderer = nullptr;
 bool UI::initialized = false;
-GLuint UI::titleScreenTextureID = 0;
-GLuint UI::deathScreenTextureID = 0;
+TextureHandle UI::titleScreenTexture;
+TextureHandle UI::deathScreenTexture;
 AnimatedHealthBar* UI::animatedHealthBar = nullptr;
 AnimatedXPBar* UI::animatedXPBar = nullptr;
 RomanNumeralRenderer* UI::romanNumeralRenderer = nullptr;
 
+namespace {
+    // Retained node trees for the menus and the HUD level display. A screen
+    // is laid out on first use and again when the window size or its variant
+    // changes; the per-frame draw calls only push the current state into the
+    // nodes, which re-tessellate when that state actually changed.
+    struct RetainedScreen {
+        UICanvas canvas;
+        std::vector<UIButton*> buttons;
+        UILabel* label = nullptr;
+        UIBar* bar = nullptr;
+        UIRomanNumeral* numeral = nullptr;
+        int variant = 0;
+
+        bool needsLayout(int windowWidth, int windowHeight, int layoutVariant) const {
+            return !canvas.isLaidOutFor(windowWidth, windowHeight) || variant != layoutVariant;
+        }
+
+        UIGroup& beginLayout(int windowWidth, int windowHeight, int layoutVariant) {
+            canvas.clear();
+            buttons.clear();
+            label = nullptr;
+            bar = nullptr;
+            numeral = nullptr;
+            canvas.setLayoutSize(windowWidth, windowHeight);
+            variant = layoutVariant;
+            return canvas.getRoot();
+        }
+
+        void addButton(TextRenderer* textRenderer, const std::string& text, float x, float y, float width, float height) {
+            buttons.push_back(canvas.getRoot().addChild(std::make_unique<UIButton>(textRenderer, text, x, y, width, height)));
+        }
+
+        void selectButton(int index) {
+            for (size_t i = 0; i < buttons.size(); ++i) {
+                buttons[i]->setSelected(static_cast<int>(i) == index);
+            }
+        }
+
+        void release() {
+            canvas.clear();
+            canvas.release();
+            buttons.clear();
+            label = nullptr;
+            bar = nullptr;
+            numeral = nullptr;
+        }
+    };
+
+    RetainedScreen mainMenuScreen;
+    RetainedScreen deathScreen;
+    RetainedScreen pauseScreen;
+    RetainedScreen saveSlotScreen;
+    RetainedScreen loadSlotScreen;
+    RetainedScreen settingsScreen;
+    RetainedScreen levelIndicatorScreen;
+
+    const UIColor OVERLAY_COLOR = {0.0f, 0.0f, 0.0f, 0.7f};
+    const UIColor BLACK = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    // Full-window background image, black if it failed to load
+    void addBackground(UIGroup& root, GLuint texture, float left, int windowWidth, int windowHeight) {
+        if (texture != 0) {
+            root.addChild(std::make_unique<UIImage>(left, 0.0f, static_cast<float>(windowWidth),
+                                                    static_cast<float>(windowHeight), texture));
+        } else {
+            root.addChild(std::make_unique<UIPanel>(0.0f, 0.0f, static_cast<float>(windowWidth),
+                                                    static_cast<float>(windowHeight), BLACK));
+        }
+    }
+
+    void addOverlay(UIGroup& root, const UIColor& color, int windowWidth, int windowHeight) {
+        root.addChild(std::make_unique<UIPanel>(0.0f, 0.0f, static_cast<float>(windowWidth),
+                                                static_cast<float>(windowHeight), color));
+    }
+
+    std::string saveSlotButtonText(int slot, const std::vector<std::string>& saveSlotInfo) {
+        std::string text = "Save Slot " + std::to_string(slot + 1);
+        if (slot < static_cast<int>(saveSlotInfo.size()) && saveSlotInfo[slot] != "Empty") {
+            text += " - " + saveSlotInfo[slot].substr(0, 10);
+        } else {
+            text += " - Empty";
+        }
+        return text;
+    }
+
+    // Save and load menus share a layout: title, three slots and Back
+    void drawSlotMenu(RetainedScreen& screen, TextRenderer* textRenderer, const std::string& title,
+                      int windowWidth, int windowHeight, int selectedSlot, const std::vector<std::string>& saveSlotInfo) {
+        if (screen.needsLayout(windowWidth, windowHeight, 0)) {
+            UIGroup& root = screen.beginLayout(windowWidth, windowHeight, 0);
+            addOverlay(root, OVERLAY_COLOR, windowWidth, windowHeight);
+            root.addChild(std::make_unique<UILabel>(textRenderer, title, windowWidth / 2.0f, windowHeight * 0.8f, 1.5f,
+                                                    UIColor(), UILabel::Align::Center));
+
+            float buttonWidth = 350.0f;  // Wider for save slot text
+            float buttonHeight = 60.0f;  // Same as main menu
+            float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;  // Same offset as main menu
+            const float rows[] = {0.6f, 0.5f, 0.4f};
+            for (int slot = 0; slot < 3; ++slot) {
+                screen.addButton(textRenderer, saveSlotButtonText(slot, saveSlotInfo), buttonX, windowHeight * rows[slot],
+                                 buttonWidth, buttonHeight);
+            }
+            screen.addButton(textRenderer, "Back", buttonX, windowHeight * 0.3f, buttonWidth, buttonHeight);
+        }
+
+        for (int slot = 0; slot < 3; ++slot) {
+            screen.buttons[slot]->setText(saveSlotButtonText(slot, saveSlotInfo));
+        }
+        screen.selectButton(selectedSlot);
+        screen.canvas.draw(windowWidth, windowHeight);
+    }
+
+    void releaseRetainedScreens() {
+        mainMenuScreen.release();
+        deathScreen.release();
+        pauseScreen.release();
+        saveSlotScreen.release();
+        loadSlotScreen.release();
+        settingsScreen.release();
+        levelIndicatorScreen.release();
+    }
+}
+
 bool UI::init(const std::string& fontPath) {
     if (initialized) {
         spdlog::warn("UI already initialized!");
@@ -51,83 +178,44 @@ bool UI::init(const std::string& fontPath) {
 }
 
 bool UI::loadTitleScreenTexture(const std::string& imagePath) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    // Streamed in the background; the menus fall back to a black backdrop
+    // until it's uploaded
+    TextureLoadOptions options;
+    options.filter = GL_LINEAR;  // Smooth scaling
+    titleScreenTexture = TextureCache::shared().loadAsync(imagePath, options);
+    if (!titleScreenTexture) {
         spdlog::error("Failed to load title screen texture: {}", imagePath);
         return false;
     }
-    
-    spdlog::info("Loaded title screen texture: {} ({}x{})", imagePath, width, height);
-    
-    glGenTextures(1, &titleScreenTextureID);
-    glBindTexture(GL_TEXTURE_2D, titleScreenTextureID);
-    
-    // Use LINEAR filtering for smooth scaling
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    
-    spdlog::debug("Title screen texture loaded successfully with ID: {}", titleScreenTextureID);
     return true;
 }
 
 bool UI::loadDeathScreenTexture(const std::string& imagePath) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    TextureLoadOptions options;
+    options.filter = GL_LINEAR;
+    deathScreenTexture = TextureCache::shared().loadAsync(imagePath, options);
+    if (!deathScreenTexture) {
         spdlog::error("Failed to load death screen texture: {}", imagePath);
         return false;
     }
-    
-    spdlog::info("Loaded death screen texture: {} ({}x{})", imagePath, width, height);
-    
-    glGenTextures(1, &deathScreenTextureID);
-    glBindTexture(GL_TEXTURE_2D, deathScreenTextureID);
-    
-    // Use LINEAR filtering for smooth scaling
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    GLenum format = GL_RGB;
-    if (channels == 4) format = GL_RGBA;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 1) format = GL_RED;
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
-    
-    spdlog::debug("Death screen texture loaded successfully with ID: {}", deathScreenTextureID);
     return true;
 }
 
+GLuint UI::getReadyTextureID(const TextureHandle& texture) {
+    return texture && texture->isReady() ? texture->getID() : 0;
+}
+
 void UI::cleanup() {
+    releaseRetainedScreens();
+    
     if (textRenderer) {
         textRenderer->cleanup();
         delete textRenderer;
         textRenderer = nullptr;
     }
     
-    if (titleScreenTextureID != 0) {
-        glDeleteTextures(1, &titleScreenTextureID);
-        titleScreenTextureID = 0;
-    }
-    
-    if (deathScreenTextureID != 0) {
-        glDeleteTextures(1, &deathScreenTextureID);
-        deathScreenTextureID = 0;
-    }
+    titleScreenTexture.reset();
+    deathScreenTexture.reset();
     
     if (animatedHealthBar) {
         animatedHealthBar->cleanup();
@@ -229,22 +317,13 @@ void UI::drawText(const std::string& text, float x, float y, float scale, float
     if (!initialized || !textRenderer) {
         return;
     }
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, 1920, 0, 1080, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor3f(r, g, b);
+    RenderBackend::pushOrtho(0, 1920, 0, 1080);
+    GLState::enable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::color(r, g, b);
     textRenderer->renderText(text, x, y, scale, r, g, b);
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RenderBackend::popOrtho();
 }
 
 void UI::drawCenteredText(const std::string& text, float x, float y, float scale, float r, float g, float b) {
@@ -259,17 +338,10 @@ void UI::drawCenteredText(const std::string& text, float x, float y, float scale
 void UI::drawPlayerHealth(int currentHealth, int maxHealth, int windowWidth, int windowHeight) {
     
     // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    RenderBackend::pushOrtho(0, windowWidth, windowHeight, 0);
     
     // Disable textures for UI drawing
-    glDisable(GL_TEXTURE_2D);
+    GLState::disable(GL_TEXTURE_2D);
     
     float barWidth = 280.0f;
     float barHeight = 22.0f;
@@ -278,8 +350,8 @@ void UI::drawPlayerHealth(int currentHealth, int maxHealth, int windowWidth, int
     float healthRatio = (maxHealth > 0) ? static_cast<float>(currentHealth) / maxHealth : 0.0f;
 
     // Draw background (darker red)
-    glColor3f(0.6f, 0.0f, 0.0f);
-    glBegin(GL_QUADS);
+    GLState::color(0.6f, 0.0f, 0.0f);
+    GLState::begin(GL_QUADS);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
@@ -288,8 +360,8 @@ void UI::drawPlayerHealth(int currentHealth, int maxHealth, int windowWidth, int
 
     // Draw health (brighter green)
     if (healthRatio > 0) {
-        glColor3f(0.2f, 1.0f, 0.2f);
-        glBegin(GL_QUADS);
+        GLState::color(0.2f, 1.0f, 0.2f);
+        GLState::begin(GL_QUADS);
         glVertex2f(x - barWidth/2, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * healthRatio, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * healthRatio, y + barHeight/2);
@@ -298,40 +370,30 @@ void UI::drawPlayerHealth(int currentHealth, int maxHealth, int windowWidth, int
     }
 
     // Draw border (darker)
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glBegin(GL_LINE_LOOP);
+    GLState::color(0.3f, 0.3f, 0.3f);
+    GLState::begin(GL_LINE_LOOP);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
     glVertex2f(x - barWidth/2, y + barHeight/2);
     glEnd();
 
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
+    GLState::color(1.0f, 1.0f, 1.0f);  // Reset color
     
     // Restore matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RenderBackend::popOrtho();
     
     // Re-enable textures
-    glEnable(GL_TEXTURE_2D);
+    GLState::enable(GL_TEXTURE_2D);
 }
 
 void UI::drawXPBar(int currentXP, int maxXP, int windowWidth, int windowHeight) {
     
     // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, windowHeight, 0, -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    RenderBackend::pushOrtho(0, windowWidth, windowHeight, 0);
     
     // Disable textures for UI drawing
-    glDisable(GL_TEXTURE_2D);
+    GLState::disable(GL_TEXTURE_2D);
     
     float barWidth = 300.0f;
     float barHeight = 20.0f;
@@ -340,8 +402,8 @@ void UI::drawXPBar(int currentXP, int maxXP, int windowWidth, int windowHeight)
     float xpRatio = (maxXP > 0) ? static_cast<float>(currentXP) / maxXP : 0.0f;
 
     // Draw background (dark blue)
-    glColor3f(0.0f, 0.0f, 0.3f);
-    glBegin(GL_QUADS);
+    GLState::color(0.0f, 0.0f, 0.3f);
+    GLState::begin(GL_QUADS);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
@@ -350,8 +412,8 @@ void UI::drawXPBar(int currentXP, int maxXP, int windowWidth, int windowHeight)
 
     // Draw XP (bright blue)
     if (xpRatio > 0) {
-        glColor3f(0.0f, 0.5f, 1.0f);
-        glBegin(GL_QUADS);
+        GLState::color(0.0f, 0.5f, 1.0f);
+        GLState::begin(GL_QUADS);
         glVertex2f(x - barWidth/2, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * xpRatio, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * xpRatio, y + barHeight/2);
@@ -360,99 +422,64 @@ void UI::drawXPBar(int currentXP, int maxXP, int windowWidth, int windowHeight)
     }
 
     // Draw border (white)
-    glColor3f(0.8f, 0.8f, 0.8f);
-    glBegin(GL_LINE_LOOP);
+    GLState::color(0.8f, 0.8f, 0.8f);
+    GLState::begin(GL_LINE_LOOP);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
     glVertex2f(x - barWidth/2, y + barHeight/2);
     glEnd();
 
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
+    GLState::color(1.0f, 1.0f, 1.0f);  // Reset color
     
     // Draw XP text
     if (textRenderer) {
         std::string xpText = std::to_string(currentXP) + "/" + std::to_string(maxXP);
         // Use the same text rendering setup as the level indicator
-        glMatrixMode(GL_PROJECTION);
-        glPushMatrix();
-        glLoadIdentity();
-        glOrtho(0, 1920, 0, 1080, -1, 1);
-        glMatrixMode(GL_MODELVIEW);
-        glPushMatrix();
-        glLoadIdentity();
-        glEnable(GL_TEXTURE_2D);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor3f(1.0f, 1.0f, 1.0f);
+        RenderBackend::pushOrtho(0, 1920, 0, 1080);
+        GLState::enable(GL_TEXTURE_2D);
+        GLState::enable(GL_BLEND);
+        GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::color(1.0f, 1.0f, 1.0f);
         float xpTextX = 1700.0f;  // X position for XP text
         float xpTextY = 1000.0f;  // Y position for XP text
         textRenderer->renderText(xpText, xpTextX, xpTextY, 0.6f, 1.0f, 1.0f, 1.0f);
-        glMatrixMode(GL_PROJECTION);
-        glPopMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        glPopMatrix();
+        RenderBackend::popOrtho();
     }
  
     // Restore matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RenderBackend::popOrtho();
     
     // Re-enable textures
-    glEnable(GL_TEXTURE_2D);
+    GLState::enable(GL_TEXTURE_2D);
 }
 
 void UI::drawLevelIndicator(int level, int windowWidth, int windowHeight) {
-    
-    // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Position next to health bar at the top of the screen
-    float x = 1720.0f;  // Health bar width + margin
-    float y = 1050.0f;  // Top of screen
-    
-    // Level background removed - just draw text
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw "Level" text first
-    if (textRenderer) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        textRenderer->renderText("Level", x, y, 1.4f, 1.0f, 1.0f, 1.0f);
-    }
-    
-    // Draw Roman numeral using pixel art if available
-    if (romanNumeralRenderer) {
-        // Position Roman numeral after "Level" text
-        float numeralX = 1770.0f;  // Offset for "Level " text
-        float numeralY = 920.0f;  // Slightly below the text
-        float scale = 0.4f;  // Scale for better readability
-        
-        romanNumeralRenderer->drawRomanNumeral(level, numeralX, numeralY, scale);
-    } else {
-        // Fallback to text-based Roman numerals if renderer not initialized
-        std::string romanStr = RomanNumeralRenderer::toRomanNumeral(level);
-        if (textRenderer) {
-            textRenderer->renderText(romanStr, x + 90.0f, y, 0.8f, 1.0f, 1.0f, 1.0f);
+    RetainedScreen& screen = levelIndicatorScreen;
+    int variant = romanNumeralRenderer ? 1 : 0;
+    if (screen.needsLayout(windowWidth, windowHeight, variant)) {
+        UIGroup& root = screen.beginLayout(windowWidth, windowHeight, variant);
+
+        // Position next to health bar at the top of the screen
+        float x = 1720.0f;  // Health bar width + margin
+        float y = 1050.0f;  // Top of screen
+        root.addChild(std::make_unique<UILabel>(textRenderer, "Level", x, y, 1.4f));
+
+        if (romanNumeralRenderer) {
+            // Pixel-art numeral after "Level", slightly below the text
+            screen.numeral = root.addChild(std::make_unique<UIRomanNumeral>(romanNumeralRenderer, 1770.0f, 920.0f, 0.4f));
+        } else {
+            // Fallback to text-based Roman numerals if renderer not initialized
+            screen.label = root.addChild(std::make_unique<UILabel>(textRenderer, "", x + 90.0f, y, 0.8f));
         }
     }
-    
-    // Restore matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+
+    if (screen.numeral) {
+        screen.numeral->setNumber(level);
+    } else if (screen.label) {
+        screen.label->setText(RomanNumeralRenderer::toRomanNumeral(level));
+    }
+    screen.canvas.draw(windowWidth, windowHeight);
 }
 
 void UI::drawEnemyHealthBar(float x, float y, int currentHealth, int maxHealth) {
@@ -463,8 +490,8 @@ void UI::drawEnemyHealthBar(float x, float y, int currentHealth, int maxHealth)
     float healthRatio = static_cast<float>(currentHealth) / maxHealth;
     
     // Draw background (red)
-    glColor3f(0.8f, 0.0f, 0.0f);
-    glBegin(GL_QUADS);
+    GLState::color(0.8f, 0.0f, 0.0f);
+    GLState::begin(GL_QUADS);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
@@ -473,8 +500,8 @@ void UI::drawEnemyHealthBar(float x, float y, int currentHealth, int maxHealth)
     
     // Draw health (green)
     if (healthRatio > 0) {
-        glColor3f(0.0f, 0.8f, 0.0f);
-        glBegin(GL_QUADS);
+        GLState::color(0.0f, 0.8f, 0.0f);
+        GLState::begin(GL_QUADS);
         glVertex2f(x - barWidth/2, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * healthRatio, y - barHeight/2);
         glVertex2f(x - barWidth/2 + barWidth * healthRatio, y + barHeight/2);
@@ -483,31 +510,31 @@ void UI::drawEnemyHealthBar(float x, float y, int currentHealth, int maxHealth)
     }
     
     // Draw border
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_LINE_LOOP);
+    GLState::color(1.0f, 1.0f, 1.0f);
+    GLState::begin(GL_LINE_LOOP);
     glVertex2f(x - barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y - barHeight/2);
     glVertex2f(x + barWidth/2, y + barHeight/2);
     glVertex2f(x - barWidth/2, y + barHeight/2);
     glEnd();
     
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
+    GLState::color(1.0f, 1.0f, 1.0f);  // Reset color
 }
 
 void UI::drawHeart(float x, float y, bool filled, float size) {
-    glDisable(GL_TEXTURE_2D);
+    GLState::disable(GL_TEXTURE_2D);
     
     if (filled) {
-        glColor3f(1.0f, 0.0f, 0.0f);  // Red for filled heart
+        GLState::color(1.0f, 0.0f, 0.0f);  // Red for filled heart
     } else {
-        glColor3f(0.5f, 0.0f, 0.0f);  // Dark red for empty heart
+        GLState::color(0.5f, 0.0f, 0.0f);  // Dark red for empty heart
     }
     
     // Draw heart shape using triangles
     float halfSize = size / 2.0f;
     
     // Left curve
-    glBegin(GL_TRIANGLE_FAN);
+    GLState::begin(GL_TRIANGLE_FAN);
     glVertex2f(x + halfSize * 0.5f, y + halfSize * 0.3f);  // Center of left curve
     for (int i = 0; i <= 8; i++) {
         float angle = M_PI * i / 8.0f;
@@ -518,7 +545,7 @@ void UI::drawHeart(float x, float y, bool filled, float size) {
     glEnd();
     
     // Right curve
-    glBegin(GL_TRIANGLE_FAN);
+    GLState::begin(GL_TRIANGLE_FAN);
     glVertex2f(x + halfSize * 1.5f, y + halfSize * 0.3f);  // Center of right curve
     for (int i = 0; i <= 8; i++) {
         float angle = M_PI * i / 8.0f;
@@ -529,15 +556,15 @@ void UI::drawHeart(float x, float y, bool filled, float size) {
     glEnd();
     
     // Bottom point
-    glBegin(GL_TRIANGLES);
+    GLState::begin(GL_TRIANGLES);
     glVertex2f(x + halfSize * 0.5f, y + halfSize * 0.3f);
     glVertex2f(x + halfSize * 1.5f, y + halfSize * 0.3f);
     glVertex2f(x + halfSize, y + halfSize * 1.2f);
     glEnd();
     
     // Draw outline
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_LINE_LOOP);
+    GLState::color(1.0f, 1.0f, 1.0f);
+    GLState::begin(GL_LINE_LOOP);
     // Left curve outline
     for (int i = 0; i <= 8; i++) {
         float angle = M_PI * i / 8.0f;
@@ -556,8 +583,8 @@ void UI::drawHeart(float x, float y, bool filled, float size) {
     glVertex2f(x + halfSize, y + halfSize * 1.2f);
     glEnd();
     
-    glColor3f(1.0f, 1.0f, 1.0f);  // Reset color
-    glEnable(GL_TEXTURE_2D);
+    GLState::color(1.0f, 1.0f, 1.0f);  // Reset color
+    GLState::enable(GL_TEXTURE_2D);
 }
 
 void UI::drawPixelText(const std::string&, float, float, float, float, float, float) {
@@ -565,15 +592,15 @@ void UI::drawPixelText(const std::string&, float, float, float, float, float, fl
 }
 
 void UI::drawMenuButton(const std::string& text, float x, float y, float width, float height, bool isHovered, bool isSelected) {
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::disable(GL_TEXTURE_2D);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Draw glow effect if selected
     if (isSelected) {
         // Outer glow (larger, more transparent)
-        glColor4f(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.3f); // RGB(205, 133, 63) with 30% alpha
-        glBegin(GL_QUADS);
+        GLState::color(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.3f); // RGB(205, 133, 63) with 30% alpha
+        GLState::begin(GL_QUADS);
         glVertex2f(x - 8, y - 8);
         glVertex2f(x + width + 8, y - 8);
         glVertex2f(x + width + 8, y + height + 8);
@@ -581,8 +608,8 @@ void UI::drawMenuButton(const std::string& text, float x, float y, float width,
         glEnd();
         
         // Inner glow (smaller, more opaque)
-        glColor4f(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.6f); // RGB(205, 133, 63) with 60% alpha
-        glBegin(GL_QUADS);
+        GLState::color(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.6f); // RGB(205, 133, 63) with 60% alpha
+        GLState::begin(GL_QUADS);
         glVertex2f(x - 4, y - 4);
         glVertex2f(x + width + 4, y - 4);
         glVertex2f(x + width + 4, y + height + 4);
@@ -591,8 +618,8 @@ void UI::drawMenuButton(const std::string& text, float x, float y, float width,
     }
     
     // Button background - semi-transparent black
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f); // Black background with 70% alpha
-    glBegin(GL_QUADS);
+    GLState::color(0.0f, 0.0f, 0.0f, 0.7f); // Black background with 70% alpha
+    GLState::begin(GL_QUADS);
     glVertex2f(x, y);
     glVertex2f(x + width, y);
     glVertex2f(x + width, y + height);
@@ -600,16 +627,16 @@ void UI::drawMenuButton(const std::string& text, float x, float y, float width,
     glEnd();
     
     // Draw button border in RGB(205, 133, 63) with transparency
-    glColor4f(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.8f); // RGB(205, 133, 63) with 80% alpha
-    glBegin(GL_LINE_LOOP);
+    GLState::color(205.0f/255.0f, 133.0f/255.0f, 63.0f/255.0f, 0.8f); // RGB(205, 133, 63) with 80% alpha
+    GLState::begin(GL_LINE_LOOP);
     glVertex2f(x, y);
     glVertex2f(x + width, y);
     glVertex2f(x + width, y + height);
     glVertex2f(x, y + height);
     glEnd();
     
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
-    glEnable(GL_TEXTURE_2D);
+    GLState::color(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
+    GLState::enable(GL_TEXTURE_2D);
     
     // Draw text using FreeType in RGB(205, 133, 63)
     float textX = x + width / 2.0f;
@@ -618,72 +645,35 @@ void UI::drawMenuButton(const std::string& text, float x, float y, float width,
 }
 
 void UI::drawMainMenu(int windowWidth, int windowHeight, int selectedOption, bool hasSaveFile) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw background texture if available, otherwise fall back to black
-    if (titleScreenTextureID != 0) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, titleScreenTextureID);
-        glColor3f(1.0f, 1.0f, 1.0f);  // White color to show texture as-is
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(0, 0);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(windowWidth, 0);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(windowWidth, windowHeight);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(0, windowHeight);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-    } else {
-        // Fallback to black background if texture not loaded
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(0.0f, 0.0f, 0.0f);  // Black background
-        glBegin(GL_QUADS);
-        glVertex2f(0, 0);
-        glVertex2f(windowWidth, 0);
-        glVertex2f(windowWidth, windowHeight);
-        glVertex2f(0, windowHeight);
-        glEnd();
-    }
-    
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw buttons (slightly offset to the left)
-    float buttonWidth = 260.0f;  // Increased from 200 to 250
-    float buttonHeight = 60.0f;
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;  // Move 45 pixels to the left
-    
-    if (hasSaveFile) {
-        // Menu with save file: Start Game, Load Game, Settings, Exit Game
-        float startButtonY = windowHeight * 0.55f;
-        float loadButtonY = windowHeight * 0.45f;
-        float settingsButtonY = windowHeight * 0.35f;
-        float exitButtonY = windowHeight * 0.25f;
-        
-        drawMenuButton("Start Game", buttonX, startButtonY, buttonWidth, buttonHeight, false, selectedOption == 0);
-        drawMenuButton("Load Game", buttonX, loadButtonY, buttonWidth, buttonHeight, false, selectedOption == 1);
-        drawMenuButton("Settings", buttonX, settingsButtonY, buttonWidth, buttonHeight, false, selectedOption == 2);
-        drawMenuButton("Exit Game", buttonX, exitButtonY, buttonWidth, buttonHeight, false, selectedOption == 3);
-    } else {
-        // Menu without save file: Start Game, Settings, Exit Game
-        float startButtonY = windowHeight * 0.5f;
-        float settingsButtonY = windowHeight * 0.4f;
-        float exitButtonY = windowHeight * 0.3f;
-        
-        drawMenuButton("Start Game", buttonX, startButtonY, buttonWidth, buttonHeight, false, selectedOption == 0);
-        drawMenuButton("Settings", buttonX, settingsButtonY, buttonWidth, buttonHeight, false, selectedOption == 1);
-        drawMenuButton("Exit Game", buttonX, exitButtonY, buttonWidth, buttonHeight, false, selectedOption == 2);
+    RetainedScreen& screen = mainMenuScreen;
+    // Laid out again once the streamed background arrives
+    GLuint background = getReadyTextureID(titleScreenTexture);
+    int variant = (hasSaveFile ? 1 : 0) | (background != 0 ? 2 : 0);
+    if (screen.needsLayout(windowWidth, windowHeight, variant)) {
+        UIGroup& root = screen.beginLayout(windowWidth, windowHeight, variant);
+        addBackground(root, background, 0.0f, windowWidth, windowHeight);
+
+        // Buttons are slightly offset to the left
+        float buttonWidth = 260.0f;
+        float buttonHeight = 60.0f;
+        float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;
+
+        if (hasSaveFile) {
+            // Menu with save file: Start Game, Load Game, Settings, Exit Game
+            screen.addButton(textRenderer, "Start Game", buttonX, windowHeight * 0.55f, buttonWidth, buttonHeight);
+            screen.addButton(textRenderer, "Load Game", buttonX, windowHeight * 0.45f, buttonWidth, buttonHeight);
+            screen.addButton(textRenderer, "Settings", buttonX, windowHeight * 0.35f, buttonWidth, buttonHeight);
+            screen.addButton(textRenderer, "Exit Game", buttonX, windowHeight * 0.25f, buttonWidth, buttonHeight);
+        } else {
+            // Menu without save file: Start Game, Settings, Exit Game
+            screen.addButton(textRenderer, "Start Game", buttonX, windowHeight * 0.5f, buttonWidth, buttonHeight);
+            screen.addButton(textRenderer, "Settings", buttonX, windowHeight * 0.4f, buttonWidth, buttonHeight);
+            screen.addButton(textRenderer, "Exit Game", buttonX, windowHeight * 0.3f, buttonWidth, buttonHeight);
+        }
     }
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+
+    screen.selectButton(selectedOption);
+    screen.canvas.draw(windowWidth, windowHeight);
 }
 
 bool UI::isMouseOverButton(float mouseX, float mouseY, float buttonX, float buttonY, float buttonWidth, float buttonHeight) {
@@ -691,386 +681,91 @@ bool UI::isMouseOverButton(float mouseX, float mouseY, float buttonX, float butt
            mouseY >= buttonY && mouseY <= buttonY + buttonHeight;
 }
 
-void UI::drawDeathScreen(int windowWidth, int windowHeight, bool respawnButtonHovered, bool exitButtonHovered, int selectedButton) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw background texture if available, otherwise fall back to black
-    if (deathScreenTextureID != 0) {
-        // First fill the entire screen with black
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(0.0f, 0.0f, 0.0f);  // Black background
-        glBegin(GL_QUADS);
-        glVertex2f(0, 0);
-        glVertex2f(windowWidth, 0);
-        glVertex2f(windowWidth, windowHeight);
-        glVertex2f(0, windowHeight);
-        glEnd();
-        
-        // Then draw the texture on the right side (offset to the right)
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, deathScreenTextureID);
-        glColor3f(1.0f, 1.0f, 1.0f);  // White color to show texture as-is
-        
-        float textureOffset = 100.0f;  // Move texture 100 pixels to the right
-        float textureWidth = windowWidth - textureOffset;  // Adjust texture width
-        
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(textureOffset, 0);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(windowWidth, 0);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(windowWidth, windowHeight);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(textureOffset, windowHeight);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-    } else {
-        // Fallback to black background if texture not loaded
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(0.0f, 0.0f, 0.0f);  // Black background
-        glBegin(GL_QUADS);
-        glVertex2f(0, 0);
-        glVertex2f(windowWidth, 0);
-        glVertex2f(windowWidth, windowHeight);
-        glVertex2f(0, windowHeight);
-        glEnd();
+void UI::drawDeathScreen(int windowWidth, int windowHeight, bool, bool, int selectedButton) {
+    RetainedScreen& screen = deathScreen;
+    GLuint background = getReadyTextureID(deathScreenTexture);
+    int variant = background != 0 ? 1 : 0;
+    if (screen.needsLayout(windowWidth, windowHeight, variant)) {
+        UIGroup& root = screen.beginLayout(windowWidth, windowHeight, variant);
+
+        // Black backdrop with the art offset 100 pixels to the right
+        addOverlay(root, BLACK, windowWidth, windowHeight);
+        if (background != 0) {
+            addBackground(root, background, 100.0f, windowWidth, windowHeight);
+        }
+
+        // Same button positions as the main menu
+        float buttonWidth = 260.0f;
+        float buttonHeight = 60.0f;
+        float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;
+        screen.addButton(textRenderer, "RESPAWN", buttonX, windowHeight * 0.5f, buttonWidth, buttonHeight);
+        screen.addButton(textRenderer, "EXIT GAME", buttonX, windowHeight * 0.35f, buttonWidth, buttonHeight);
     }
-    
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw respawn and exit buttons (same position as main menu)
-    float buttonWidth = 260.0f;  // Increased from 200 to 250 to match main menu
-    float buttonHeight = 60.0f;
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;  // Same offset as main menu
-    float respawnButtonY = windowHeight * 0.5f;
-    float exitButtonY = windowHeight * 0.35f;
-    
-    drawMenuButton("RESPAWN", buttonX, respawnButtonY, buttonWidth, buttonHeight, respawnButtonHovered, selectedButton == 0);
-    drawMenuButton("EXIT GAME", buttonX, exitButtonY, buttonWidth, buttonHeight, exitButtonHovered, selectedButton == 1);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+
+    screen.selectButton(selectedButton);
+    screen.canvas.draw(windowWidth, windowHeight);
 }
 
 void UI::drawPauseScreen(int windowWidth, int windowHeight, int selectedButton) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw dark overlay (semi-transparent black)
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f); // Black with 70% alpha for dark overlay
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(windowWidth, 0);
-    glVertex2f(windowWidth, windowHeight);
-    glVertex2f(0, windowHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw pause menu buttons
-    float buttonWidth = 260.0f;
-    float buttonHeight = 60.0f;
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f; // Same offset as other menus
-    
-    // Resume button (top)
-    float resumeButtonY = windowHeight * 0.65f;
-    drawMenuButton("Resume", buttonX, resumeButtonY, buttonWidth, buttonHeight, false, selectedButton == 0);
-    
-    // Save Game button
-    float saveButtonY = windowHeight * 0.55f;
-    drawMenuButton("Save Game", buttonX, saveButtonY, buttonWidth, buttonHeight, false, selectedButton == 1);
-    
-    // Settings button
-    float settingsButtonY = windowHeight * 0.45f;
-    drawMenuButton("Settings", buttonX, settingsButtonY, buttonWidth, buttonHeight, false, selectedButton == 2);
-    
-    // Back to Menu button (middle)
-    float menuButtonY = windowHeight * 0.35f;
-    drawMenuButton("Back to Menu", buttonX, menuButtonY, buttonWidth, buttonHeight, false, selectedButton == 3);
-    
-    // Exit Game button (bottom)
-    float exitButtonY = windowHeight * 0.25f;
-    drawMenuButton("Exit Game", buttonX, exitButtonY, buttonWidth, buttonHeight, false, selectedButton == 4);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    RetainedScreen& screen = pauseScreen;
+    if (screen.needsLayout(windowWidth, windowHeight, 0)) {
+        UIGroup& root = screen.beginLayout(windowWidth, windowHeight, 0);
+        addOverlay(root, OVERLAY_COLOR, windowWidth, windowHeight);
+
+        float buttonWidth = 260.0f;
+        float buttonHeight = 60.0f;
+        float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f; // Same offset as other menus
+        screen.addButton(textRenderer, "Resume", buttonX, windowHeight * 0.65f, buttonWidth, buttonHeight);
+        screen.addButton(textRenderer, "Save Game", buttonX, windowHeight * 0.55f, buttonWidth, buttonHeight);
+        screen.addButton(textRenderer, "Settings", buttonX, windowHeight * 0.45f, buttonWidth, buttonHeight);
+        screen.addButton(textRenderer, "Back to Menu", buttonX, windowHeight * 0.35f, buttonWidth, buttonHeight);
+        screen.addButton(textRenderer, "Exit Game", buttonX, windowHeight * 0.25f, buttonWidth, buttonHeight);
+    }
+
+    screen.selectButton(selectedButton);
+    screen.canvas.draw(windowWidth, windowHeight);
 }
 
 void UI::drawSaveSlotMenu(int windowWidth, int windowHeight, int selectedSlot, const std::vector<std::string>& saveSlotInfo) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw dark overlay
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(windowWidth, 0);
-    glVertex2f(windowWidth, windowHeight);
-    glVertex2f(0, windowHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw title
-    drawCenteredText("Select Save Slot", windowWidth / 2.0f, windowHeight * 0.8f, 1.5f);
-    
-    // Draw save slots using same layout as main menu
-    float buttonWidth = 350.0f;  // Wider for save slot text
-    float buttonHeight = 60.0f;  // Same as main menu
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;  // Same offset as main menu
-    
-    // Position buttons like main menu: 0.6f, 0.5f, 0.4f, 0.3f
-    float slot1Y = windowHeight * 0.6f;
-    float slot2Y = windowHeight * 0.5f;
-    float slot3Y = windowHeight * 0.4f;
-    float backButtonY = windowHeight * 0.3f;
-    
-    // Save Slot 1
-    std::string buttonText1 = "Save Slot 1";
-    if (0 < saveSlotInfo.size() && saveSlotInfo[0] != "Empty") {
-        std::string shortTime = saveSlotInfo[0].substr(0, 10);
-        buttonText1 += " - " + shortTime;
-    } else {
-        buttonText1 += " - Empty";
-    }
-    drawMenuButton(buttonText1, buttonX, slot1Y, buttonWidth, buttonHeight, false, selectedSlot == 0);
-    
-    // Save Slot 2
-    std::string buttonText2 = "Save Slot 2";
-    if (1 < saveSlotInfo.size() && saveSlotInfo[1] != "Empty") {
-        std::string shortTime = saveSlotInfo[1].substr(0, 10);
-        buttonText2 += " - " + shortTime;
-    } else {
-        buttonText2 += " - Empty";
-    }
-    drawMenuButton(buttonText2, buttonX, slot2Y, buttonWidth, buttonHeight, false, selectedSlot == 1);
-    
-    // Save Slot 3
-    std::string buttonText3 = "Save Slot 3";
-    if (2 < saveSlotInfo.size() && saveSlotInfo[2] != "Empty") {
-        std::string shortTime = saveSlotInfo[2].substr(0, 10);
-        buttonText3 += " - " + shortTime;
-    } else {
-        buttonText3 += " - Empty";
-    }
-    drawMenuButton(buttonText3, buttonX, slot3Y, buttonWidth, buttonHeight, false, selectedSlot == 2);
-    
-    // Back button
-    drawMenuButton("Back", buttonX, backButtonY, buttonWidth, buttonHeight, false, selectedSlot == 3);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    drawSlotMenu(saveSlotScreen, textRenderer, "Select Save Slot", windowWidth, windowHeight, selectedSlot, saveSlotInfo);
 }
 
 void UI::drawLoadSlotMenu(int windowWidth, int windowHeight, int selectedSlot, const std::vector<std::string>& saveSlotInfo) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw dark overlay
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(windowWidth, 0);
-    glVertex2f(windowWidth, windowHeight);
-    glVertex2f(0, windowHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw title
-    drawCenteredText("Select Load Slot", windowWidth / 2.0f, windowHeight * 0.8f, 1.5f);
-    
-    // Draw save slots using same layout as main menu
-    float buttonWidth = 350.0f;  // Wider for save slot text
-    float buttonHeight = 60.0f;  // Same as main menu
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f - 45.0f;  // Same offset as main menu
-    
-    // Position buttons like main menu: 0.6f, 0.5f, 0.4f, 0.3f
-    float slot1Y = windowHeight * 0.6f;
-    float slot2Y = windowHeight * 0.5f;
-    float slot3Y = windowHeight * 0.4f;
-    float backButtonY = windowHeight * 0.3f;
-    
-    // Save Slot 1
-    std::string buttonText1 = "Save Slot 1";
-    if (0 < saveSlotInfo.size()) {
-        if (saveSlotInfo[0] == "Empty") {
-            buttonText1 += " - Empty";
-        } else {
-            std::string shortTime = saveSlotInfo[0].substr(0, 10);
-            buttonText1 += " - " + shortTime;
-        }
-    } else {
-        buttonText1 += " - Empty";
-    }
-    drawMenuButton(buttonText1, buttonX, slot1Y, buttonWidth, buttonHeight, false, selectedSlot == 0);
-    
-    // Save Slot 2
-    std::string buttonText2 = "Save Slot 2";
-    if (1 < saveSlotInfo.size()) {
-        if (saveSlotInfo[1] == "Empty") {
-            buttonText2 += " - Empty";
-        } else {
-            std::string shortTime = saveSlotInfo[1].substr(0, 10);
-            buttonText2 += " - " + shortTime;
-        }
-    } else {
-        buttonText2 += " - Empty";
-    }
-    drawMenuButton(buttonText2, buttonX, slot2Y, buttonWidth, buttonHeight, false, selectedSlot == 1);
-    
-    // Save Slot 3
-    std::string buttonText3 = "Save Slot 3";
-    if (2 < saveSlotInfo.size()) {
-        if (saveSlotInfo[2] == "Empty") {
-            buttonText3 += " - Empty";
-        } else {
-            std::string shortTime = saveSlotInfo[2].substr(0, 10);
-            buttonText3 += " - " + shortTime;
-        }
-    } else {
-        buttonText3 += " - Empty";
-    }
-    drawMenuButton(buttonText3, buttonX, slot3Y, buttonWidth, buttonHeight, false, selectedSlot == 2);
-    
-    // Back button
-    drawMenuButton("Back", buttonX, backButtonY, buttonWidth, buttonHeight, false, selectedSlot == 3);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    drawSlotMenu(loadSlotScreen, textRenderer, "Select Load Slot", windowWidth, windowHeight, selectedSlot, saveSlotInfo);
 }
 
-void UI::drawSettingsMenu(int windowWidth, int windowHeight, int selectedOption, float masterVolume, float musicVolume, float sfxVolume) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Draw background texture if available, otherwise fall back to black
-    if (titleScreenTextureID != 0) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, titleScreenTextureID);
-        glColor3f(1.0f, 1.0f, 1.0f);  // White color to show texture as-is
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(0, 0);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(windowWidth, 0);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(windowWidth, windowHeight);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(0, windowHeight);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-    } else {
-        // Fallback to black background if texture not loaded
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(0.0f, 0.0f, 0.0f);  // Black background
-        glBegin(GL_QUADS);
-        glVertex2f(0, 0);
-        glVertex2f(windowWidth, 0);
-        glVertex2f(windowWidth, windowHeight);
-        glVertex2f(0, windowHeight);
-        glEnd();
-    }
-    
-    // Draw semi-transparent dark overlay for better text readability
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.5f); // Black with 50% alpha for subtle overlay
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0);
-    glVertex2f(windowWidth, 0);
-    glVertex2f(windowWidth, windowHeight);
-    glVertex2f(0, windowHeight);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
-    glEnable(GL_TEXTURE_2D);
-    
-    // Draw settings title
-    float titleY = windowHeight * 0.85f;
-    textRenderer->renderText("Settings", windowWidth / 2.0f - 80, titleY, 1.5f, 1.0f, 1.0f, 1.0f);
-    
-    // Draw settings options
-    float buttonWidth = 300.0f;
-    float buttonHeight = 50.0f;
-    float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f;
-    
-    // Master Volume button
-    float masterVolumeY = windowHeight * 0.6f;
-    std::string masterText = "Master Volume: " + std::to_string((int)(masterVolume * 100)) + "%";
-    drawMenuButton(masterText, buttonX, masterVolumeY, buttonWidth, buttonHeight, false, selectedOption == 0);
-    
-    // Volume bar for Master (drawn separately)
-    float barWidth = 250.0f;
-    float barHeight = 25.0f;
-    float barX = windowWidth / 2.0f - barWidth / 2.0f;
-    float masterBarY = masterVolumeY - 50.0f;
-    
-    // Background bar
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glBegin(GL_QUADS);
-    glVertex2f(barX, masterBarY);
-    glVertex2f(barX + barWidth, masterBarY);
-    glVertex2f(barX + barWidth, masterBarY + barHeight);
-    glVertex2f(barX, masterBarY + barHeight);
-    glEnd();
-    
-    // Volume bar
-    glColor3f(selectedOption == 0 ? 1.0f : 0.7f, selectedOption == 0 ? 1.0f : 0.7f, selectedOption == 0 ? 1.0f : 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(barX, masterBarY);
-    glVertex2f(barX + barWidth * masterVolume, masterBarY);
-    glVertex2f(barX + barWidth * masterVolume, masterBarY + barHeight);
-    glVertex2f(barX, masterBarY + barHeight);
-    glEnd();
-    
-    // Back button
-    float backButtonY = windowHeight * 0.3f;
-    drawMenuButton("Back", buttonX, backButtonY, buttonWidth, buttonHeight, false, selectedOption == 1);
-    
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+void UI::drawSettingsMenu(int windowWidth, int windowHeight, int selectedOption, float masterVolume, float, float) {
+    RetainedScreen& screen = settingsScreen;
+    GLuint background = getReadyTextureID(titleScreenTexture);
+    int variant = background != 0 ? 1 : 0;
+    if (screen.needsLayout(windowWidth, windowHeight, variant)) {
+        UIGroup& root = screen.beginLayout(windowWidth, windowHeight, variant);
+        addBackground(root, background, 0.0f, windowWidth, windowHeight);
+        // Semi-transparent dark overlay for better text readability
+        addOverlay(root, {0.0f, 0.0f, 0.0f, 0.5f}, windowWidth, windowHeight);
+
+        root.addChild(std::make_unique<UILabel>(textRenderer, "Settings", windowWidth / 2.0f - 80, windowHeight * 0.85f, 1.5f));
+
+        float buttonWidth = 300.0f;
+        float buttonHeight = 50.0f;
+        float buttonX = windowWidth / 2.0f - buttonWidth / 2.0f;
+        float masterVolumeY = windowHeight * 0.6f;
+        screen.addButton(textRenderer, "", buttonX, masterVolumeY, buttonWidth, buttonHeight);
+
+        // Volume bar for Master, below its button
+        float barWidth = 250.0f;
+        float barHeight = 25.0f;
+        float barX = windowWidth / 2.0f - barWidth / 2.0f;
+        screen.bar = root.addChild(std::make_unique<UIBar>(barX, masterVolumeY - 50.0f, barWidth, barHeight,
+                                                           UIColor{0.3f, 0.3f, 0.3f, 1.0f}, UIColor()));
+
+        screen.addButton(textRenderer, "Back", buttonX, windowHeight * 0.3f, buttonWidth, buttonHeight);
+    }
+
+    screen.buttons[0]->setText("Master Volume: " + std::to_string((int)(masterVolume * 100)) + "%");
+    screen.bar->setValue(masterVolume);
+    float fill = selectedOption == 0 ? 1.0f : 0.7f;
+    screen.bar->setFillColor({fill, fill, fill, 1.0f});
+    screen.selectButton(selectedOption);
+    screen.canvas.draw(windowWidth, windowHeight);
 } 
\ No newline at end of file
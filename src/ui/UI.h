@@ -1,10 +1,12 @@
 #pragma once
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <string>
 #include "ui/TextRenderer.h"
 #include "ui/AnimatedHealthBar.h"
 #include "ui/AnimatedXPBar.h"
 #include "ui/RomanNumeralRenderer.h"
+#include "render/TextureCache.h"
 
 class UI {
 public:
@@ -68,9 +70,12 @@ public:
 private:
     static TextRenderer* textRenderer;
     static bool initialized;
-    static GLuint titleScreenTextureID;
-    static GLuint deathScreenTextureID;
+    static TextureHandle titleScreenTexture;
+    static TextureHandle deathScreenTexture;
     static AnimatedHealthBar* animatedHealthBar;
     static AnimatedXPBar* animatedXPBar;
     static RomanNumeralRenderer* romanNumeralRenderer;
+
+    // 0 until a streamed texture is uploaded
+    static GLuint getReadyTextureID(const TextureHandle& texture);
 }; 
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "ui/UICanvas.h"
+#include "render/GLState.h"
+#include "render/RenderBackend.h"
+#include <algorithm>
+
+UICanvas::UICanvas()
+    : vertexBuffer(0), vertexBufferCapacity(0), uploadPending(true),
+      layoutWidth(0), layoutHeight(0), uploadCount(0) {
+}
+
+UICanvas::~UICanvas() {
+    release();
+}
+
+void UICanvas::clear() {
+    root.clearChildren();
+    vertices.clear();
+    runs.clear();
+    uploadPending = true;
+    layoutWidth = 0;
+    layoutHeight = 0;
+}
+
+void UICanvas::release() {
+    if (vertexBuffer != 0) {
+        GLState::deleteBuffers(1, &vertexBuffer);
+        vertexBuffer = 0;
+    }
+    vertexBufferCapacity = 0;
+    uploadPending = true;
+}
+
+bool UICanvas::isLaidOutFor(int windowWidth, int windowHeight) const {
+    return layoutWidth == windowWidth && layoutHeight == windowHeight;
+}
+
+void UICanvas::setLayoutSize(int windowWidth, int windowHeight) {
+    layoutWidth = windowWidth;
+    layoutHeight = windowHeight;
+}
+
+void UICanvas::gather() {
+    geometries.clear();
+    root.collect(geometries);
+
+    // Neighbouring nodes that sample the same texture share a run
+    vertices.clear();
+    runs.clear();
+    for (const UIGeometry* geometry : geometries) {
+        vertices.insert(vertices.end(), geometry->vertices.begin(), geometry->vertices.end());
+        for (const UIGeometry::Run& run : geometry->runs) {
+            if (!runs.empty() && runs.back().texture == run.texture) {
+                runs.back().count += run.count;
+            } else {
+                runs.push_back(run);
+            }
+        }
+    }
+}
+
+void UICanvas::upload() {
+    if (vertexBuffer == 0) {
+        glGenBuffers(1, &vertexBuffer);
+    }
+    GLState::bindArrayBuffer(vertexBuffer);
+
+    // Menus are rebuilt on input, not every frame, so the buffer is static
+    // between changes and only regrown when a screen needs more vertices
+    if (vertices.size() > vertexBufferCapacity) {
+        vertexBufferCapacity = std::max(vertices.size(), vertexBufferCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, vertexBufferCapacity * sizeof(SpriteVertex), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(SpriteVertex), vertices.data());
+    ++uploadCount;
+}
+
+void UICanvas::draw(int windowWidth, int windowHeight) {
+    if (root.update() || uploadPending || vertexBuffer == 0) {
+        gather();
+        if (!vertices.empty()) {
+            upload();
+        }
+        uploadPending = false;
+    }
+    if (vertices.empty()) return;
+
+    RenderBackend::pushOrtho(0, windowWidth, 0, windowHeight);
+
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLint first = 0;
+    for (const UIGeometry::Run& run : runs) {
+        RenderBackend::current().drawSprites(vertexBuffer, first, run.count, run.texture);
+        first += run.count;
+    }
+
+    RenderBackend::popOrtho();
+}
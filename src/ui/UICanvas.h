@@ -0,0 +1,49 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include "ui/UINode.h"
+
+// Root of a retained UI tree. Each frame it asks the tree to rebuild what
+// changed; only then are the nodes' triangles gathered and uploaded again.
+// An unchanged screen is drawn straight from the vertex buffer with one
+// draw call per texture run.
+class UICanvas {
+public:
+    UICanvas();
+    ~UICanvas();
+
+    UICanvas(const UICanvas&) = delete;
+    UICanvas& operator=(const UICanvas&) = delete;
+
+    UIGroup& getRoot() { return root; }
+
+    // Drop every node, e.g. before laying the screen out for a new size
+    void clear();
+    // Release the vertex buffer while the GL context is alive
+    void release();
+
+    // Draw with a window-pixel projection, y pointing up
+    void draw(int windowWidth, int windowHeight);
+
+    // Size the tree was laid out for, so screens can tell when to rebuild it
+    bool isLaidOutFor(int windowWidth, int windowHeight) const;
+    void setLayoutSize(int windowWidth, int windowHeight);
+
+    // Number of times the vertex buffer was refilled, for profiling
+    int getUploadCount() const { return uploadCount; }
+
+private:
+    UIGroup root;
+    std::vector<SpriteVertex> vertices;
+    std::vector<UIGeometry::Run> runs;
+    std::vector<const UIGeometry*> geometries;
+    GLuint vertexBuffer;
+    size_t vertexBufferCapacity;  // In vertices
+    bool uploadPending;
+    int layoutWidth, layoutHeight;
+    int uploadCount;
+
+    void gather();
+    void upload();
+};
@@ -0,0 +1,226 @@
+#include "ui/UINode.h"
+#include "ui/TextRenderer.h"
+#include "ui/RomanNumeralRenderer.h"
+#include "render/TextureAtlas.h"
+#include <algorithm>
+
+namespace {
+    unsigned char toByte(float value) {
+        return static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // Menu button palette, RGB(205, 133, 63)
+    const UIColor BUTTON_ACCENT = {205.0f / 255.0f, 133.0f / 255.0f, 63.0f / 255.0f, 1.0f};
+    const UIColor BUTTON_OUTER_GLOW = {BUTTON_ACCENT.r, BUTTON_ACCENT.g, BUTTON_ACCENT.b, 0.3f};
+    const UIColor BUTTON_INNER_GLOW = {BUTTON_ACCENT.r, BUTTON_ACCENT.g, BUTTON_ACCENT.b, 0.6f};
+    const UIColor BUTTON_BORDER = {BUTTON_ACCENT.r, BUTTON_ACCENT.g, BUTTON_ACCENT.b, 0.8f};
+    const UIColor BUTTON_BACKGROUND = {0.0f, 0.0f, 0.0f, 0.7f};
+    constexpr float BUTTON_TEXT_SCALE = 0.8f;
+}
+
+void UIGeometry::clear() {
+    vertices.clear();
+    runs.clear();
+}
+
+void UIGeometry::appendToRun(GLuint texture, size_t firstVertex) {
+    GLsizei added = static_cast<GLsizei>(vertices.size() - firstVertex);
+    if (added == 0) return;
+    if (!runs.empty() && runs.back().texture == texture) {
+        runs.back().count += added;
+    } else {
+        runs.push_back({texture, added});
+    }
+}
+
+void UIGeometry::addQuad(float left, float bottom, float right, float top, const UIColor& color,
+                         GLuint texture, float u1, float v1, float u2, float v2) {
+    unsigned char r = toByte(color.r);
+    unsigned char g = toByte(color.g);
+    unsigned char b = toByte(color.b);
+    unsigned char a = toByte(color.a);
+
+    size_t first = vertices.size();
+    SpriteVertex bottomLeft = {left, bottom, u1, v1, r, g, b, a};
+    SpriteVertex bottomRight = {right, bottom, u2, v1, r, g, b, a};
+    SpriteVertex topRight = {right, top, u2, v2, r, g, b, a};
+    SpriteVertex topLeft = {left, top, u1, v2, r, g, b, a};
+    vertices.push_back(bottomLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(topLeft);
+    appendToRun(texture, first);
+}
+
+void UIGeometry::addOutline(float left, float bottom, float right, float top, const UIColor& color, float width) {
+    float half = width / 2.0f;
+    addQuad(left - half, bottom - half, right + half, bottom + half, color);  // Bottom
+    addQuad(left - half, top - half, right + half, top + half, color);        // Top
+    addQuad(left - half, bottom + half, left + half, top - half, color);      // Left
+    addQuad(right - half, bottom + half, right + half, top - half, color);    // Right
+}
+
+void UIGeometry::addText(const TextRenderer& textRenderer, const std::string& text, float x, float y, float scale,
+                         const UIColor& color) {
+    size_t first = vertices.size();
+    textRenderer.appendText(text, x, y, scale, color.r, color.g, color.b, color.a, vertices);
+    appendToRun(textRenderer.getAtlasTexture(), first);
+}
+
+UINode::UINode() : dirty(true), visible(true), visibilityChanged(false) {
+}
+
+void UINode::setVisible(bool visible) {
+    if (this->visible == visible) return;
+    this->visible = visible;
+    visibilityChanged = true;
+}
+
+bool UINode::update() {
+    bool changed = visibilityChanged;
+    visibilityChanged = false;
+    if (!visible) return changed;
+
+    if (dirty) {
+        geometry.clear();
+        build(geometry);
+        dirty = false;
+        changed = true;
+    }
+    for (const std::unique_ptr<UINode>& child : children) {
+        changed |= child->update();
+    }
+    return changed;
+}
+
+void UINode::collect(std::vector<const UIGeometry*>& out) const {
+    if (!visible) return;
+    if (!geometry.vertices.empty()) {
+        out.push_back(&geometry);
+    }
+    for (const std::unique_ptr<UINode>& child : children) {
+        child->collect(out);
+    }
+}
+
+UIPanel::UIPanel(float left, float bottom, float right, float top, const UIColor& color)
+    : left(left), bottom(bottom), right(right), top(top), color(color) {
+}
+
+void UIPanel::setColor(const UIColor& color) {
+    if (this->color == color) return;
+    this->color = color;
+    markDirty();
+}
+
+void UIPanel::build(UIGeometry& geometry) {
+    geometry.addQuad(left, bottom, right, top, color);
+}
+
+UIImage::UIImage(float left, float bottom, float right, float top, GLuint texture,
+                 float u1, float v1, float u2, float v2)
+    : left(left), bottom(bottom), right(right), top(top), texture(texture), u1(u1), v1(v1), u2(u2), v2(v2) {
+}
+
+void UIImage::build(UIGeometry& geometry) {
+    geometry.addQuad(left, bottom, right, top, UIColor(), texture, u1, v1, u2, v2);
+}
+
+UILabel::UILabel(TextRenderer* textRenderer, const std::string& text, float x, float y, float scale,
+                 const UIColor& color, Align align)
+    : textRenderer(textRenderer), text(text), x(x), y(y), scale(scale), color(color), align(align) {
+}
+
+void UILabel::setText(const std::string& text) {
+    if (this->text == text) return;
+    this->text = text;
+    markDirty();
+}
+
+void UILabel::build(UIGeometry& geometry) {
+    if (!textRenderer) return;
+    float left = x;
+    if (align == Align::Center) {
+        left -= textRenderer->getTextWidth(text, scale) / 2.0f;
+    }
+    geometry.addText(*textRenderer, text, left, y, scale, color);
+}
+
+UIButton::UIButton(TextRenderer* textRenderer, const std::string& text, float x, float y, float width, float height)
+    : textRenderer(textRenderer), text(text), x(x), y(y), width(width), height(height), selected(false) {
+}
+
+void UIButton::setText(const std::string& text) {
+    if (this->text == text) return;
+    this->text = text;
+    markDirty();
+}
+
+void UIButton::setSelected(bool selected) {
+    if (this->selected == selected) return;
+    this->selected = selected;
+    markDirty();
+}
+
+void UIButton::build(UIGeometry& geometry) {
+    if (selected) {
+        geometry.addQuad(x - 8, y - 8, x + width + 8, y + height + 8, BUTTON_OUTER_GLOW);
+        geometry.addQuad(x - 4, y - 4, x + width + 4, y + height + 4, BUTTON_INNER_GLOW);
+    }
+    geometry.addQuad(x, y, x + width, y + height, BUTTON_BACKGROUND);
+    geometry.addOutline(x, y, x + width, y + height, BUTTON_BORDER);
+
+    if (textRenderer) {
+        float textX = x + width / 2.0f - textRenderer->getTextWidth(text, BUTTON_TEXT_SCALE) / 2.0f;
+        float textY = y + height / 2.0f - 10.0f;
+        geometry.addText(*textRenderer, text, textX, textY, BUTTON_TEXT_SCALE, BUTTON_ACCENT);
+    }
+}
+
+UIBar::UIBar(float x, float y, float width, float height, const UIColor& background, const UIColor& fill)
+    : x(x), y(y), width(width), height(height), background(background), fill(fill), value(0.0f) {
+}
+
+void UIBar::setValue(float value) {
+    value = std::clamp(value, 0.0f, 1.0f);
+    if (this->value == value) return;
+    this->value = value;
+    markDirty();
+}
+
+void UIBar::setFillColor(const UIColor& color) {
+    if (fill == color) return;
+    fill = color;
+    markDirty();
+}
+
+void UIBar::build(UIGeometry& geometry) {
+    geometry.addQuad(x, y, x + width, y + height, background);
+    if (value > 0.0f) {
+        geometry.addQuad(x, y, x + width * value, y + height, fill);
+    }
+}
+
+UIRomanNumeral::UIRomanNumeral(const RomanNumeralRenderer* renderer, float x, float y, float scale)
+    : renderer(renderer), x(x), y(y), scale(scale), number(0) {
+}
+
+void UIRomanNumeral::setNumber(int number) {
+    if (this->number == number) return;
+    this->number = number;
+    markDirty();
+}
+
+void UIRomanNumeral::build(UIGeometry& geometry) {
+    if (!renderer || number <= 0) return;
+
+    std::vector<NumeralQuad> quads;
+    renderer->layoutRomanNumeral(number, x, y, scale, quads);
+    for (const NumeralQuad& quad : quads) {
+        const AtlasRegion& region = TextureAtlas::shared().getRegion(quad.region);
+        geometry.addQuad(quad.x, quad.y, quad.x + quad.width, quad.y + quad.height, UIColor(),
+                         region.texture, region.u1, region.v1, region.u2, region.v2);
+    }
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "render/RenderBackend.h"
+
+class TextRenderer;
+class RomanNumeralRenderer;
+
+struct UIColor {
+    float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
+
+    bool operator==(const UIColor& other) const {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+    bool operator!=(const UIColor& other) const { return !(*this == other); }
+};
+
+// Triangles produced by one node, split into runs that sample the same
+// texture. Coordinates are window pixels with y pointing up, as set up by
+// UICanvas.
+struct UIGeometry {
+    struct Run {
+        GLuint texture;  // 0 draws untextured
+        GLsizei count;   // In vertices
+    };
+
+    std::vector<SpriteVertex> vertices;
+    std::vector<Run> runs;
+
+    void clear();
+
+    // (u1, v1) is sampled at the bottom-left corner and (u2, v2) at the top-right one
+    void addQuad(float left, float bottom, float right, float top, const UIColor& color,
+                 GLuint texture = 0, float u1 = 0.0f, float v1 = 0.0f, float u2 = 1.0f, float v2 = 1.0f);
+    // Border of a rectangle, width pixels thick and centered on its edges
+    void addOutline(float left, float bottom, float right, float top, const UIColor& color, float width = 1.0f);
+    // Text with its baseline starting at (x, y)
+    void addText(const TextRenderer& textRenderer, const std::string& text, float x, float y, float scale,
+                 const UIColor& color);
+
+private:
+    void appendToRun(GLuint texture, size_t firstVertex);
+};
+
+// A retained UI element. Nodes tessellate themselves into cached geometry
+// and only do so again after a setter changed something that affects how
+// they look; drawing an unchanged tree reuses the cached triangles.
+class UINode {
+public:
+    UINode();
+    virtual ~UINode() = default;
+
+    UINode(const UINode&) = delete;
+    UINode& operator=(const UINode&) = delete;
+
+    // Takes ownership; children are drawn after their parent, in insertion order
+    template <typename T>
+    T* addChild(std::unique_ptr<T> child) {
+        T* node = child.get();
+        children.push_back(std::move(child));
+        return node;
+    }
+    void clearChildren() { children.clear(); }
+
+    void setVisible(bool visible);
+    bool isVisible() const { return visible; }
+
+    // Re-tessellate this node and its children where dirty. Returns true if
+    // anything was rebuilt or the visible set changed since the last call.
+    bool update();
+
+    // Append the cached geometry of every visible node, in draw order
+    void collect(std::vector<const UIGeometry*>& out) const;
+
+protected:
+    void markDirty() { dirty = true; }
+    virtual void build(UIGeometry& geometry) = 0;
+
+private:
+    std::vector<std::unique_ptr<UINode>> children;
+    UIGeometry geometry;
+    bool dirty;
+    bool visible;
+    bool visibilityChanged;
+};
+
+// A group without geometry of its own
+class UIGroup : public UINode {
+protected:
+    void build(UIGeometry&) override {}
+};
+
+// A solid rectangle, such as a screen-darkening overlay
+class UIPanel : public UINode {
+public:
+    UIPanel(float left, float bottom, float right, float top, const UIColor& color);
+
+    void setColor(const UIColor& color);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    float left, bottom, right, top;
+    UIColor color;
+};
+
+// A textured rectangle
+class UIImage : public UINode {
+public:
+    UIImage(float left, float bottom, float right, float top, GLuint texture,
+            float u1 = 0.0f, float v1 = 1.0f, float u2 = 1.0f, float v2 = 0.0f);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    float left, bottom, right, top;
+    GLuint texture;
+    float u1, v1, u2, v2;
+};
+
+class UILabel : public UINode {
+public:
+    enum class Align { Left, Center };
+
+    UILabel(TextRenderer* textRenderer, const std::string& text, float x, float y, float scale,
+            const UIColor& color = UIColor(), Align align = Align::Left);
+
+    void setText(const std::string& text);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    TextRenderer* textRenderer;
+    std::string text;
+    float x, y, scale;
+    UIColor color;
+    Align align;
+};
+
+// The bordered menu button, with a glow while selected
+class UIButton : public UINode {
+public:
+    UIButton(TextRenderer* textRenderer, const std::string& text, float x, float y, float width, float height);
+
+    void setText(const std::string& text);
+    void setSelected(bool selected);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    TextRenderer* textRenderer;
+    std::string text;
+    float x, y, width, height;
+    bool selected;
+};
+
+// A horizontal bar filled to value (0..1), such as a volume slider
+class UIBar : public UINode {
+public:
+    UIBar(float x, float y, float width, float height, const UIColor& background, const UIColor& fill);
+
+    void setValue(float value);
+    void setFillColor(const UIColor& color);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    float x, y, width, height;
+    UIColor background, fill;
+    float value;
+};
+
+// A number drawn with the pixel-art Roman numeral symbols
+class UIRomanNumeral : public UINode {
+public:
+    UIRomanNumeral(const RomanNumeralRenderer* renderer, float x, float y, float scale);
+
+    void setNumber(int number);
+
+protected:
+    void build(UIGeometry& geometry) override;
+
+private:
+    const RomanNumeralRenderer* renderer;
+    float x, y, scale;
+    int number;
+};